@@ -22,6 +22,7 @@ namespace ledger { namespace core { namespace api {
 
 class Amount;
 class BitcoinLikeBlock;
+class BoolCallback;
 class BitcoinLikeInput;
 class BitcoinLikeOutput;
 enum class BitcoinLikeSignatureState;
@@ -103,6 +104,13 @@ public:
      * @return SIGNING_SUCCEED if succeed case else refers to BitcoinLikeSignatureState enumeration
      */
     virtual BitcoinLikeSignatureState setDERSignatures(const std::vector<std::vector<uint8_t>> & signatures, bool override) = 0;
+
+    /**
+     * Fetch the previous transactions of all the inputs at once and keep them in the local raw transaction
+     * store, so that getPreviousTransaction is then served without any network call.
+     * @param callback, Callback returning false if the inputs have no raw transaction store
+     */
+    virtual void prefetchPreviousTransactions(const std::shared_ptr<BoolCallback> & callback) = 0;
 };
 
 } } }  // namespace ledger::core::api
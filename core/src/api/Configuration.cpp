@@ -29,6 +29,8 @@ std::string const Configuration::SYNCHRONIZATION_ENGINE = {"SYNCHRONIZATION_ENGI
 
 std::string const Configuration::SYNCHRONIZATION_HALF_BATCH_SIZE = {"SYNCHRONIZATION_HALF_BATCH_SIZE"};
 
+std::string const Configuration::SYNCHRONIZATION_MAX_PARALLEL_BATCHES = {"SYNCHRONIZATION_MAX_PARALLEL_BATCHES"};
+
 std::string const Configuration::TRUST_LIMIT = {"TRUST_LIMIT"};
 
 std::string const Configuration::TTL_CACHE = {"TTL_CACHE"};
@@ -37,4 +39,8 @@ std::string const Configuration::DEACTIVATE_SYNC_TOKEN = {"DEACTIVATE_SYNC_TOKEN
 
 std::string const Configuration::MEMPOOL_GRACE_PERIOD_SECS = {"MEMPOOL_GRACE_PERIOD_SECS"};
 
+std::string const Configuration::RAW_TRANSACTION_STORE_MAX_SIZE = {"RAW_TRANSACTION_STORE_MAX_SIZE"};
+
+std::string const Configuration::TRANSACTION_BUILDER_MAX_PARALLEL_LOOKUPS = {"TRANSACTION_BUILDER_MAX_PARALLEL_LOOKUPS"};
+
 } } }  // namespace ledger::core::api
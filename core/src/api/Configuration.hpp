@@ -56,6 +56,9 @@ public:
     /** Sets the half batch size (default: 20). */
     static std::string const SYNCHRONIZATION_HALF_BATCH_SIZE;
 
+    /** Sets the number of address batches synchronized concurrently (default: 1). */
+    static std::string const SYNCHRONIZATION_MAX_PARALLEL_BATCHES;
+
     /** Operation trust. */
     static std::string const TRUST_LIMIT;
 
@@ -70,6 +73,15 @@ public:
      * deletion from database
      */
     static std::string const MEMPOOL_GRACE_PERIOD_SECS;
+
+    /**
+     * Maximum size (in bytes) of the raw transactions kept in database to sign inputs without
+     * fetching their previous transaction again (default: 10MB, 0 disables the store).
+     */
+    static std::string const RAW_TRANSACTION_STORE_MAX_SIZE;
+
+    /** Sets the number of input transactions looked up concurrently when building a transaction (default: 8). */
+    static std::string const TRANSACTION_BUILDER_MAX_PARALLEL_LOOKUPS;
 };
 
 } } }  // namespace ledger::core::api
@@ -23,4 +23,10 @@ int32_t const ConfigurationDefaults::DEFAULT_PG_CONNECTION_POOL_SIZE = 25;
 
 int32_t const ConfigurationDefaults::DEFAULT_BTC_LIKE_MEMPOOL_GRACE = 900;
 
+int32_t const ConfigurationDefaults::DEFAULT_SYNCHRONIZATION_MAX_PARALLEL_BATCHES = 1;
+
+int32_t const ConfigurationDefaults::DEFAULT_RAW_TRANSACTION_STORE_MAX_SIZE = 10485760;
+
+int32_t const ConfigurationDefaults::DEFAULT_TRANSACTION_BUILDER_MAX_PARALLEL_LOOKUPS = 8;
+
 } } }  // namespace ledger::core::api
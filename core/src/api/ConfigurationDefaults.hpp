@@ -51,6 +51,15 @@ public:
      * if its age is less than that many seconds
      */
     static int32_t const DEFAULT_BTC_LIKE_MEMPOOL_GRACE;
+
+    /** Default number of address batches synchronized concurrently */
+    static int32_t const DEFAULT_SYNCHRONIZATION_MAX_PARALLEL_BATCHES;
+
+    /** Default size (in bytes) of the raw transactions kept locally for signing */
+    static int32_t const DEFAULT_RAW_TRANSACTION_STORE_MAX_SIZE;
+
+    /** Default number of input transactions looked up concurrently when building a transaction */
+    static int32_t const DEFAULT_TRANSACTION_BUILDER_MAX_PARALLEL_LOOKUPS;
 };
 
 } } }  // namespace ledger::core::api
@@ -6,6 +6,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #ifndef LIBCORE_EXPORT
     #if defined(_MSC_VER)
        #include <libcore_export.h>
@@ -53,6 +54,17 @@ public:
      */
     static std::shared_ptr<DatabaseBackend> getSqlite3Backend();
 
+    /**
+     * Create an instance of SQLite3 database with a tuned read pool and pragmas.
+     * @param readonlyConnectionPoolSize The number of connections used for read only queries
+     * @param enableWal Enable the write-ahead log journal mode so that readers don't wait for writers
+     * @param synchronous The synchronous pragma (OFF, NORMAL, FULL or EXTRA), SQLite default is kept if empty
+     * @param cacheSize The cache_size pragma, SQLite default is kept if 0
+     * @param mmapSize The mmap_size pragma in bytes, memory mapped I/O stays disabled if 0
+     * @return DatabaseBackend object
+     */
+    static std::shared_ptr<DatabaseBackend> getSqlite3BackendWithOptions(int32_t readonlyConnectionPoolSize, bool enableWal, const std::string & synchronous, int32_t cacheSize, int64_t mmapSize);
+
     /**
      * Create an instance of PostgreSQL database.
      * @return DatabaseBackend object
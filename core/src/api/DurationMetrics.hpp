@@ -17,6 +17,7 @@
 namespace ledger { namespace core { namespace api {
 
 struct DurationMetric;
+struct HistogramMetric;
 
 class LIBCORE_EXPORT DurationMetrics {
 public:
@@ -24,6 +25,12 @@ public:
 
     /** Get all duration metrics */
     static std::unordered_map<std::string, DurationMetric> getAllDurationMetrics();
+
+    /** Get a snapshot of the duration histograms */
+    static std::unordered_map<std::string, HistogramMetric> getHistogramMetrics();
+
+    /** Reset all duration metrics */
+    static void resetDurationMetrics();
 };
 
 } } }  // namespace ledger::core::api
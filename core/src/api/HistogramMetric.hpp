@@ -0,0 +1,73 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from core.djinni
+
+#ifndef DJINNI_GENERATED_HISTOGRAMMETRIC_HPP
+#define DJINNI_GENERATED_HISTOGRAMMETRIC_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <utility>
+
+namespace ledger { namespace core { namespace api {
+
+struct HistogramMetric final {
+    /** Number of records. */
+    int64_t count;
+    /** Total number of microseconds */
+    int64_t total_us;
+    /** 50th, 95th and 99th percentiles, in microseconds */
+    int64_t p50_us;
+    int64_t p95_us;
+    int64_t p99_us;
+    /** Longest record, in microseconds */
+    int64_t max_us;
+
+    HistogramMetric(int64_t count_,
+                    int64_t total_us_,
+                    int64_t p50_us_,
+                    int64_t p95_us_,
+                    int64_t p99_us_,
+                    int64_t max_us_)
+    : count(std::move(count_))
+    , total_us(std::move(total_us_))
+    , p50_us(std::move(p50_us_))
+    , p95_us(std::move(p95_us_))
+    , p99_us(std::move(p99_us_))
+    , max_us(std::move(max_us_))
+    {}
+
+    HistogramMetric(const HistogramMetric& cpy) {
+       this->count = cpy.count;
+       this->total_us = cpy.total_us;
+       this->p50_us = cpy.p50_us;
+       this->p95_us = cpy.p95_us;
+       this->p99_us = cpy.p99_us;
+       this->max_us = cpy.max_us;
+    }
+
+    HistogramMetric() = default;
+
+
+    HistogramMetric& operator=(const HistogramMetric& cpy) {
+       this->count = cpy.count;
+       this->total_us = cpy.total_us;
+       this->p50_us = cpy.p50_us;
+       this->p95_us = cpy.p95_us;
+       this->p99_us = cpy.p99_us;
+       this->max_us = cpy.max_us;
+       return *this;
+    }
+
+    template <class Archive>
+    void load(Archive& archive) {
+        archive(count, total_us, p50_us, p95_us, p99_us, max_us);
+    }
+
+    template <class Archive>
+    void save(Archive& archive) const {
+        archive(count, total_us, p50_us, p95_us, p99_us, max_us);
+    }
+};
+
+} } }  // namespace ledger::core::api
+#endif //DJINNI_GENERATED_HISTOGRAMMETRIC_HPP
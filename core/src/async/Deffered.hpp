@@ -35,11 +35,16 @@
 #include <functional>
 #include "../utils/Option.hpp"
 #include "../utils/Try.hpp"
+#include <atomic>
+#include <exception>
 #include <mutex>
 #include "../utils/Exception.hpp"
 #include <queue>
 #include "../api/ExecutionContext.hpp"
+#include "../api/Runnable.hpp"
 #include <tuple>
+#include <type_traits>
+#include "../utils/ImmediateExecutionContext.hpp"
 #include "../utils/LambdaRunnable.hpp"
 
 namespace ledger {
@@ -51,92 +56,175 @@ namespace ledger {
         template <typename T>
         class Promise;
 
+        /**
+         * Shared state of a Future/Promise pair.
+         *
+         * Callbacks are pushed on a lock-free stack until the value is published. Completing the deffered swaps the
+         * stack with a "completed" sentinel and dispatches the callbacks in registration order. Each callback lives in
+         * a single allocation, which also serves as the runnable posted to its execution context. Callbacks bound to
+         * the ImmediateExecutionContext are invoked inline. Every callback reads the stored value by reference instead
+         * of receiving its own copy.
+         */
         template <typename T>
-        class Deffered {
+        class Deffered : public std::enable_shared_from_this<Deffered<T>> {
 
         public:
             using Callback = std::function<void (const Try<T>&)>;
 
             friend class Future<T>;
             friend class Promise<T>;
-            Deffered() {
+            Deffered() : _completed(false), _callbacks(nullptr) {
 
             };
             Deffered(const Deffered&) = delete;
             Deffered(Deffered&&) = delete;
 
-            void setResult(const Try<T>& result) {
-                {
-                    std::lock_guard<std::recursive_mutex> lock(_lock);
-                    ensureNotCompleted();
-                    _value = result;
+            ~Deffered() {
+                auto node = _callbacks.load(std::memory_order_acquire);
+                while (node != nullptr && node != completedSentinel()) {
+                    auto next = node->next;
+                    delete node;
+                    node = next;
                 }
-                trigger();
+            }
+
+            void setResult(const Try<T>& result) {
+                complete(Try<T>(result));
+            }
+
+            void setResult(Try<T>&& result) {
+                complete(std::move(result));
             }
 
             void setValue(const T& value) {
-                std::lock_guard<std::recursive_mutex> lock(_lock);
-                ensureNotCompleted();
-                _value = Try<T>(value);
-                _trigger();
+                complete(Try<T>(value));
+            };
+
+            void setValue(T&& value) {
+                complete(Try<T>(std::move(value)));
             };
 
             void setError(const Exception& exception) {
-                std::lock_guard<std::recursive_mutex> lock(_lock);
-                ensureNotCompleted();
                 Try<T> ex;
                 ex.fail(exception);
-                _value = ex;
-                _trigger();
+                complete(std::move(ex));
             }
 
-            void addCallback(Callback callback, std::shared_ptr<api::ExecutionContext> context) {
-                // Add to the queue
-                std::lock_guard<std::recursive_mutex> lock(_lock);
-                _callbacks.push(std::make_tuple(callback, context));
-                _trigger();
+            template <typename F>
+            void addCallback(F&& callback, const std::shared_ptr<api::ExecutionContext>& context) {
+                auto node = new CallbackContinuation<typename std::decay<F>::type>(std::forward<F>(callback));
+                node->context = context;
+                auto head = _callbacks.load(std::memory_order_acquire);
+                do {
+                    if (head == completedSentinel()) {
+                        dispatch(node);
+                        return;
+                    }
+                    node->next = head;
+                } while (!_callbacks.compare_exchange_weak(head, node, std::memory_order_acq_rel, std::memory_order_acquire));
             }
 
             Option<Try<T>> getValue() const {
-                Option<Try<T>> cpy = _value;
-                return cpy;
+                if (isPublished()) {
+                    return Option<Try<T>>(_value);
+                }
+                return Option<Try<T>>();
             }
 
+            // The value is written after _completed is set, it is only readable once published
             bool hasValue() const {
-                std::lock_guard<std::recursive_mutex> lock(_lock);
-                return _value.hasValue();
-            }
-
-            void trigger() {
-                std::lock_guard<std::recursive_mutex> lock(_lock);
-                _trigger();
+                return isPublished();
             }
 
         private:
-            inline void ensureNotCompleted() {
-                if (_value.hasValue())
-                    throw Exception(api::ErrorCode::ALREADY_COMPLETED, "This promise is already completed");
+            class Continuation : public api::Runnable {
+            public:
+                virtual void invoke(const Try<T>& result) = 0;
+
+                void run() override {
+                    invoke(owner->_value);
+                }
+
+                Continuation* next {nullptr};
+                std::shared_ptr<api::ExecutionContext> context;
+                // Set when the continuation is posted to its context, keeps the value alive until it runs
+                std::shared_ptr<Deffered<T>> owner;
+            };
+
+            template <typename F>
+            class CallbackContinuation : public Continuation {
+            public:
+                template <typename G>
+                explicit CallbackContinuation(G&& callback) : _callback(std::forward<G>(callback)) {}
+
+                void invoke(const Try<T>& result) override {
+                    _callback(result);
+                }
+
+            private:
+                F _callback;
             };
 
-            inline void _trigger() {
-                if (_value.isEmpty() || _callbacks.empty()) {
-                    return ;
+            class CompletedSentinel : public Continuation {
+            public:
+                void invoke(const Try<T>& result) override {}
+            };
+
+            static Continuation* completedSentinel() {
+                static CompletedSentinel sentinel;
+                return &sentinel;
+            }
+
+            bool isPublished() const {
+                return _callbacks.load(std::memory_order_acquire) == completedSentinel();
+            }
+
+            void complete(Try<T>&& result) {
+                if (_completed.exchange(true, std::memory_order_acq_rel)) {
+                    throw Exception(api::ErrorCode::ALREADY_COMPLETED, "This promise is already completed");
+                }
+                _value = std::move(result);
+                auto node = _callbacks.exchange(completedSentinel(), std::memory_order_acq_rel);
+                // The stack holds the most recent callback first
+                Continuation* ordered = nullptr;
+                while (node != nullptr) {
+                    auto next = node->next;
+                    node->next = ordered;
+                    ordered = node;
+                    node = next;
                 }
-                while (!_callbacks.empty()) {
-                    std::tuple<Callback, std::shared_ptr<api::ExecutionContext>> callback = _callbacks.front();
-                    Callback cb = std::get<0>(callback);
-                    auto value = _value.getValue();
-                    std::get<1>(callback)->execute(make_runnable([cb, value] () {
-                        cb(value);
-                    }));
-                    _callbacks.pop();
+                std::exception_ptr error;
+                while (ordered != nullptr) {
+                    auto next = ordered->next;
+                    try {
+                        dispatch(ordered);
+                    } catch (...) {
+                        if (!error) {
+                            error = std::current_exception();
+                        }
+                    }
+                    ordered = next;
+                }
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+
+            void dispatch(Continuation* node) {
+                auto context = std::move(node->context);
+                if (!context || context == ImmediateExecutionContext::INSTANCE) {
+                    std::unique_ptr<Continuation> guard(node);
+                    node->invoke(_value);
+                    return;
                 }
+                node->owner = this->shared_from_this();
+                context->execute(std::shared_ptr<api::Runnable>(node));
             }
 
         private:
-            mutable std::recursive_mutex _lock;
-            Option<Try<T>> _value;
-            std::queue<std::tuple<Callback, std::shared_ptr<api::ExecutionContext>>> _callbacks;
+            std::atomic<bool> _completed;
+            std::atomic<Continuation*> _callbacks;
+            Try<T> _value;
         };
 
 
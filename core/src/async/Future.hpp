@@ -55,7 +55,7 @@ namespace ledger {
                 _defer = future._defer;
             }
 
-            Future(Future<T>&& future) : _defer(future._defer) {}
+            Future(Future<T>&& future) : _defer(std::move(future._defer)) {}
             Future<T>& operator=(const Future<T>& future) {
                 if (this != &future)
                     _defer = future._defer;
@@ -63,23 +63,23 @@ namespace ledger {
             }
             Future<T>& operator=(Future<T>&& future) {
                 if (this != &future)
-                    _defer = future._defer;
+                    _defer = std::move(future._defer);
                 return *this;
             }
 
             template <typename R>
             Future<R> map(const Context& context, std::function<R (const T&)> map) {
                 auto defer = Future<R>::make_deffered();
-                _defer->addCallback([defer, map] (const Try<T>& result) {
-                    Try<R> r;
+                _defer->addCallback([defer, map = std::move(map)] (const Try<T>& result) {
                     if (result.isSuccess()) {
-                        r = Try<R>::from([map, result] () -> R {
+                        defer->setResult(Try<R>::from([&] () -> R {
                             return map(result.getValue());
-                        });
+                        }));
                     } else {
+                        Try<R> r;
                         r.fail(result.getFailure());
+                        defer->setResult(std::move(r));
                     }
-                    defer->setResult(r);
                 }, context);
                 return Future<R>(defer);
             }
@@ -92,26 +92,24 @@ namespace ledger {
             template <typename R>
             Future<R> flatMap(const Context& context, std::function<Future<R> (const T&)> map) {
                 auto deffer = Future<R>::make_deffered();
-                _defer->addCallback([deffer, map, context] (const Try<T>& result) {
+                _defer->addCallback([deffer, map = std::move(map), context] (const Try<T>& result) {
                     if (result.isSuccess()) {
-                        Try<Future<R>> r;
-                        r = Try<Future<R>>::from([deffer, map, result] () -> Future<R> {
+                        auto r = Try<Future<R>>::from([&] () -> Future<R> {
                             return map(result.getValue());
                         });
                         if (r.isSuccess()) {
-                            Future<R> future = r.getValue();
-                            future.onComplete(context, [deffer] (const Try<R>& finalResult) {
+                            r.getValue()._defer->addCallback([deffer] (const Try<R>& finalResult) {
                                 deffer->setResult(finalResult);
-                            });
+                            }, context);
                         } else {
                             Try<R> re;
                             re.fail(r.getFailure());
-                            deffer->setResult(re);
+                            deffer->setResult(std::move(re));
                         }
                     } else {
                         Try<R> r;
                         r.fail(result.getFailure());
-                        deffer->setResult(r);
+                        deffer->setResult(std::move(r));
                     }
                 }, context);
                 return Future<R>(deffer);
@@ -124,9 +122,9 @@ namespace ledger {
 
             Future<T> recover(const Context& context, std::function<T (const Exception&)> f) {
                 auto deffer = Future<T>::make_deffered();
-                _defer->addCallback([deffer, f] (const Try<T>& result) {
+                _defer->addCallback([deffer, f = std::move(f)] (const Try<T>& result) {
                     if (result.isFailure()) {
-                        deffer->setResult(Try<T>::from([f, result] () {
+                        deffer->setResult(Try<T>::from([&] () -> T {
                             return f(result.getFailure());
                         }));
                     } else {
@@ -138,20 +136,19 @@ namespace ledger {
 
             Future<T> recoverWith(const Context& context, std::function<Future<T> (const Exception&)> f) {
                 auto deffer = Future<T>::make_deffered();
-                _defer->addCallback([deffer, f, context] (const Try<T>& result) {
+                _defer->addCallback([deffer, f = std::move(f), context] (const Try<T>& result) {
                     if (result.isFailure()) {
-                        auto future = Try<Future<T>>::from([f, result] () {
+                        auto future = Try<Future<T>>::from([&] () -> Future<T> {
                             return f(result.getFailure());
                         });
                         if (future.isFailure()) {
                             Try<T> r;
                             r.fail(future.getFailure());
-                            deffer->setResult(r);
+                            deffer->setResult(std::move(r));
                         } else {
-                            Future<T> fut = future.getValue();
-                            fut.onComplete(context, [deffer] (const Try<T>& finalResult) {
+                            future.getValue()._defer->addCallback([deffer] (const Try<T>& finalResult) {
                                 deffer->setResult(finalResult);
-                            });
+                            }, context);
                         }
                     } else {
                         deffer->setResult(result);
@@ -183,7 +180,7 @@ namespace ledger {
             }
 
             void foreach(const Context& context, std::function<void (T&)> f) {
-                _defer->addCallback([f] (const Try<T>& result) {
+                _defer->addCallback([f = std::move(f)] (const Try<T>& result) {
                     if (result.isSuccess()) {
                         T value = result.getValue();
                         f(value);
@@ -196,7 +193,7 @@ namespace ledger {
             }
 
             bool isCompleted() const {
-                return getValue().hasValue();
+                return _defer->isPublished();
             }
 
             Future<Exception> failed() {
@@ -214,7 +211,7 @@ namespace ledger {
             };
 
             void onComplete(const Context& context, std::function<void (const Try<T>&)> f) {
-                _defer->addCallback(f, context);
+                _defer->addCallback(std::move(f), context);
             };
 
             template<typename Callback>
@@ -254,9 +251,9 @@ namespace ledger {
 
 
             static Future<T> successful(T value) {
-                Promise<T> p;
-                p.success(value);
-                return p.getFuture();
+                auto deffer = make_deffered();
+                deffer->setResult(Try<T>(std::move(value)));
+                return Future<T>(deffer);
             }
 
             static Future<T> failure(Exception&& exception) {
@@ -276,11 +273,10 @@ namespace ledger {
                     throw make_exception(api::ErrorCode::ILLEGAL_STATE, "Context has been released before async operation");
                 }
                 auto deffer = make_deffered();
-                context->execute(make_runnable([deffer, f] () {
-                    auto result = Try<T>::from([&] () -> T {
+                context->execute(make_runnable([deffer, f = std::move(f)] () {
+                    deffer->setResult(Try<T>::from([&] () -> T {
                         return f();
-                    });
-                    deffer->setResult(result);
+                    }));
                 }));
                 return Future<T>(deffer);
             }
@@ -290,28 +286,29 @@ namespace ledger {
                     throw make_exception(api::ErrorCode::ILLEGAL_STATE, "Context has been released before async operation");
                 }
                 auto deffer = make_deffered();
-                context->execute(make_runnable([context, deffer, f] () {
+                context->execute(make_runnable([context, deffer, f = std::move(f)] () {
                     auto result = Try<Future<T>>::from([&] () -> Future<T> {
                        return f();
                     });
                     if (result.isFailure()) {
                         deffer->setError(result.getFailure());
                     } else {
-                        Future<T> futureRes = result.getValue();
-                        futureRes.onComplete(context, [deffer] (const Try<T>& r) {
+                        result.getValue()._defer->addCallback([deffer] (const Try<T>& r) {
                             deffer->setResult(r);
-                        });
+                        }, context);
                     }
                 }));
                 return Future<T>(deffer);
             }
 
             static std::shared_ptr<Deffered<T>> make_deffered() {
-                auto d = new Deffered<T>();
-                return std::shared_ptr<Deffered<T>>(d);
+                return std::make_shared<Deffered<T>>();
             };
 
         private:
+            template <typename U>
+            friend class Future;
+
             std::shared_ptr<Deffered<T>> _defer;
         };
         template <typename T>
@@ -57,6 +57,10 @@ namespace ledger {
                 _deffer->setResult(result);
             };
 
+            void complete(Try<T>&& result) {
+                _deffer->setResult(std::move(result));
+            };
+
             bool tryComplete(const Try<T>& result) {
                return Try<Unit>::from([result, this] () {
                    complete(result);
@@ -101,6 +105,10 @@ namespace ledger {
                 _deffer->setValue(value);
             };
 
+            void success(T&& value) {
+                _deffer->setValue(std::move(value));
+            };
+
             void failure(const Exception& exception) {
                 _deffer->setError(exception);
             };
@@ -0,0 +1,492 @@
+/*
+ *
+ * ThreadPoolDispatcher
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "ThreadPoolDispatcher.hpp"
+#include "../utils/LambdaRunnable.hpp"
+
+namespace ledger {
+    namespace core {
+
+        namespace {
+            void runSafely(const std::shared_ptr<api::Runnable>& task) {
+                // A throwing task must not take its worker down with it
+                try {
+                    task->run();
+                } catch (...) {
+                }
+            }
+
+            class MutexLock : public api::Lock {
+            public:
+                void lock() override {
+                    _mutex.lock();
+                }
+
+                bool tryLock() override {
+                    return _mutex.try_lock();
+                }
+
+                void unlock() override {
+                    _mutex.unlock();
+                }
+
+            private:
+                std::recursive_mutex _mutex;
+            };
+        }
+
+        WorkStealingThreadPool::WorkStealingThreadPool() :
+            _started(false), _pending(0), _idle(0), _stopped(false), _executed(0), _steals(0) {
+
+        }
+
+        std::shared_ptr<WorkStealingThreadPool> WorkStealingThreadPool::create(size_t workers) {
+            std::shared_ptr<WorkStealingThreadPool> pool(new WorkStealingThreadPool());
+            pool->start(std::max<size_t>(1, workers));
+            return pool;
+        }
+
+        void WorkStealingThreadPool::start(size_t workers) {
+            std::unique_lock<std::mutex> lock(_sleepLock);
+            for (size_t index = 0; index < workers; index++) {
+                _workers.emplace_back(new Worker());
+            }
+            // Workers keep the pool alive until they exit
+            auto self = shared_from_this();
+            for (size_t index = 0; index < workers; index++) {
+                _workers[index]->thread = std::thread([self, index] () {
+                    self->run(index);
+                });
+                _workerIndexes[_workers[index]->thread.get_id()] = index;
+            }
+            _started = true;
+            _wakeUp.notify_all();
+        }
+
+        size_t WorkStealingThreadPool::currentWorker() const {
+            auto it = _workerIndexes.find(std::this_thread::get_id());
+            return it == _workerIndexes.end() ? _workers.size() : it->second;
+        }
+
+        void WorkStealingThreadPool::submit(const std::shared_ptr<api::Runnable>& task) {
+            push(task, currentWorker());
+        }
+
+        void WorkStealingThreadPool::yield(const std::shared_ptr<api::Runnable>& task) {
+            push(task, _workers.size());
+        }
+
+        void WorkStealingThreadPool::push(const std::shared_ptr<api::Runnable>& task, size_t index) {
+            if (_stopped) {
+                return;
+            }
+            if (index < _workers.size()) {
+                std::lock_guard<std::mutex> lock(_workers[index]->lock);
+                _workers[index]->tasks.push_back(task);
+            } else {
+                std::lock_guard<std::mutex> lock(_injectedLock);
+                _injected.push_back(task);
+            }
+            _pending += 1;
+            if (_idle > 0) {
+                // Taking the lock orders this notification after the check of a worker about to sleep
+                { std::lock_guard<std::mutex> lock(_sleepLock); }
+                _wakeUp.notify_one();
+            }
+        }
+
+        bool WorkStealingThreadPool::popLocal(size_t index, std::shared_ptr<api::Runnable>& task) {
+            auto& worker = *_workers[index];
+            std::lock_guard<std::mutex> lock(worker.lock);
+            if (worker.tasks.empty()) {
+                return false;
+            }
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            return true;
+        }
+
+        bool WorkStealingThreadPool::popInjected(std::shared_ptr<api::Runnable>& task) {
+            std::lock_guard<std::mutex> lock(_injectedLock);
+            if (_injected.empty()) {
+                return false;
+            }
+            task = std::move(_injected.front());
+            _injected.pop_front();
+            return true;
+        }
+
+        bool WorkStealingThreadPool::steal(size_t index, std::shared_ptr<api::Runnable>& task) {
+            for (size_t offset = 1; offset < _workers.size(); offset++) {
+                auto& victim = *_workers[(index + offset) % _workers.size()];
+                std::unique_lock<std::mutex> lock(victim.lock, std::try_to_lock);
+                if (!lock.owns_lock() || victim.tasks.empty()) {
+                    continue;
+                }
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                _steals += 1;
+                return true;
+            }
+            return false;
+        }
+
+        void WorkStealingThreadPool::run(size_t index) {
+            {
+                std::unique_lock<std::mutex> lock(_sleepLock);
+                _wakeUp.wait(lock, [this] () { return _started; });
+            }
+            std::shared_ptr<api::Runnable> task;
+            while (!_stopped) {
+                if (popLocal(index, task) || popInjected(task) || steal(index, task)) {
+                    _pending -= 1;
+                    runSafely(task);
+                    task.reset();
+                    _executed += 1;
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(_sleepLock);
+                _idle += 1;
+                // A steal may have missed a task behind a busy lock, only sleep when nothing is queued at all
+                _wakeUp.wait(lock, [this] () { return _stopped || _pending > 0; });
+                _idle -= 1;
+            }
+        }
+
+        void WorkStealingThreadPool::stop() {
+            {
+                std::lock_guard<std::mutex> lock(_sleepLock);
+                if (_stopped.exchange(true)) {
+                    return;
+                }
+            }
+            _wakeUp.notify_all();
+            auto current = currentWorker();
+            for (size_t index = 0; index < _workers.size(); index++) {
+                auto& thread = _workers[index]->thread;
+                if (index == current) {
+                    thread.detach();
+                } else {
+                    thread.join();
+                }
+            }
+            for (auto& worker : _workers) {
+                std::lock_guard<std::mutex> lock(worker->lock);
+                worker->tasks.clear();
+            }
+            std::lock_guard<std::mutex> lock(_injectedLock);
+            _injected.clear();
+        }
+
+        size_t WorkStealingThreadPool::getWorkerCount() const {
+            return _workers.size();
+        }
+
+        size_t WorkStealingThreadPool::getQueueDepth() const {
+            return _pending;
+        }
+
+        uint64_t WorkStealingThreadPool::getExecutedCount() const {
+            return _executed;
+        }
+
+        uint64_t WorkStealingThreadPool::getStealCount() const {
+            return _steals;
+        }
+
+        TimerWheel::TimerWheel(std::chrono::milliseconds tick, size_t slots) :
+            _tick(std::max(tick, std::chrono::milliseconds(1))),
+            _origin(std::chrono::steady_clock::now()),
+            _slots(std::max<size_t>(1, slots)),
+            _currentTick(0),
+            _pending(0),
+            _stopped(false) {
+
+        }
+
+        std::shared_ptr<TimerWheel> TimerWheel::create(std::chrono::milliseconds tick, size_t slots) {
+            std::shared_ptr<TimerWheel> wheel(new TimerWheel(tick, slots));
+            auto self = wheel;
+            wheel->_thread = std::thread([self] () {
+                self->run();
+            });
+            return wheel;
+        }
+
+        uint64_t TimerWheel::elapsedTicks() const {
+            return static_cast<uint64_t>((std::chrono::steady_clock::now() - _origin) / _tick);
+        }
+
+        void TimerWheel::schedule(const std::shared_ptr<api::ExecutionContext> &context,
+                                  const std::shared_ptr<api::Runnable> &runnable, int64_t millis) {
+            if (millis <= 0) {
+                context->execute(runnable);
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                if (_stopped) {
+                    return;
+                }
+                if (_pending == 0) {
+                    // The wheel stopped turning while it was empty, catch up with the clock
+                    _currentTick = elapsedTicks();
+                }
+                // Round the due date up to the tick boundary following it
+                const auto due = std::chrono::steady_clock::now() - _origin + std::chrono::milliseconds(millis);
+                const std::chrono::steady_clock::duration tick = _tick;
+                const auto dueTick = static_cast<uint64_t>((due + tick - std::chrono::steady_clock::duration(1)) / tick);
+                const auto ticks = std::max<uint64_t>(1, dueTick - std::min(dueTick, _currentTick));
+                const auto slot = (_currentTick + ticks) % _slots.size();
+                _slots[slot].push_back(Timer {(ticks - 1) / _slots.size(), context, runnable});
+                _pending += 1;
+            }
+            _wakeUp.notify_one();
+        }
+
+        void TimerWheel::run() {
+            std::vector<Timer> expired;
+            std::unique_lock<std::mutex> lock(_lock);
+            while (!_stopped) {
+                if (_pending == 0) {
+                    _wakeUp.wait(lock, [this] () { return _stopped || _pending > 0; });
+                    continue;
+                }
+                auto nextTick = _origin + _tick * static_cast<int64_t>(_currentTick + 1);
+                if (_wakeUp.wait_until(lock, nextTick, [this] () { return _stopped; })) {
+                    break;
+                }
+                const auto now = elapsedTicks();
+                while (_currentTick < now) {
+                    _currentTick += 1;
+                    auto& slot = _slots[_currentTick % _slots.size()];
+                    auto it = slot.begin();
+                    while (it != slot.end()) {
+                        if (it->rounds == 0) {
+                            expired.push_back(std::move(*it));
+                            it = slot.erase(it);
+                        } else {
+                            it->rounds -= 1;
+                            ++it;
+                        }
+                    }
+                }
+                _pending -= expired.size();
+                if (expired.empty()) {
+                    continue;
+                }
+                lock.unlock();
+                for (auto& timer : expired) {
+                    timer.context->execute(timer.runnable);
+                }
+                expired.clear();
+                lock.lock();
+            }
+        }
+
+        void TimerWheel::stop() {
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                if (_stopped) {
+                    return;
+                }
+                _stopped = true;
+                for (auto& slot : _slots) {
+                    slot.clear();
+                }
+                _pending = 0;
+            }
+            _wakeUp.notify_all();
+            if (_thread.get_id() == std::this_thread::get_id()) {
+                _thread.detach();
+            } else {
+                _thread.join();
+            }
+        }
+
+        size_t TimerWheel::getPendingCount() const {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _pending;
+        }
+
+        /**
+         * Serial context running on the shared pool. Tasks are queued on the strand and a single drain task is
+         * submitted to the pool whenever the strand goes from idle to busy. A drain runs a bounded number of tasks
+         * before yielding the worker back to the pool.
+         */
+        class ThreadPoolDispatcher::StrandExecutionContext : public api::ExecutionContext,
+                                                             public std::enable_shared_from_this<StrandExecutionContext> {
+        public:
+            static const int MAX_TASKS_PER_DRAIN = 64;
+
+            StrandExecutionContext(const std::shared_ptr<WorkStealingThreadPool>& pool,
+                                   const std::shared_ptr<TimerWheel>& timers) :
+                _pool(pool), _timers(timers), _scheduled(false) {
+
+            }
+
+            void execute(const std::shared_ptr<api::Runnable> &runnable) override {
+                {
+                    std::lock_guard<std::mutex> lock(_lock);
+                    _tasks.push_back(runnable);
+                    if (_scheduled) {
+                        return;
+                    }
+                    _scheduled = true;
+                }
+                scheduleDrain();
+            }
+
+            void delay(const std::shared_ptr<api::Runnable> &runnable, int64_t millis) override {
+                _timers->schedule(shared_from_this(), runnable, millis);
+            }
+
+            size_t getQueueDepth() const {
+                std::lock_guard<std::mutex> lock(_lock);
+                return _tasks.size();
+            }
+
+        private:
+            void scheduleDrain() {
+                _pool->submit(newDrain());
+            }
+
+            std::shared_ptr<api::Runnable> newDrain() {
+                auto self = shared_from_this();
+                return make_runnable([self] () {
+                    self->drain();
+                });
+            }
+
+            void drain() {
+                std::shared_ptr<api::Runnable> task;
+                for (auto count = 0; count < MAX_TASKS_PER_DRAIN; count++) {
+                    {
+                        std::lock_guard<std::mutex> lock(_lock);
+                        if (_tasks.empty()) {
+                            _scheduled = false;
+                            return;
+                        }
+                        task = std::move(_tasks.front());
+                        _tasks.pop_front();
+                    }
+                    runSafely(task);
+                    task.reset();
+                }
+                // Still scheduled, let other strands and tasks run before continuing. Submitting to the worker deque
+                // would pop this drain right back since workers pop their own tasks LIFO.
+                _pool->yield(newDrain());
+            }
+
+            std::shared_ptr<WorkStealingThreadPool> _pool;
+            std::shared_ptr<TimerWheel> _timers;
+            mutable std::mutex _lock;
+            std::deque<std::shared_ptr<api::Runnable>> _tasks;
+            bool _scheduled;
+        };
+
+        namespace {
+            class PoolExecutionContext : public api::ExecutionContext, public std::enable_shared_from_this<PoolExecutionContext> {
+            public:
+                PoolExecutionContext(const std::shared_ptr<WorkStealingThreadPool>& pool,
+                                     const std::shared_ptr<TimerWheel>& timers) : _pool(pool), _timers(timers) {
+
+                }
+
+                void execute(const std::shared_ptr<api::Runnable> &runnable) override {
+                    _pool->submit(runnable);
+                }
+
+                void delay(const std::shared_ptr<api::Runnable> &runnable, int64_t millis) override {
+                    _timers->schedule(shared_from_this(), runnable, millis);
+                }
+
+            private:
+                std::shared_ptr<WorkStealingThreadPool> _pool;
+                std::shared_ptr<TimerWheel> _timers;
+            };
+        }
+
+        const std::chrono::milliseconds ThreadPoolDispatcher::DEFAULT_TIMER_TICK = std::chrono::milliseconds(10);
+        const size_t ThreadPoolDispatcher::DEFAULT_TIMER_SLOTS = 512;
+
+        ThreadPoolDispatcher::ThreadPoolDispatcher(size_t workers, std::chrono::milliseconds timerTick, size_t timerSlots) {
+            _pool = WorkStealingThreadPool::create(workers);
+            _timers = TimerWheel::create(timerTick, timerSlots);
+            _poolContext = std::make_shared<PoolExecutionContext>(_pool, _timers);
+            _mainContext = std::make_shared<StrandExecutionContext>(_pool, _timers);
+        }
+
+        ThreadPoolDispatcher::~ThreadPoolDispatcher() {
+            stop();
+        }
+
+        std::shared_ptr<api::ExecutionContext> ThreadPoolDispatcher::getSerialExecutionContext(const std::string &name) {
+            std::lock_guard<std::mutex> lock(_lock);
+            auto& context = _serialContexts[name];
+            if (!context) {
+                context = std::make_shared<StrandExecutionContext>(_pool, _timers);
+            }
+            return context;
+        }
+
+        std::shared_ptr<api::ExecutionContext> ThreadPoolDispatcher::getThreadPoolExecutionContext(const std::string &name) {
+            return _poolContext;
+        }
+
+        std::shared_ptr<api::ExecutionContext> ThreadPoolDispatcher::getMainExecutionContext() {
+            return _mainContext;
+        }
+
+        std::shared_ptr<api::Lock> ThreadPoolDispatcher::newLock() {
+            return std::make_shared<MutexLock>();
+        }
+
+        ThreadPoolDispatcher::Stats ThreadPoolDispatcher::getStats() const {
+            Stats stats;
+            stats.workers = _pool->getWorkerCount();
+            stats.queuedTasks = _pool->getQueueDepth();
+            stats.executedTasks = _pool->getExecutedCount();
+            stats.steals = _pool->getStealCount();
+            stats.pendingTimers = _timers->getPendingCount();
+            std::lock_guard<std::mutex> lock(_lock);
+            stats.serialContexts = _serialContexts.size();
+            stats.queuedSerialTasks = _mainContext->getQueueDepth();
+            for (const auto& context : _serialContexts) {
+                stats.queuedSerialTasks += context.second->getQueueDepth();
+            }
+            return stats;
+        }
+
+        void ThreadPoolDispatcher::stop() {
+            _timers->stop();
+            _pool->stop();
+        }
+    }
+}
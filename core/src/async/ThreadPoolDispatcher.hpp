@@ -0,0 +1,189 @@
+/*
+ *
+ * ThreadPoolDispatcher
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_THREADPOOLDISPATCHER_HPP
+#define LEDGER_CORE_THREADPOOLDISPATCHER_HPP
+
+#include "../api/ThreadDispatcher.hpp"
+#include "../api/ExecutionContext.hpp"
+#include "../api/Runnable.hpp"
+#include "../api/Lock.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * Fixed pool of workers, each owning a deque of tasks. A worker pops its own tasks LIFO and steals the oldest
+         * tasks of the other workers when it runs out of work. Tasks submitted from outside of the pool go through a
+         * shared injection queue.
+         */
+        class WorkStealingThreadPool : public std::enable_shared_from_this<WorkStealingThreadPool> {
+        public:
+            static std::shared_ptr<WorkStealingThreadPool> create(size_t workers);
+
+            void submit(const std::shared_ptr<api::Runnable>& task);
+            // Submits through the injection queue even from a worker, behind every task already waiting there
+            void yield(const std::shared_ptr<api::Runnable>& task);
+            // Pending tasks are dropped. Joins the workers unless called from one of them.
+            void stop();
+
+            size_t getWorkerCount() const;
+            size_t getQueueDepth() const;
+            uint64_t getExecutedCount() const;
+            uint64_t getStealCount() const;
+
+        private:
+            struct Worker {
+                std::mutex lock;
+                std::deque<std::shared_ptr<api::Runnable>> tasks;
+                std::thread thread;
+            };
+
+            WorkStealingThreadPool();
+            void start(size_t workers);
+            void run(size_t index);
+            // Queues on the deque of the given worker, or on the injection queue for an out of range index
+            void push(const std::shared_ptr<api::Runnable>& task, size_t index);
+            bool popLocal(size_t index, std::shared_ptr<api::Runnable>& task);
+            bool popInjected(std::shared_ptr<api::Runnable>& task);
+            bool steal(size_t index, std::shared_ptr<api::Runnable>& task);
+            // Index of the worker running on the calling thread, or the number of workers if there is none
+            size_t currentWorker() const;
+
+            std::vector<std::unique_ptr<Worker>> _workers;
+            // Filled before the workers are released, read-only afterwards
+            std::unordered_map<std::thread::id, size_t> _workerIndexes;
+            bool _started;
+            mutable std::mutex _injectedLock;
+            std::deque<std::shared_ptr<api::Runnable>> _injected;
+            std::mutex _sleepLock;
+            std::condition_variable _wakeUp;
+            std::atomic<size_t> _pending;
+            std::atomic<size_t> _idle;
+            std::atomic<bool> _stopped;
+            std::atomic<uint64_t> _executed;
+            std::atomic<uint64_t> _steals;
+        };
+
+        /**
+         * Hashed timer wheel backing ExecutionContext::delay. Timers are rounded up to the next tick and handed to their
+         * execution context when they expire. The wheel thread sleeps while no timer is pending.
+         */
+        class TimerWheel : public std::enable_shared_from_this<TimerWheel> {
+        public:
+            static std::shared_ptr<TimerWheel> create(std::chrono::milliseconds tick, size_t slots);
+
+            void schedule(const std::shared_ptr<api::ExecutionContext>& context,
+                          const std::shared_ptr<api::Runnable>& runnable,
+                          int64_t millis);
+            void stop();
+            size_t getPendingCount() const;
+
+        private:
+            struct Timer {
+                uint64_t rounds;
+                std::shared_ptr<api::ExecutionContext> context;
+                std::shared_ptr<api::Runnable> runnable;
+            };
+
+            TimerWheel(std::chrono::milliseconds tick, size_t slots);
+            void run();
+            uint64_t elapsedTicks() const;
+
+            const std::chrono::milliseconds _tick;
+            const std::chrono::steady_clock::time_point _origin;
+            std::vector<std::vector<Timer>> _slots;
+            uint64_t _currentTick;
+            size_t _pending;
+            bool _stopped;
+            mutable std::mutex _lock;
+            std::condition_variable _wakeUp;
+            std::thread _thread;
+        };
+
+        /**
+         * api::ThreadDispatcher for native hosts. Every context shares a single WorkStealingThreadPool: serial contexts
+         * are strands (tasks queued per context, drained by one worker at a time) and the thread pool context submits
+         * straight to the pool. Delayed tasks go through a TimerWheel.
+         */
+        class ThreadPoolDispatcher : public api::ThreadDispatcher {
+        public:
+            struct Stats {
+                size_t workers;
+                // Tasks waiting in the pool (including scheduled strand drains)
+                size_t queuedTasks;
+                // Tasks waiting in the serial contexts
+                size_t queuedSerialTasks;
+                uint64_t executedTasks;
+                uint64_t steals;
+                size_t pendingTimers;
+                size_t serialContexts;
+            };
+
+            static const std::chrono::milliseconds DEFAULT_TIMER_TICK;
+            static const size_t DEFAULT_TIMER_SLOTS;
+
+            explicit ThreadPoolDispatcher(size_t workers = std::max(1u, std::thread::hardware_concurrency()),
+                                          std::chrono::milliseconds timerTick = DEFAULT_TIMER_TICK,
+                                          size_t timerSlots = DEFAULT_TIMER_SLOTS);
+            ~ThreadPoolDispatcher();
+
+            std::shared_ptr<api::ExecutionContext> getSerialExecutionContext(const std::string &name) override;
+            std::shared_ptr<api::ExecutionContext> getThreadPoolExecutionContext(const std::string &name) override;
+            std::shared_ptr<api::ExecutionContext> getMainExecutionContext() override;
+            std::shared_ptr<api::Lock> newLock() override;
+
+            Stats getStats() const;
+            void stop();
+
+        private:
+            class StrandExecutionContext;
+
+            std::shared_ptr<WorkStealingThreadPool> _pool;
+            std::shared_ptr<TimerWheel> _timers;
+            std::shared_ptr<api::ExecutionContext> _poolContext;
+            std::shared_ptr<StrandExecutionContext> _mainContext;
+            mutable std::mutex _lock;
+            std::unordered_map<std::string, std::shared_ptr<StrandExecutionContext>> _serialContexts;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_THREADPOOLDISPATCHER_HPP
@@ -40,29 +40,56 @@ namespace ledger {
 
             namespace internals {
 
+                /**
+                 * Walk the futures in order, consuming the ones already completed in a loop and only registering a
+                 * callback (which resumes the walk) on the first pending one.
+                 */
                 template <class T>
-                Future<Unit> sequence_go(const std::shared_ptr<api::ExecutionContext>& context, int index, const std::vector< Future<T> >& futures, std::vector<T>* buffer) {
-                if (index >= futures.size())
-                return Future<Unit>::successful(unit);
-                else {
-                Future<T> fut = futures[index];
-                return fut.template flatMap<Unit>(context, [context, buffer, index, futures](const T &r) -> Future<Unit> {
-                buffer->push_back(r);
-                return sequence_go(context, index + 1, futures, buffer);
-            });
-        }
-    }
+                class Sequence : public std::enable_shared_from_this<Sequence<T>> {
+                public:
+                    Sequence(const std::shared_ptr<api::ExecutionContext>& context, const std::vector< Future<T> >& futures)
+                        : _context(context), _futures(futures), _index(0), _deffer(Future< std::vector<T> >::make_deffered()) {
+                        _results.reserve(futures.size());
+                    }
 
-}
+                    Future< std::vector<T> > run() {
+                        resume();
+                        return Future< std::vector<T> >(_deffer);
+                    }
+
+                private:
+                    void resume() {
+                        while (_index < _futures.size()) {
+                            auto value = _futures[_index].getValue();
+                            if (value.isEmpty()) {
+                                auto self = this->shared_from_this();
+                                _futures[_index].onComplete(_context, [self] (const Try<T>&) {
+                                    self->resume();
+                                });
+                                return;
+                            }
+                            if (value.getValue().isFailure()) {
+                                _deffer->setError(value.getValue().getFailure());
+                                return;
+                            }
+                            _results.push_back(value.getValue().getValue());
+                            _index += 1;
+                        }
+                        _deffer->setValue(std::move(_results));
+                    }
+
+                    std::shared_ptr<api::ExecutionContext> _context;
+                    std::vector< Future<T> > _futures;
+                    size_t _index;
+                    std::vector<T> _results;
+                    std::shared_ptr<Deffered< std::vector<T> >> _deffer;
+                };
+
+            }
 
             template <class T>
             Future< std::vector<T> > sequence(const std::shared_ptr<api::ExecutionContext>& context, const std::vector< Future<T> >& futures) {
-            auto buffer = new std::vector<T>();
-            return internals::sequence_go<T>(context, 0, futures, buffer).template map< std::vector<T> >(context, [buffer] (const Unit&) -> std::vector<T> {
-            auto res = *buffer;
-            delete buffer;
-            return res;
-            });
+                return std::make_shared<internals::Sequence<T>>(context, futures)->run();
             }
 
         }
@@ -105,5 +105,13 @@ namespace ledger {
             return BitcoinExtendedPublicKey::deriveHash160(path);
         }
 
+        std::vector<std::vector<uint8_t>> BitcoinLikeExtendedPublicKey::deriveChildrenPublicKeys(uint32_t from, uint32_t to) const {
+            std::vector<std::vector<uint8_t>> result;
+            for (const auto& child : _key.deriveRange(from, to)) {
+                result.push_back(child.getPublicKey());
+            }
+            return result;
+        }
+
     }
 }
@@ -56,6 +56,11 @@ namespace ledger {
 
             std::vector<uint8_t> deriveHash160(const std::string &path) override;
 
+            /**
+             * Derive the public keys of the direct children from index `from` to index `to` (both included).
+             */
+            std::vector<std::vector<uint8_t>> deriveChildrenPublicKeys(uint32_t from, uint32_t to) const;
+
             std::string toBase58() override;
 
             std::string getRootPath() override;
@@ -34,7 +34,6 @@
 #include "RIPEMD160.hpp"
 #include "../utils/Exception.hpp"
 #include "HMAC.hpp"
-#include "../math/BigInt.h"
 #include "SECP256k1Point.hpp"
 #include "../bytes/BytesWriter.h"
 #include "HASH160.hpp"
@@ -43,11 +42,17 @@
 #include "Keccak.h"
 #include <api/Secp256k1.hpp>
 #include <crypto/BLAKE.h>
+#include <algorithm>
+#include <array>
 
 namespace ledger {
     namespace core {
 
-        static auto N = BigInt::fromHex("FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141");
+        // Order of the secp256k1 curve (big endian)
+        static const std::array<uint8_t, 32> N = {
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE,
+            0xBA, 0xAE, 0xDC, 0xE6, 0xAF, 0x48, 0xA0, 0x3B, 0xBF, 0xD2, 0x5E, 0x8C, 0xD0, 0x36, 0x41, 0x41
+        };
 
         DeterministicPublicKey::DeterministicPublicKey(const std::vector<uint8_t> &publicKey,
                                                        const std::vector<uint8_t> &chainCode, uint32_t childNum,
@@ -98,30 +103,50 @@ namespace ledger {
         }
 
         DeterministicPublicKey DeterministicPublicKey::derive(uint32_t childIndex) const {
-            if (childIndex & 0x80000000) {
+            return deriveRange(childIndex, childIndex).front();
+        }
+
+        std::vector<DeterministicPublicKey> DeterministicPublicKey::deriveRange(uint32_t from, uint32_t to) const {
+            if ((from & 0x80000000) || (to & 0x80000000)) {
                 throw Exception(api::ErrorCode::PRIVATE_DERIVATION_NOT_SUPPORTED, "Private derivation is not supported by DeterministicPublicKey");
             }
-            BytesWriter data;
-            data.writeByteArray(_key);
-            data.writeBeValue<uint32_t>(childIndex);
-
-            auto I = HMAC::sha512(_chainCode, data.toByteArray());
-            BigInt IL(std::vector<uint8_t >(I.begin(), I.begin() + 32), false);
-            std::vector<uint8_t> IR(I.begin() + 32, I.end());
-
-            if (IL >= N) {
-                throw Exception(api::ErrorCode::UNSUPPORTED_OPERATION, "Cannot derive key - IL >= N");
+            std::vector<DeterministicPublicKey> children;
+            if (to < from) {
+                return children;
             }
-
-            SECP256k1Point K = SECP256k1Point(_key).generatorMultiply(IL.toByteArray());
-            return DeterministicPublicKey(
-                    K.toByteArray(),
-                    IR,
-                    childIndex,
-                    _depth + 1,
-                    getFingerprint(),
-                    _networkIdentifier
-            );
+            children.reserve(to - from + 1);
+
+            const SECP256k1Point parent(_key);
+            const auto fingerprint = getFingerprint();
+            // Serialized parent key followed by the big endian child index
+            std::vector<uint8_t> data(_key);
+            const auto indexOffset = data.size();
+            data.resize(indexOffset + sizeof(uint32_t));
+            std::vector<uint8_t> IL(32);
+
+            for (auto childIndex = from; childIndex <= to; childIndex++) {
+                data[indexOffset] = static_cast<uint8_t>(childIndex >> 24);
+                data[indexOffset + 1] = static_cast<uint8_t>(childIndex >> 16);
+                data[indexOffset + 2] = static_cast<uint8_t>(childIndex >> 8);
+                data[indexOffset + 3] = static_cast<uint8_t>(childIndex);
+
+                auto I = HMAC::sha512(_chainCode, data);
+                std::copy(I.begin(), I.begin() + 32, IL.begin());
+                if (!std::lexicographical_compare(IL.begin(), IL.end(), N.begin(), N.end())) {
+                    throw Exception(api::ErrorCode::UNSUPPORTED_OPERATION, "Cannot derive key - IL >= N");
+                }
+
+                auto K = parent.generatorMultiply(IL);
+                children.emplace_back(
+                        K.toByteArray(),
+                        std::vector<uint8_t>(I.begin() + 32, I.end()),
+                        childIndex,
+                        _depth + 1,
+                        fingerprint,
+                        _networkIdentifier
+                );
+            }
+            return children;
         }
 
         std::vector<uint8_t> DeterministicPublicKey::toByteArray(const std::vector<uint8_t> &version) const {
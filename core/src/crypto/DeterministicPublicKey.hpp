@@ -32,6 +32,8 @@
 #define LEDGER_CORE_DETERMINISTICPUBLICKEY_HPP
 
 #include <vector>
+#include <string>
+#include <cstdint>
 
 namespace ledger {
     namespace core {
@@ -47,6 +49,11 @@ namespace ledger {
             DeterministicPublicKey(const DeterministicPublicKey& key);
             uint32_t getFingerprint() const;
             DeterministicPublicKey derive(uint32_t childIndex) const;
+            /**
+             * Derive all the children from index `from` to index `to` (both included). The parent point
+             * and fingerprint are computed once for the whole range.
+             */
+            std::vector<DeterministicPublicKey> deriveRange(uint32_t from, uint32_t to) const;
 
             const std::vector<uint8_t>& getPublicKey() const;
             std::vector<uint8_t> getUncompressedPublicKey() const;
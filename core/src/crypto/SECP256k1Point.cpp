@@ -62,7 +62,14 @@ namespace ledger {
         }
 
         SECP256k1Point &SECP256k1Point::operator=(const SECP256k1Point &p) {
-            _pubKey = new secp256k1_pubkey();
+            if (p._pubKey == nullptr) {
+                delete _pubKey;
+                _pubKey = nullptr;
+                return *this;
+            }
+            if (_pubKey == nullptr) {
+                _pubKey = new secp256k1_pubkey();
+            }
             ::memcpy(_pubKey, p._pubKey, sizeof(*p._pubKey));
             return *this;
         }
@@ -78,14 +85,11 @@ namespace ledger {
             auto num = n;
             VectorUtils::padOnLeft<uint8_t>(num, 0, 32);
 
-            std::unique_ptr<secp256k1_pubkey> pubKey(new secp256k1_pubkey());
-            memcpy(pubKey.get(), _pubKey, sizeof(*pubKey));
-            std::vector<uint8_t> serializedKey(33);
-            auto len = serializedKey.size();
-            auto flag = secp256k1_ec_pubkey_tweak_add(_context.ptr, _pubKey, num.data());
+            // Tweak a copy of the parsed point, the result doesn't need to go through serialization
+            SECP256k1Point result(*this);
+            auto flag = secp256k1_ec_pubkey_tweak_add(_context.ptr, result._pubKey, num.data());
             if (flag == 0) throw Exception(api::ErrorCode::RUNTIME_ERROR, "SECP256k1Point SECP256k1Point::generatorMultiply(const std::vector<uint8_t> &n) failed");
-            secp256k1_ec_pubkey_serialize(_context.ptr, serializedKey.data(), &len, _pubKey, SECP256K1_EC_COMPRESSED);
-            return SECP256k1Point(serializedKey);
+            return result;
         }
 
         std::vector<uint8_t> SECP256k1Point::toByteArray(bool compressed) const {
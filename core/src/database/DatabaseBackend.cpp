@@ -45,6 +45,14 @@ namespace ledger {
             return std::make_shared<SQLite3Backend>();
         }
 
+        std::shared_ptr<api::DatabaseBackend> api::DatabaseBackend::getSqlite3BackendWithOptions(int32_t readonlyConnectionPoolSize,
+                                                                                                 bool enableWal,
+                                                                                                 const std::string &synchronous,
+                                                                                                 int32_t cacheSize,
+                                                                                                 int64_t mmapSize) {
+            return std::make_shared<SQLite3Backend>(readonlyConnectionPoolSize, enableWal, synchronous, cacheSize, mmapSize);
+        }
+
         std::shared_ptr<api::DatabaseBackend> api::DatabaseBackend::getPostgreSQLBackend(int32_t connectionPoolSize, int32_t readonlyConnectionPoolSize) {
 #ifdef PG_SUPPORT
             return std::make_shared<PostgreSQLBackend>(connectionPoolSize, readonlyConnectionPoolSize);
@@ -131,6 +131,12 @@ namespace ledger {
                 auto& session = getPool().at(i);
                 _backend->changePassword(oldPassword, newPassword, session);
             }
+            // Readonly sessions are still opened with the old password
+            auto readonlyPoolSize = _backend->getReadonlyConnectionPoolSize();
+            for (size_t i = 0; i < readonlyPoolSize; i++) {
+                auto& session = getReadonlyPool().at(i);
+                _backend->setPassword(newPassword, session);
+            }
         }
 
         bool DatabaseSessionPool::isSqlite() const {
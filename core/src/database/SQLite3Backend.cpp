@@ -30,12 +30,40 @@
  */
 #include "SQLite3Backend.hpp"
 #include <utils/Exception.hpp>
+#include <algorithm>
+#include <cctype>
 
 using namespace soci;
 
 namespace ledger {
     namespace core {
-        SQLite3Backend::SQLite3Backend() : DatabaseBackend() {
+        // Time spent waiting for a lock held by another connection before failing with SQLITE_BUSY
+        static const int32_t SQLITE_BUSY_TIMEOUT_MS = 5000;
+
+        SQLite3Backend::SQLite3Backend() : SQLite3Backend(1, false, "", 0, 0) {
+        }
+
+        SQLite3Backend::SQLite3Backend(int32_t readonlyConnectionPoolSize,
+                                       bool enableWal,
+                                       const std::string &synchronous,
+                                       int32_t cacheSize,
+                                       int64_t mmapSize) :
+            DatabaseBackend(),
+            _readonlyConnectionPoolSize(readonlyConnectionPoolSize),
+            _enableWal(enableWal),
+            _synchronous(synchronous),
+            _cacheSize(cacheSize),
+            _mmapSize(mmapSize) {
+            if (_readonlyConnectionPoolSize < 1) {
+                throw make_exception(api::ErrorCode::INVALID_ARGUMENT, "SQLite readonly connection pool size must be at least 1, got {}.", _readonlyConnectionPoolSize);
+            }
+            std::transform(_synchronous.begin(), _synchronous.end(), _synchronous.begin(), ::toupper);
+            if (!_synchronous.empty() && _synchronous != "OFF" && _synchronous != "NORMAL" && _synchronous != "FULL" && _synchronous != "EXTRA") {
+                throw make_exception(api::ErrorCode::INVALID_ARGUMENT, "Invalid SQLite synchronous mode: {}.", synchronous);
+            }
+            if (_mmapSize < 0) {
+                throw make_exception(api::ErrorCode::INVALID_ARGUMENT, "SQLite mmap size must be positive, got {}.", _mmapSize);
+            }
         }
 
         int32_t SQLite3Backend::getConnectionPoolSize() {
@@ -43,7 +71,7 @@ namespace ledger {
         }
 
         int32_t SQLite3Backend::getReadonlyConnectionPoolSize() {
-            return 1;
+            return _readonlyConnectionPoolSize;
         }
 
         void SQLite3Backend::init(const std::shared_ptr<ledger::core::api::PathResolver> &resolver,
@@ -52,7 +80,27 @@ namespace ledger {
                                   soci::session &session) {
             _dbResolvedPath = resolver->resolveDatabasePath(dbName);
             setPassword(password, session);
+        }
+
+        void SQLite3Backend::configureSession(soci::session &session) {
             session << "PRAGMA foreign_keys = ON";
+            if (_enableWal) {
+                // Persistent at the database level, readers no longer block (and get blocked by) the writer
+                std::string journalMode;
+                session << "PRAGMA journal_mode = WAL", soci::into(journalMode);
+            }
+            if (_enableWal || _readonlyConnectionPoolSize > 1) {
+                session << fmt::format("PRAGMA busy_timeout = {}", SQLITE_BUSY_TIMEOUT_MS);
+            }
+            if (!_synchronous.empty()) {
+                session << fmt::format("PRAGMA synchronous = {}", _synchronous);
+            }
+            if (_cacheSize != 0) {
+                session << fmt::format("PRAGMA cache_size = {}", _cacheSize);
+            }
+            if (_mmapSize > 0) {
+                session << fmt::format("PRAGMA mmap_size = {}", _mmapSize);
+            }
         }
 
         void SQLite3Backend::setPassword(const std::string &password,
@@ -63,6 +111,7 @@ namespace ledger {
             auto parameters = fmt::format("dbname=\"{}\" ", _dbResolvedPath) + fmt::format("key=\"{}\" ", password);
             session.close();
             session.open(*soci::factory_sqlite3(), parameters);
+            configureSession(session);
         }
 
         void SQLite3Backend::changePassword(const std::string & oldPassword,
@@ -89,6 +138,7 @@ namespace ledger {
             db_params = fmt::format("dbname=\"{}\" ", _dbResolvedPath) + fmt::format("key=\"{}\" ", newPassword);
             session.close();
             session.open(*soci::factory_sqlite3(), db_params);
+            configureSession(session);
         }
     }
 }
@@ -40,6 +40,11 @@ namespace ledger {
      class SQLite3Backend : public DatabaseBackend {
      public:
          SQLite3Backend();
+         SQLite3Backend(int32_t readonlyConnectionPoolSize,
+                        bool enableWal,
+                        const std::string &synchronous,
+                        int32_t cacheSize,
+                        int64_t mmapSize);
          int32_t getConnectionPoolSize() override;
          int32_t getReadonlyConnectionPoolSize() override;
 
@@ -56,8 +61,17 @@ namespace ledger {
                              soci::session &session) override;
 
      private:
+         // Apply the per connection pragmas, needed every time a session is (re)opened
+         void configureSession(soci::session &session);
+
          // Resolved path to db
          std::string _dbResolvedPath;
+         // SQLite allows a single writer at a time, only the readonly pool can grow
+         int32_t _readonlyConnectionPoolSize;
+         bool _enableWal;
+         std::string _synchronous;
+         int32_t _cacheSize;
+         int64_t _mmapSize;
      };
  }
 }
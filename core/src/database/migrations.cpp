@@ -32,6 +32,7 @@
 #include "migrations.hpp"
 #include <api/BitcoinLikeNetworkParameters.hpp>
 #include <wallet/bitcoin/networks.hpp>
+#include <fmt/format.h>
 
 namespace ledger {
     namespace core {
@@ -1205,5 +1206,206 @@ namespace ledger {
             sql << "DROP INDEX bitcoin_operations_transaction_uid_index ;";
         }
 
+        template <> void migrate<29>(soci::session& sql, api::DatabaseBackendType type) {
+            // Balance of an account at the end of a day (UTC), for every day having operations.
+            // The day is the 'YYYY-MM-DD' prefix of operations.date and the balance is hex encoded.
+            sql << "CREATE TABLE balance_checkpoints("
+                   "account_uid VARCHAR(255) NOT NULL REFERENCES accounts(uid) ON DELETE CASCADE,"
+                   "day VARCHAR(10) NOT NULL,"
+                   "balance VARCHAR(255) NOT NULL,"
+                   "PRIMARY KEY (account_uid, day)"
+                   ")";
+            sql << "CREATE INDEX operations_account_uid_date_index ON operations(account_uid, date)";
+
+            // Any change on an operation invalidates the checkpoints from the day of the operation.
+            // Using triggers covers every path touching the operations table (upserts, reorgs,
+            // cascading block deletions...).
+            if (type == api::DatabaseBackendType::POSTGRESQL) {
+                sql << "CREATE FUNCTION invalidate_balance_checkpoints() RETURNS TRIGGER AS $$ "
+                       "BEGIN "
+                       "IF TG_OP <> 'DELETE' THEN "
+                       "DELETE FROM balance_checkpoints WHERE account_uid = NEW.account_uid AND day >= substr(NEW.date, 1, 10); "
+                       "END IF; "
+                       "IF TG_OP <> 'INSERT' THEN "
+                       "DELETE FROM balance_checkpoints WHERE account_uid = OLD.account_uid AND day >= substr(OLD.date, 1, 10); "
+                       "END IF; "
+                       "RETURN NULL; "
+                       "END; $$ LANGUAGE plpgsql";
+                sql << "CREATE TRIGGER balance_checkpoints_operation_insert AFTER INSERT OR DELETE ON operations "
+                       "FOR EACH ROW EXECUTE PROCEDURE invalidate_balance_checkpoints()";
+                sql << "CREATE TRIGGER balance_checkpoints_operation_update AFTER UPDATE ON operations "
+                       "FOR EACH ROW WHEN (OLD.amount IS DISTINCT FROM NEW.amount OR OLD.fees IS DISTINCT FROM NEW.fees "
+                       "OR OLD.type IS DISTINCT FROM NEW.type OR OLD.date IS DISTINCT FROM NEW.date) "
+                       "EXECUTE PROCEDURE invalidate_balance_checkpoints()";
+            } else {
+                sql << "CREATE TRIGGER balance_checkpoints_operation_insert AFTER INSERT ON operations "
+                       "BEGIN "
+                       "DELETE FROM balance_checkpoints WHERE account_uid = NEW.account_uid AND day >= substr(NEW.date, 1, 10); "
+                       "END";
+                sql << "CREATE TRIGGER balance_checkpoints_operation_delete AFTER DELETE ON operations "
+                       "BEGIN "
+                       "DELETE FROM balance_checkpoints WHERE account_uid = OLD.account_uid AND day >= substr(OLD.date, 1, 10); "
+                       "END";
+                sql << "CREATE TRIGGER balance_checkpoints_operation_update AFTER UPDATE ON operations "
+                       "WHEN OLD.amount IS NOT NEW.amount OR OLD.fees IS NOT NEW.fees "
+                       "OR OLD.type IS NOT NEW.type OR OLD.date IS NOT NEW.date "
+                       "BEGIN "
+                       "DELETE FROM balance_checkpoints WHERE account_uid = OLD.account_uid AND day >= substr(OLD.date, 1, 10); "
+                       "DELETE FROM balance_checkpoints WHERE account_uid = NEW.account_uid AND day >= substr(NEW.date, 1, 10); "
+                       "END";
+            }
+        }
+
+        template <> void rollback<29>(soci::session& sql, api::DatabaseBackendType type) {
+            if (type == api::DatabaseBackendType::POSTGRESQL) {
+                sql << "DROP TRIGGER balance_checkpoints_operation_insert ON operations";
+                sql << "DROP TRIGGER balance_checkpoints_operation_update ON operations";
+                sql << "DROP FUNCTION invalidate_balance_checkpoints()";
+            } else {
+                sql << "DROP TRIGGER balance_checkpoints_operation_insert";
+                sql << "DROP TRIGGER balance_checkpoints_operation_delete";
+                sql << "DROP TRIGGER balance_checkpoints_operation_update";
+            }
+            sql << "DROP INDEX operations_account_uid_date_index";
+            sql << "DROP TABLE balance_checkpoints";
+        }
+
+        template <> void migrate<30>(soci::session& sql, api::DatabaseBackendType type) {
+            // Serialized transactions (hex encoded) fetched to sign inputs spending their outputs.
+            // last_used drives the eviction once the store gets bigger than its maximum size.
+            sql << "CREATE TABLE bitcoin_raw_transactions("
+                   "currency_name VARCHAR(255) NOT NULL REFERENCES currencies(name) ON DELETE CASCADE,"
+                   "hash VARCHAR(255) NOT NULL,"
+                   "raw TEXT NOT NULL,"
+                   "size BIGINT NOT NULL,"
+                   "last_used BIGINT NOT NULL,"
+                   "PRIMARY KEY (currency_name, hash)"
+                   ")";
+            sql << "CREATE INDEX bitcoin_raw_transactions_last_used_index ON bitcoin_raw_transactions(currency_name, last_used)";
+        }
+
+        template <> void rollback<30>(soci::session& sql, api::DatabaseBackendType type) {
+            sql << "DROP INDEX bitcoin_raw_transactions_last_used_index";
+            sql << "DROP TABLE bitcoin_raw_transactions";
+        }
+
+        template <> void migrate<31>(soci::session& sql, api::DatabaseBackendType type) {
+            // Typed copies of the string columns used to sort and filter operations: dates as
+            // seconds since epoch and amounts as zero left padded hex (see soci::to_sortable_hex),
+            // which compare in numerical order.
+            sql << "ALTER TABLE operations ADD COLUMN date_epoch BIGINT";
+            sql << "ALTER TABLE operations ADD COLUMN sortable_amount VARCHAR(64)";
+            sql << "ALTER TABLE operations ADD COLUMN sortable_fees VARCHAR(64)";
+
+            std::string epoch, amount, fees;
+            if (type == api::DatabaseBackendType::POSTGRESQL) {
+                epoch = "CAST(EXTRACT(EPOCH FROM CAST(date AS TIMESTAMP WITH TIME ZONE)) AS BIGINT)";
+                amount = "lpad(amount, 64, '0')";
+                fees = "lpad(COALESCE(fees, '0'), 64, '0')";
+            } else {
+                const std::string zeros(64, '0');
+                epoch = "COALESCE(CAST(strftime('%s', date) AS INTEGER), 0)";
+                amount = fmt::format("substr('{}' || amount, -64)", zeros);
+                fees = fmt::format("substr('{}' || COALESCE(fees, '0'), -64)", zeros);
+            }
+
+            // The migration runs in a single transaction, chunking the backfill wouldn't make it lighter
+            sql << fmt::format("UPDATE operations SET date_epoch = {}, sortable_amount = {}, sortable_fees = {}",
+                               epoch, amount, fees);
+
+            sql << "CREATE INDEX operations_account_uid_date_epoch_index ON operations(account_uid, date_epoch)";
+            sql << "CREATE INDEX operations_account_uid_block_uid_index ON operations(account_uid, block_uid)";
+            sql << "CREATE INDEX blocks_currency_name_height_index ON blocks(currency_name, height)";
+        }
+
+        template <> void rollback<31>(soci::session& sql, api::DatabaseBackendType type) {
+            sql << "DROP INDEX blocks_currency_name_height_index";
+            sql << "DROP INDEX operations_account_uid_block_uid_index";
+            sql << "DROP INDEX operations_account_uid_date_epoch_index";
+            // SQLite doesn't handle ALTER TABLE DROP, the (unused) columns are left in place
+            if (type != api::DatabaseBackendType::SQLITE3) {
+                sql << "ALTER TABLE operations DROP sortable_fees";
+                sql << "ALTER TABLE operations DROP sortable_amount";
+                sql << "ALTER TABLE operations DROP date_epoch";
+            }
+        }
+
+        template <> void migrate<32>(soci::session& sql, api::DatabaseBackendType type) {
+            // Set when an input spends the output, so that the unspent outputs of an account are
+            // read from an index instead of anti-joining all the outputs with all the inputs.
+            sql << "ALTER TABLE bitcoin_outputs ADD COLUMN spent INTEGER NOT NULL DEFAULT 0";
+            sql << "CREATE INDEX bitcoin_inputs_previous_output_index ON bitcoin_inputs(previous_tx_uid, previous_output_idx)";
+            sql << "UPDATE bitcoin_outputs SET spent = 1 WHERE EXISTS ("
+                   "SELECT 1 FROM bitcoin_inputs AS i WHERE i.previous_tx_uid = bitcoin_outputs.transaction_uid "
+                   "AND i.previous_output_idx = bitcoin_outputs.idx)";
+            sql << "CREATE INDEX bitcoin_outputs_account_uid_spent_index ON bitcoin_outputs(account_uid, spent, block_height)";
+
+            // Like the balance checkpoints, the flag is maintained by triggers so that every path
+            // inserting or removing inputs (bulk inserts, reorgs, mempool cleanup, account
+            // deletion...) keeps it in sync. An output may also be inserted after the input
+            // spending it.
+            const auto markSpent = "UPDATE bitcoin_outputs SET spent = 1 "
+                                   "WHERE transaction_uid = NEW.previous_tx_uid AND idx = NEW.previous_output_idx";
+            const auto markUnspent = "UPDATE bitcoin_outputs SET spent = 0 "
+                                     "WHERE transaction_uid = OLD.previous_tx_uid AND idx = OLD.previous_output_idx "
+                                     "AND NOT EXISTS (SELECT 1 FROM bitcoin_inputs AS i "
+                                     "WHERE i.previous_tx_uid = OLD.previous_tx_uid AND i.previous_output_idx = OLD.previous_output_idx)";
+            const auto markNewOutput = "UPDATE bitcoin_outputs SET spent = 1 "
+                                       "WHERE transaction_uid = NEW.transaction_uid AND idx = NEW.idx "
+                                       "AND EXISTS (SELECT 1 FROM bitcoin_inputs AS i "
+                                       "WHERE i.previous_tx_uid = NEW.transaction_uid AND i.previous_output_idx = NEW.idx)";
+            if (type == api::DatabaseBackendType::POSTGRESQL) {
+                sql << fmt::format("CREATE FUNCTION bitcoin_outputs_mark_spent() RETURNS TRIGGER AS $$ "
+                                   "BEGIN {}; RETURN NULL; END; $$ LANGUAGE plpgsql", markSpent);
+                sql << fmt::format("CREATE FUNCTION bitcoin_outputs_mark_unspent() RETURNS TRIGGER AS $$ "
+                                   "BEGIN {}; RETURN NULL; END; $$ LANGUAGE plpgsql", markUnspent);
+                sql << fmt::format("CREATE FUNCTION bitcoin_outputs_mark_new_output() RETURNS TRIGGER AS $$ "
+                                   "BEGIN {}; RETURN NULL; END; $$ LANGUAGE plpgsql", markNewOutput);
+                sql << "CREATE TRIGGER bitcoin_outputs_spent_input_insert AFTER INSERT ON bitcoin_inputs "
+                       "FOR EACH ROW EXECUTE PROCEDURE bitcoin_outputs_mark_spent()";
+                sql << "CREATE TRIGGER bitcoin_outputs_spent_input_delete AFTER DELETE ON bitcoin_inputs "
+                       "FOR EACH ROW EXECUTE PROCEDURE bitcoin_outputs_mark_unspent()";
+                sql << "CREATE TRIGGER bitcoin_outputs_spent_output_insert AFTER INSERT ON bitcoin_outputs "
+                       "FOR EACH ROW EXECUTE PROCEDURE bitcoin_outputs_mark_new_output()";
+            } else {
+                sql << fmt::format("CREATE TRIGGER bitcoin_outputs_spent_input_insert AFTER INSERT ON bitcoin_inputs "
+                                   "BEGIN {}; END", markSpent);
+                sql << fmt::format("CREATE TRIGGER bitcoin_outputs_spent_input_delete AFTER DELETE ON bitcoin_inputs "
+                                   "BEGIN {}; END", markUnspent);
+                sql << fmt::format("CREATE TRIGGER bitcoin_outputs_spent_output_insert AFTER INSERT ON bitcoin_outputs "
+                                   "BEGIN {}; END", markNewOutput);
+            }
+        }
+
+        template <> void rollback<32>(soci::session& sql, api::DatabaseBackendType type) {
+            if (type == api::DatabaseBackendType::POSTGRESQL) {
+                sql << "DROP TRIGGER bitcoin_outputs_spent_input_insert ON bitcoin_inputs";
+                sql << "DROP TRIGGER bitcoin_outputs_spent_input_delete ON bitcoin_inputs";
+                sql << "DROP TRIGGER bitcoin_outputs_spent_output_insert ON bitcoin_outputs";
+                sql << "DROP FUNCTION bitcoin_outputs_mark_spent()";
+                sql << "DROP FUNCTION bitcoin_outputs_mark_unspent()";
+                sql << "DROP FUNCTION bitcoin_outputs_mark_new_output()";
+            } else {
+                sql << "DROP TRIGGER bitcoin_outputs_spent_input_insert";
+                sql << "DROP TRIGGER bitcoin_outputs_spent_input_delete";
+                sql << "DROP TRIGGER bitcoin_outputs_spent_output_insert";
+            }
+            sql << "DROP INDEX bitcoin_outputs_account_uid_spent_index";
+            sql << "DROP INDEX bitcoin_inputs_previous_output_index";
+            // SQLite doesn't handle ALTER TABLE DROP, the (unused) column is left in place
+            if (type != api::DatabaseBackendType::SQLITE3) {
+                sql << "ALTER TABLE bitcoin_outputs DROP spent";
+            }
+        }
+
+        template <> void migrate<33>(soci::session& sql, api::DatabaseBackendType type) {
+            // Token balance histories walk the operations of an ERC20 account in date order
+            sql << "CREATE INDEX erc20_operations_account_uid_date_index ON erc20_operations(account_uid, date)";
+        }
+
+        template <> void rollback<33>(soci::session& sql, api::DatabaseBackendType type) {
+            sql << "DROP INDEX erc20_operations_account_uid_date_index";
+        }
+
     }
 }
@@ -215,6 +215,26 @@ namespace ledger {
         template <> void migrate<28>(soci::session& sql, api::DatabaseBackendType type);
         template <> void rollback<28>(soci::session& sql, api::DatabaseBackendType type);
 
+        // daily balance checkpoints used by balance histories
+        template <> void migrate<29>(soci::session& sql, api::DatabaseBackendType type);
+        template <> void rollback<29>(soci::session& sql, api::DatabaseBackendType type);
+
+        // raw transactions used to sign bitcoin inputs
+        template <> void migrate<30>(soci::session& sql, api::DatabaseBackendType type);
+        template <> void rollback<30>(soci::session& sql, api::DatabaseBackendType type);
+
+        // typed date and amount columns, and indexes, for operation queries
+        template <> void migrate<31>(soci::session& sql, api::DatabaseBackendType type);
+        template <> void rollback<31>(soci::session& sql, api::DatabaseBackendType type);
+
+        // spent flag on bitcoin outputs
+        template <> void migrate<32>(soci::session& sql, api::DatabaseBackendType type);
+        template <> void rollback<32>(soci::session& sql, api::DatabaseBackendType type);
+
+        // index ERC20 operations by account and date
+        template <> void migrate<33>(soci::session& sql, api::DatabaseBackendType type);
+        template <> void rollback<33>(soci::session& sql, api::DatabaseBackendType type);
+
     }
 }
 
@@ -45,10 +45,15 @@ namespace ledger {
                 }
             }
 
-            if (_filter) {
+            if (_filter && _condition.nonEmpty()) {
+                query << " WHERE (" << _filter->getHead()->toString() << ") AND ("
+                      << std::get<0>(_condition.getValue()) << ")";
+            } else if (_filter) {
                 query << " WHERE ";
                 std::string sFilter = _filter->getHead()->toString();
                 query << sFilter;
+            } else if (_condition.nonEmpty()) {
+                query << " WHERE " << std::get<0>(_condition.getValue());
             }
 
             if (!_order.empty()) {
@@ -75,6 +80,11 @@ namespace ledger {
             if (_filter) {
                 _filter->getHead()->bindValue(statement);
             }
+            if (_condition.nonEmpty()) {
+                for (const auto& value : std::get<1>(_condition.getValue())) {
+                    statement, soci::use(value);
+                }
+            }
             return statement;
         }
 
@@ -118,6 +128,16 @@ namespace ledger {
             return *this;
         }
 
+        QueryBuilder &QueryBuilder::clearOrder() {
+            _order.clear();
+            return *this;
+        }
+
+        QueryBuilder &QueryBuilder::condition(const std::string &condition, const std::vector<std::string> &values) {
+            _condition = Option<std::tuple<std::string, std::vector<std::string>>>(std::make_tuple(condition, values));
+            return *this;
+        }
+
         QueryBuilder &QueryBuilder::limit(int32_t limit) {
             _limit = limit;
             return *this;
@@ -129,7 +149,14 @@ namespace ledger {
         }
 
         QueryBuilder& QueryBuilder::outerJoin(const std::string &table, const std::string &condition) {
-            _outerJoins.emplace_back(Option<LeftOuterJoin>(std::make_tuple(table, condition)));
+            // Queries may be executed several times (e.g. when paginated), only join a table once
+            auto join = std::make_tuple(table, condition);
+            for (const auto& outerJoin : _outerJoins) {
+                if (outerJoin.nonEmpty() && outerJoin.getValue() == join) {
+                    return *this;
+                }
+            }
+            _outerJoins.emplace_back(Option<LeftOuterJoin>(std::move(join)));
             return *this;
         }
 
@@ -35,6 +35,7 @@
 #include <soci.h>
 #include <list>
 #include <tuple>
+#include <vector>
 #include <utils/Option.hpp>
 
 namespace ledger {
@@ -53,6 +54,12 @@ namespace ledger {
             QueryBuilder& where(const std::shared_ptr<api::QueryFilter>& filter);
             QueryBuilder& outerJoin(const std::string& table, const std::string& condition);
             QueryBuilder& order(std::string&& keys, bool&& descending, std::string&& table);
+            QueryBuilder& clearOrder();
+            /**
+             * Raw SQL condition ANDed with the filter, its placeholders are bound (in order) to the
+             * given values after the ones of the filter. Replaces any previous condition.
+             */
+            QueryBuilder& condition(const std::string& condition, const std::vector<std::string>& values);
             QueryBuilder& limit(int32_t limit);
             QueryBuilder& offset(int32_t offset);
             soci::details::prepare_temp_type execute(soci::session& sql);
@@ -66,6 +73,7 @@ namespace ledger {
             std::list<std::tuple<std::string, bool, std::string>> _order;
             std::vector<Option<LeftOuterJoin>> _outerJoins;
             std::shared_ptr<QueryFilter> _filter;
+            Option<std::tuple<std::string, std::vector<std::string>>> _condition;
             Option<int32_t> _limit;
             Option<int32_t> _offset;
         };
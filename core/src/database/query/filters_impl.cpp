@@ -30,7 +30,9 @@
  */
 
 #include "ConditionQueryFilter.h"
-#include <utils/DateUtils.hpp>
+#include <database/soci-number.h>
+#include <api/Amount.hpp>
+#include <api/BigInt.hpp>
 #include <cereal/external/base64.hpp>
 #include <api/TrustLevel.hpp>
 #include <api/OperationType.hpp>
@@ -38,6 +40,15 @@
 namespace ledger {
     namespace core {
 
+        // Dates, amounts and fees are filtered on the typed columns of the operations table
+        static int64_t toEpoch(const std::chrono::system_clock::time_point &time) {
+            return std::chrono::system_clock::to_time_t(time);
+        }
+
+        static std::string toSortable(const std::shared_ptr<api::Amount> &amount) {
+            return soci::to_sortable_hex(amount->toBigInt()->toString(16));
+        }
+
         std::shared_ptr<api::QueryFilter> api::QueryFilter::accountEq(const std::string &accountUid) {
             return std::make_shared<ConditionQueryFilter<std::string>>("account_uid", "=", accountUid, "o");
         }
@@ -47,27 +58,27 @@ namespace ledger {
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::dateEq(const std::chrono::system_clock::time_point &time) {
-            return std::make_shared<ConditionQueryFilter<std::string>>("date", "=", DateUtils::toJSON(time), "o");
+            return std::make_shared<ConditionQueryFilter<int64_t>>("date_epoch", "=", toEpoch(time), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::dateGt(const std::chrono::system_clock::time_point &time) {
-            return std::make_shared<ConditionQueryFilter<std::string>>("date", ">", DateUtils::toJSON(time), "o");
+            return std::make_shared<ConditionQueryFilter<int64_t>>("date_epoch", ">", toEpoch(time), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::dateGte(const std::chrono::system_clock::time_point &time) {
-            return std::make_shared<ConditionQueryFilter<std::string>>("date", ">=", DateUtils::toJSON(time), "o");
+            return std::make_shared<ConditionQueryFilter<int64_t>>("date_epoch", ">=", toEpoch(time), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::dateNeq(const std::chrono::system_clock::time_point &time) {
-            return std::make_shared<ConditionQueryFilter<std::string>>("date", "<>", DateUtils::toJSON(time), "o");
+            return std::make_shared<ConditionQueryFilter<int64_t>>("date_epoch", "<>", toEpoch(time), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::dateLt(const std::chrono::system_clock::time_point &time) {
-            return std::make_shared<ConditionQueryFilter<std::string>>("date", "<", DateUtils::toJSON(time), "o");
+            return std::make_shared<ConditionQueryFilter<int64_t>>("date_epoch", "<", toEpoch(time), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::dateLte(const std::chrono::system_clock::time_point &time) {
-            return std::make_shared<ConditionQueryFilter<std::string>>("date", "<=", DateUtils::toJSON(time), "o");
+            return std::make_shared<ConditionQueryFilter<int64_t>>("date_epoch", "<=", toEpoch(time), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::trustEq(TrustLevel trust) {
@@ -103,51 +114,51 @@ namespace ledger {
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesEq(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", "=", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_fees", "=", toSortable(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesNeq(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", "<>", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_fees", "<>", toSortable(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesGt(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", ">", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_fees", ">", toSortable(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesLt(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", "<", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_fees", "<", toSortable(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesGte(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", ">=", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_fees", ">=", toSortable(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::feesLte(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("fees", "<=", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_fees", "<=", toSortable(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountEq(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", "=", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_amount", "=", toSortable(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountNeq(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", "<>", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_amount", "<>", toSortable(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountGt(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", ">", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_amount", ">", toSortable(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountGte(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", ">=", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_amount", ">=", toSortable(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountLt(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", "<", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_amount", "<", toSortable(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::amountLte(const std::shared_ptr<Amount> &amount) {
-            return std::make_shared<ConditionQueryFilter<int64_t>>("amount", "<=", amount->toLong(), "o");
+            return std::make_shared<ConditionQueryFilter<std::string>>("sortable_amount", "<=", toSortable(amount), "o");
         }
 
         std::shared_ptr<api::QueryFilter> api::QueryFilter::blockHeightEq(int64_t blockHeight) {
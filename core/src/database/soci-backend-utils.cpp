@@ -39,4 +39,15 @@ namespace soci {
     bool is_postgres_backend(soci::session& sql) {
         return sql.get_backend_name() == "postgresql";
     }
+
+    std::string in_placeholders(std::size_t count) {
+        std::string placeholders;
+        for (std::size_t index = 0; index < count; index++) {
+            if (index > 0) {
+                placeholders += ", ";
+            }
+            placeholders += ":v" + std::to_string(index);
+        }
+        return placeholders;
+    }
 }
\ No newline at end of file
@@ -33,12 +33,29 @@
 #define LEDGER_CORE_SOCI_BACKEND_UTILS_H
 
 #include <soci.h>
+#include <string>
+#include <vector>
 
 namespace soci {
 
     bool is_sqlite_backend(soci::session& sql);
     bool is_postgres_backend(soci::session& sql);
 
+    // Maximum number of values bound to a single IN clause (SQLite limits the number of
+    // host parameters of a statement to 999 by default)
+    const std::size_t MAX_IN_CLAUSE_SIZE = 500;
+
+    // Placeholders for `count` values in an IN clause (":v0, :v1, ...")
+    std::string in_placeholders(std::size_t count);
+
+    // Bind all the values of an IN clause built with in_placeholders
+    template <typename T>
+    void use_all(details::prepare_temp_type& statement, const std::vector<T>& values) {
+        for (const auto& value : values) {
+            statement, use(value);
+        }
+    }
+
 }
 
 #endif //LEDGER_CORE_SOCI_BACKEND_UTILS_H
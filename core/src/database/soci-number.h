@@ -51,6 +51,18 @@ namespace soci {
 
     };
 
+    // Width of the sortable hex encoding, enough for any 256 bits number
+    const std::size_t SORTABLE_HEX_WIDTH = 64;
+
+    // Left pads a lowercase hex number with zeros so that comparing two encoded numbers as strings
+    // gives their numerical order (stored in the sortable_* columns of the operations table)
+    inline std::string to_sortable_hex(const std::string& hex) {
+        if (hex.size() >= SORTABLE_HEX_WIDTH) {
+            return hex;
+        }
+        return std::string(SORTABLE_HEX_WIDTH - hex.size(), '0') + hex;
+    }
+
     template<typename T>
     T get_number(const row& row, std::size_t pos) {
         auto prop = row.get_properties(pos);
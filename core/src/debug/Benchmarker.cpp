@@ -36,15 +36,31 @@
 namespace ledger {
     namespace core {
 
-        Benchmarker::Benchmarker(const std::string &name, const std::shared_ptr<spdlog::logger> &logger) {
+        Benchmarker::Benchmarker(const std::string &name, const std::shared_ptr<spdlog::logger> &logger, const std::string &tag) {
             _name = name;
+            _tag = tag;
             _logger = logger;
+            _histogram = DurationsMap::getInstance().getHistogram(name);
+        }
+
+        Benchmarker::Benchmarker(const std::string &name,
+                                 const std::shared_ptr<DurationHistogram> &histogram,
+                                 const std::shared_ptr<spdlog::logger> &logger,
+                                 const std::string &tag) {
+            _name = name;
+            _tag = tag;
+            _logger = logger;
+            _histogram = histogram;
         }
 
         Benchmarker &Benchmarker::start() {
             _startDate = std::chrono::high_resolution_clock::now();
             if (_logger) {
-                _logger->debug("{} started.", _name);
+                if (_tag.empty()) {
+                    _logger->debug("{} started.", _name);
+                } else {
+                    _logger->debug("{}/{} started.", _name, _tag);
+                }
             }
             return *this;
         }
@@ -52,9 +68,13 @@ namespace ledger {
         Benchmarker &Benchmarker::stop() {
             _stopDate = std::chrono::high_resolution_clock::now();
             if (_logger) {
-                _logger->debug("{} took {}.", _name, DurationUtils::formatDuration(getDuration()));
+                if (_tag.empty()) {
+                    _logger->debug("{} took {}.", _name, DurationUtils::formatDuration(getDuration()));
+                } else {
+                    _logger->debug("{}/{} took {}.", _name, _tag, DurationUtils::formatDuration(getDuration()));
+                }
             }
-            DurationsMap::getInstance().record(_name, getDuration());
+            _histogram->record(getDuration());
             return *this;
         }
 
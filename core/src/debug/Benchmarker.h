@@ -32,18 +32,37 @@
 #define LEDGER_CORE_BENCHMARKER_H
 
 #include "logger.hpp"
+#include "../metrics/DurationsMap.hpp"
+
+// Histogram of a static metric name, resolved on the first call only so that measurements don't
+// take the DurationsMap lock
+#define BENCHMARK_HISTOGRAM(name) ([] () -> const std::shared_ptr<ledger::core::DurationHistogram>& { \
+        static const auto histogram = ledger::core::DurationsMap::getInstance().getHistogram(name); \
+        return histogram; \
+    }())
 
 namespace ledger {
     namespace core {
+        /**
+         * Measure a duration, log it and record it in the histogram of the given metric name. The optional tag
+         * (e.g. the synchronization tag of an account) only appears in logs so that the set of metrics stays bounded.
+         */
         class Benchmarker {
         public:
-            Benchmarker(const std::string& name, const std::shared_ptr<spdlog::logger>& logger);
+            Benchmarker(const std::string& name, const std::shared_ptr<spdlog::logger>& logger, const std::string& tag = "");
+            // Records in the given histogram, see BENCHMARK_HISTOGRAM to resolve it once per call site
+            Benchmarker(const std::string& name,
+                        const std::shared_ptr<DurationHistogram>& histogram,
+                        const std::shared_ptr<spdlog::logger>& logger,
+                        const std::string& tag = "");
             Benchmarker& start();
             Benchmarker& stop();
             std::chrono::high_resolution_clock::duration getDuration() const;
         private:
             std::shared_ptr<spdlog::logger> _logger;
             std::string _name;
+            std::string _tag;
+            std::shared_ptr<DurationHistogram> _histogram;
             std::chrono::high_resolution_clock::time_point _startDate;
             std::chrono::high_resolution_clock::time_point _stopDate;
         };
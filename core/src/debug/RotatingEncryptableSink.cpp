@@ -33,14 +33,33 @@
 #include "utils/LambdaRunnable.hpp"
 #include "../api/ErrorCode.hpp"
 #include "../utils/Exception.hpp"
+#include <algorithm>
 
 namespace ledger {
     namespace core {
+        const std::size_t RotatingEncryptableSink::DEFAULT_BATCH_SIZE = 64 * 1024;
+        const std::size_t RotatingEncryptableSink::DEFAULT_MAX_BUFFERED_SIZE = 1024 * 1024;
+        const int64_t RotatingEncryptableSink::DEFAULT_FLUSH_INTERVAL_MS = 200;
+
         RotatingEncryptableSink::RotatingEncryptableSink(const std::shared_ptr<api::ExecutionContext> &context,
                                                          const std::shared_ptr<api::PathResolver> &resolver,
                                                          const std::string &name,
                                                          std::size_t maxSize,
-                                                         std::size_t maxFiles) {
+                                                         std::size_t maxFiles,
+                                                         std::size_t batchSize,
+                                                         std::size_t maxBufferedSize,
+                                                         int64_t flushIntervalMs,
+                                                         DropPolicy dropPolicy) :
+            _batchSize(batchSize),
+            _maxBufferedSize(std::max(batchSize, maxBufferedSize)),
+            _flushInterval(flushIntervalMs),
+            _dropPolicy(dropPolicy),
+            _pendingDroppedLines(0),
+            _timerScheduled(false),
+            _drainScheduled(false),
+            _queuedBytes(0),
+            _droppedBytes(0),
+            _droppedLines(0) {
             _context = context;
             _resolver = resolver;
             _name = name;
@@ -59,31 +78,145 @@ namespace ledger {
         }
 
         void RotatingEncryptableSink::sink_it_(const spdlog::details::log_msg &msg) {
-            auto context = _context;
-            std::shared_ptr<fmt::memory_buffer> buffer = std::make_shared<fmt::memory_buffer>();
-            formatter_->format(msg, *buffer);
-            auto self = shared_from_this();
-            context->execute(make_runnable([self, buffer] () {
-                self->_sink_it(buffer);
-            }));
+            // Called under the base_sink mutex, the scratch buffer is reused from one line to the next
+            _line.clear();
+            formatter_->format(msg, _line);
+            const auto size = _line.size();
+            bool drainNow = false;
+            bool startTimer = false;
+            {
+                std::lock_guard<std::mutex> lock(_bufferMutex);
+                if (_pending.size() + size > _maxBufferedSize) {
+                    if (_dropPolicy == DropPolicy::DROP_NEWEST || size > _maxBufferedSize) {
+                        _pendingDroppedLines += 1;
+                        _droppedLines += 1;
+                        _droppedBytes += size;
+                        return;
+                    }
+                    _pendingDroppedLines += _pendingLineEnds.size();
+                    _droppedLines += _pendingLineEnds.size();
+                    _droppedBytes += _pending.size();
+                    _queuedBytes -= _pending.size();
+                    _pending.clear();
+                    _pendingLineEnds.clear();
+                }
+                _pending.append(_line.data(), _line.data() + size);
+                _pendingLineEnds.push_back(_pending.size());
+                _queuedBytes += size;
+                if (_pending.size() >= _batchSize) {
+                    drainNow = !_drainScheduled;
+                    _drainScheduled = true;
+                } else if (!_timerScheduled) {
+                    startTimer = _timerScheduled = true;
+                }
+            }
+            // Post outside of the lock, the context may run the drain inline
+            if (drainNow || startTimer) {
+                _scheduleDrain(drainNow);
+            }
         }
 
         void RotatingEncryptableSink::flush_() {
-            auto context = _context;
-            context->execute(make_runnable([this] () {
-               _file_helper.flush();
-            }));
+            bool post;
+            {
+                std::lock_guard<std::mutex> lock(_bufferMutex);
+                post = !_drainScheduled;
+                _drainScheduled = true;
+            }
+            if (post) {
+                _scheduleDrain(true);
+            }
         }
 
-        void RotatingEncryptableSink::_sink_it(std::shared_ptr<fmt::memory_buffer> msg) {
-            // TODO: implement encryption
-            _current_size += msg->size();
-            if (_current_size > _max_size)
+        std::size_t RotatingEncryptableSink::getQueuedBytes() const {
+            return _queuedBytes;
+        }
+
+        std::size_t RotatingEncryptableSink::getDroppedBytes() const {
+            return _droppedBytes;
+        }
+
+        std::size_t RotatingEncryptableSink::getDroppedLines() const {
+            return _droppedLines;
+        }
+
+        void RotatingEncryptableSink::_scheduleDrain(bool immediate) {
+            auto self = shared_from_this();
+            auto runnable = make_runnable([self, immediate] () {
+                self->_drain(!immediate);
+            });
+            if (immediate) {
+                _context->execute(runnable);
+            } else {
+                _context->delay(runnable, _flushInterval);
+            }
+        }
+
+        void RotatingEncryptableSink::_drain(bool fromTimer) {
+            std::lock_guard<std::mutex> fileLock(_fileMutex);
+            std::size_t droppedLines;
             {
-                _rotate();
-                _current_size = msg->size();
+                std::lock_guard<std::mutex> lock(_bufferMutex);
+                if (fromTimer) {
+                    _timerScheduled = false;
+                } else {
+                    _drainScheduled = false;
+                }
+                // Both buffers keep their capacity, loggers append to the previously written one
+                std::swap(_pending, _writing);
+                std::swap(_pendingLineEnds, _writingLineEnds);
+                droppedLines = _pendingDroppedLines;
+                _pendingDroppedLines = 0;
+            }
+            _queuedBytes -= _writing.size();
+            if (droppedLines > 0) {
+                auto marker = fmt::format("{} log lines dropped by the sink{}", droppedLines, spdlog::details::os::default_eol);
+                _writing.append(marker.data(), marker.data() + marker.size());
+                _writingLineEnds.push_back(_writing.size());
+            }
+            if (_writing.size() == 0) {
+                return;
+            }
+            try {
+                _write(_writing, _writingLineEnds);
+                _file_helper.flush();
+            } catch (...) {
+                _writing.clear();
+                _writingLineEnds.clear();
+                throw;
+            }
+            _writing.clear();
+            _writingLineEnds.clear();
+        }
+
+        void RotatingEncryptableSink::_write(const fmt::memory_buffer &batch, const std::vector<std::size_t> &lineEnds) {
+            // TODO: implement encryption
+            if (_current_size + batch.size() <= _max_size) {
+                _file_helper.write(batch);
+                _current_size += batch.size();
+                return;
+            }
+            // The file has to be rotated in the middle of the batch, split it on line boundaries
+            _chunk.clear();
+            std::size_t begin = 0;
+            for (auto end : lineEnds) {
+                auto size = end - begin;
+                if (_current_size + size > _max_size) {
+                    if (_chunk.size() > 0) {
+                        _file_helper.write(_chunk);
+                        _chunk.clear();
+                    }
+                    _rotate();
+                    _current_size = 0;
+                }
+                _chunk.append(batch.data() + begin, batch.data() + end);
+                _current_size += size;
+                begin = end;
+            }
+            if (_chunk.size() > 0) {
+                _file_helper.write(_chunk);
+                _chunk.clear();
             }
-            _file_helper.write(*msg);
         }
 
         spdlog::filename_t RotatingEncryptableSink::calc_filename(std::shared_ptr<api::PathResolver> resolver,
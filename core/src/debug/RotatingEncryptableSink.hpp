@@ -38,34 +38,64 @@
 #include "api/PathResolver.hpp"
 #include <memory>
 #include "utils/optional.hpp"
+#include <atomic>
 #include <mutex>
+#include <vector>
 
 namespace ledger {
     namespace core {
         /**
          * Based on spdlog::sinks::rotating_file_sink
+         *
+         * Formatted lines are appended to an in-memory buffer which is swapped and drained on the execution context
+         * either after a flush interval or as soon as the buffer reaches the batch size. Each drain performs a single
+         * write and a single flush. When the buffer reaches its maximum size, lines are dropped according to the
+         * drop policy and a marker line reporting the loss is written with the next batch.
          */
         class RotatingEncryptableSink : public spdlog::sinks::base_sink<std::mutex>, public std::enable_shared_from_this<RotatingEncryptableSink> {
         public:
+            enum class DropPolicy {
+                // Reject incoming lines until the buffer is drained
+                DROP_NEWEST,
+                // Discard everything buffered so far to make room for the incoming line
+                DROP_BUFFERED
+            };
+
+            static const std::size_t DEFAULT_BATCH_SIZE;
+            static const std::size_t DEFAULT_MAX_BUFFERED_SIZE;
+            static const int64_t DEFAULT_FLUSH_INTERVAL_MS;
+
             RotatingEncryptableSink(
                     const std::shared_ptr<api::ExecutionContext> &context,
                     const std::shared_ptr<api::PathResolver> &resolver,
                     const std::string &name,
                     std::size_t maxSize,
-                    std::size_t maxFiles
+                    std::size_t maxFiles,
+                    std::size_t batchSize = DEFAULT_BATCH_SIZE,
+                    std::size_t maxBufferedSize = DEFAULT_MAX_BUFFERED_SIZE,
+                    int64_t flushIntervalMs = DEFAULT_FLUSH_INTERVAL_MS,
+                    DropPolicy dropPolicy = DropPolicy::DROP_NEWEST
             );
 
             virtual void sink_it_(const spdlog::details::log_msg &msg) override;
             virtual void flush_() override;
 
+            // Number of bytes waiting in the buffer to be written
+            std::size_t getQueuedBytes() const;
+            // Total number of bytes (and lines) discarded because the buffer was full
+            std::size_t getDroppedBytes() const;
+            std::size_t getDroppedLines() const;
+
         protected:
-            void _sink_it(std::shared_ptr<fmt::memory_buffer> msg);
+            void _drain(bool fromTimer);
 
         private:
             static spdlog::filename_t calc_filename(
                     std::shared_ptr<api::PathResolver> resolver,
                     const spdlog::filename_t& filename, std::size_t index, const spdlog::filename_t& extension);
 
+            void _scheduleDrain(bool immediate);
+            void _write(const fmt::memory_buffer &batch, const std::vector<std::size_t> &lineEnds);
             void _rotate();
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -82,6 +112,32 @@ namespace ledger {
             std::size_t _max_files;
             std::size_t _current_size;
             spdlog::details::file_helper _file_helper;
+
+            const std::size_t _batchSize;
+            const std::size_t _maxBufferedSize;
+            const int64_t _flushInterval;
+            const DropPolicy _dropPolicy;
+
+            // Scratch buffer for formatting, only touched under the base_sink mutex
+            fmt::memory_buffer _line;
+
+            // Lines appended by the loggers, guarded by _bufferMutex
+            std::mutex _bufferMutex;
+            fmt::memory_buffer _pending;
+            std::vector<std::size_t> _pendingLineEnds;
+            std::size_t _pendingDroppedLines;
+            bool _timerScheduled;
+            bool _drainScheduled;
+
+            // Batch being written, guarded by _fileMutex (with the file itself)
+            std::mutex _fileMutex;
+            fmt::memory_buffer _writing;
+            std::vector<std::size_t> _writingLineEnds;
+            fmt::memory_buffer _chunk;
+
+            std::atomic<std::size_t> _queuedBytes;
+            std::atomic<std::size_t> _droppedBytes;
+            std::atomic<std::size_t> _droppedLines;
         };
     }
 }
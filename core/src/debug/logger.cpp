@@ -56,7 +56,8 @@ namespace ledger {
                 spdlog::drop(name);
 
                 logger->set_level(spdlog::level::trace);
-                logger->flush_on(spdlog::level::trace);
+                // The file sink drains its buffer on its own, only errors ask for an early drain
+                logger->flush_on(spdlog::level::err);
                 logger->set_pattern("%Y-%m-%dT%XZ%z %L: %v");
                 return logger;
             } else {
@@ -8,6 +8,7 @@
 #include "BitcoinLikeOutput.hpp"
 #include "BitcoinLikeSignature.hpp"
 #include "BitcoinLikeSignatureState.hpp"
+#include "BoolCallback.hpp"
 #include "EstimatedSize.hpp"
 #include "Marshal.hpp"
 
@@ -208,4 +209,13 @@ CJNIEXPORT jobject JNICALL Java_co_ledger_core_BitcoinLikeTransaction_00024CppPr
     } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
 }
 
+CJNIEXPORT void JNICALL Java_co_ledger_core_BitcoinLikeTransaction_00024CppProxy_native_1prefetchPreviousTransactions(JNIEnv* jniEnv, jobject /*this*/, jlong nativeRef, jobject j_callback)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE1(jniEnv, nativeRef);
+        const auto& ref = ::djinni::objectFromHandleAddress<::ledger::core::api::BitcoinLikeTransaction>(nativeRef);
+        ref->prefetchPreviousTransactions(::djinni_generated::BoolCallback::toCpp(jniEnv, j_callback));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
+}
+
 }  // namespace djinni_generated
@@ -69,6 +69,19 @@ CJNIEXPORT jobject JNICALL Java_co_ledger_core_DatabaseBackend_getSqlite3Backend
     } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
 }
 
+CJNIEXPORT jobject JNICALL Java_co_ledger_core_DatabaseBackend_getSqlite3BackendWithOptions(JNIEnv* jniEnv, jobject /*this*/, jint j_readonlyConnectionPoolSize, jboolean j_enableWal, jstring j_synchronous, jint j_cacheSize, jlong j_mmapSize)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE0(jniEnv);
+        auto r = ::ledger::core::api::DatabaseBackend::getSqlite3BackendWithOptions(::djinni::I32::toCpp(jniEnv, j_readonlyConnectionPoolSize),
+                                                                                    ::djinni::Bool::toCpp(jniEnv, j_enableWal),
+                                                                                    ::djinni::String::toCpp(jniEnv, j_synchronous),
+                                                                                    ::djinni::I32::toCpp(jniEnv, j_cacheSize),
+                                                                                    ::djinni::I64::toCpp(jniEnv, j_mmapSize));
+        return ::djinni::release(::djinni_generated::DatabaseBackend::fromCpp(jniEnv, r));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
+}
+
 CJNIEXPORT jobject JNICALL Java_co_ledger_core_DatabaseBackend_getPostgreSQLBackend(JNIEnv* jniEnv, jobject /*this*/, jint j_connectionPoolSize, jint j_readonlyConnectionPoolSize)
 {
     try {
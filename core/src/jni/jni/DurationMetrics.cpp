@@ -3,6 +3,7 @@
 
 #include "DurationMetrics.hpp"  // my header
 #include "DurationMetric.hpp"
+#include "HistogramMetric.hpp"
 #include "Marshal.hpp"
 
 namespace djinni_generated {
@@ -29,4 +30,21 @@ CJNIEXPORT jobject JNICALL Java_co_ledger_core_DurationMetrics_getAllDurationMet
     } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
 }
 
+CJNIEXPORT jobject JNICALL Java_co_ledger_core_DurationMetrics_getHistogramMetrics(JNIEnv* jniEnv, jobject /*this*/)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE0(jniEnv);
+        auto r = ::ledger::core::api::DurationMetrics::getHistogramMetrics();
+        return ::djinni::release(::djinni::Map<::djinni::String, ::djinni_generated::HistogramMetric>::fromCpp(jniEnv, r));
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, 0 /* value doesn't matter */)
+}
+
+CJNIEXPORT void JNICALL Java_co_ledger_core_DurationMetrics_resetDurationMetrics(JNIEnv* jniEnv, jobject /*this*/)
+{
+    try {
+        DJINNI_FUNCTION_PROLOGUE0(jniEnv);
+        ::ledger::core::api::DurationMetrics::resetDurationMetrics();
+    } JNI_TRANSLATE_EXCEPTIONS_RETURN(jniEnv, )
+}
+
 }  // namespace djinni_generated
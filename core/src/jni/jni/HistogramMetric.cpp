@@ -0,0 +1,38 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from core.djinni
+
+#include "HistogramMetric.hpp"  // my header
+#include "Marshal.hpp"
+
+namespace djinni_generated {
+
+HistogramMetric::HistogramMetric() = default;
+
+HistogramMetric::~HistogramMetric() = default;
+
+auto HistogramMetric::fromCpp(JNIEnv* jniEnv, const CppType& c) -> ::djinni::LocalRef<JniType> {
+    const auto& data = ::djinni::JniClass<HistogramMetric>::get();
+    auto r = ::djinni::LocalRef<JniType>{jniEnv->NewObject(data.clazz.get(), data.jconstructor,
+                                                           ::djinni::get(::djinni::I64::fromCpp(jniEnv, c.count)),
+                                                           ::djinni::get(::djinni::I64::fromCpp(jniEnv, c.total_us)),
+                                                           ::djinni::get(::djinni::I64::fromCpp(jniEnv, c.p50_us)),
+                                                           ::djinni::get(::djinni::I64::fromCpp(jniEnv, c.p95_us)),
+                                                           ::djinni::get(::djinni::I64::fromCpp(jniEnv, c.p99_us)),
+                                                           ::djinni::get(::djinni::I64::fromCpp(jniEnv, c.max_us)))};
+    ::djinni::jniExceptionCheck(jniEnv);
+    return r;
+}
+
+auto HistogramMetric::toCpp(JNIEnv* jniEnv, JniType j) -> CppType {
+    ::djinni::JniLocalScope jscope(jniEnv, 7);
+    assert(j != nullptr);
+    const auto& data = ::djinni::JniClass<HistogramMetric>::get();
+    return {::djinni::I64::toCpp(jniEnv, jniEnv->GetLongField(j, data.field_count)),
+            ::djinni::I64::toCpp(jniEnv, jniEnv->GetLongField(j, data.field_totalUs)),
+            ::djinni::I64::toCpp(jniEnv, jniEnv->GetLongField(j, data.field_p50Us)),
+            ::djinni::I64::toCpp(jniEnv, jniEnv->GetLongField(j, data.field_p95Us)),
+            ::djinni::I64::toCpp(jniEnv, jniEnv->GetLongField(j, data.field_p99Us)),
+            ::djinni::I64::toCpp(jniEnv, jniEnv->GetLongField(j, data.field_maxUs))};
+}
+
+}  // namespace djinni_generated
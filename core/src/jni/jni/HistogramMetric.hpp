@@ -0,0 +1,39 @@
+// AUTOGENERATED FILE - DO NOT MODIFY!
+// This file generated by Djinni from core.djinni
+
+#ifndef DJINNI_GENERATED_HISTOGRAMMETRIC_HPP_JNI_
+#define DJINNI_GENERATED_HISTOGRAMMETRIC_HPP_JNI_
+
+#include "../../api/HistogramMetric.hpp"
+#include "djinni_support.hpp"
+
+namespace djinni_generated {
+
+class HistogramMetric final {
+public:
+    using CppType = ::ledger::core::api::HistogramMetric;
+    using JniType = jobject;
+
+    using Boxed = HistogramMetric;
+
+    ~HistogramMetric();
+
+    static CppType toCpp(JNIEnv* jniEnv, JniType j);
+    static ::djinni::LocalRef<JniType> fromCpp(JNIEnv* jniEnv, const CppType& c);
+
+private:
+    HistogramMetric();
+    friend ::djinni::JniClass<HistogramMetric>;
+
+    const ::djinni::GlobalRef<jclass> clazz { ::djinni::jniFindClass("co/ledger/core/HistogramMetric") };
+    const jmethodID jconstructor { ::djinni::jniGetMethodID(clazz.get(), "<init>", "(JJJJJJ)V") };
+    const jfieldID field_count { ::djinni::jniGetFieldID(clazz.get(), "count", "J") };
+    const jfieldID field_totalUs { ::djinni::jniGetFieldID(clazz.get(), "totalUs", "J") };
+    const jfieldID field_p50Us { ::djinni::jniGetFieldID(clazz.get(), "p50Us", "J") };
+    const jfieldID field_p95Us { ::djinni::jniGetFieldID(clazz.get(), "p95Us", "J") };
+    const jfieldID field_p99Us { ::djinni::jniGetFieldID(clazz.get(), "p99Us", "J") };
+    const jfieldID field_maxUs { ::djinni::jniGetFieldID(clazz.get(), "maxUs", "J") };
+};
+
+}  // namespace djinni_generated
+#endif //DJINNI_GENERATED_HISTOGRAMMETRIC_HPP_JNI_
@@ -37,7 +37,7 @@
 #include <boost/serialization/nvp.hpp>
 #include <boost/multiprecision/cpp_dec_float.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
-#include <cstdlib>
+#include <limits>
 #include <utils/endian.h>
 
 namespace ledger {
@@ -50,19 +50,102 @@ namespace ledger {
         const int BigInt::MIN_RADIX = 2;
         const int BigInt::MAX_RADIX = 36;
 
-        BigInt::BigInt() {
-            _bigd = bdNew();
-            _negative = false;
+        namespace {
+            // BIGD owned for the duration of a computation on the slow path
+            struct ScopedBigd {
+                BIGD value;
+                ScopedBigd() : value(bdNew()) {}
+                ~ScopedBigd() {
+                    bdFree(&value);
+                }
+                ScopedBigd(const ScopedBigd&) = delete;
+                ScopedBigd& operator=(const ScopedBigd&) = delete;
+            };
+
+            void setBigdFromUint64(BIGD bigd, uint64_t value) {
+                unsigned char bytes[sizeof(uint64_t)];
+                for (auto i = sizeof(uint64_t); i > 0; i--) {
+                    bytes[i - 1] = static_cast<unsigned char>(value & 0xFF);
+                    value >>= 8;
+                }
+                bdConvFromOctets(bigd, bytes, sizeof(uint64_t));
+            }
+
+            // Lowest 64 bits of the BIGD
+            uint64_t bigdToUint64(BIGD bigd) {
+                unsigned char bytes[sizeof(uint64_t)];
+                bdConvToOctets(bigd, bytes, sizeof(uint64_t));
+                uint64_t value = 0;
+                for (auto byte : bytes) {
+                    value = (value << 8) | byte;
+                }
+                return value;
+            }
+
+            BIGD toBigd(BIGD bigd, uint64_t small, ScopedBigd& storage) {
+                if (bigd != nullptr) {
+                    return bigd;
+                }
+                setBigdFromUint64(storage.value, small);
+                return storage.value;
+            }
+
+            int digitValue(char c, int radix) {
+                if (c >= '0' && c <= '9') {
+                    return c - '0';
+                } else if (radix == 16 && c >= 'a' && c <= 'f') {
+                    return c - 'a' + 10;
+                } else if (radix == 16 && c >= 'A' && c <= 'F') {
+                    return c - 'A' + 10;
+                }
+                return -1;
+            }
+
+            // Parses the digits of str the way bigdigits does (invalid characters are ignored).
+            // Returns false if the value doesn't fit in 64 bits.
+            bool parseUint64(const char *str, int radix, uint64_t &out) {
+                uint64_t value = 0;
+                for (auto c = str; *c; c++) {
+                    auto digit = digitValue(*c, radix);
+                    if (digit < 0) {
+                        continue;
+                    }
+                    if (value > (std::numeric_limits<uint64_t>::max() - digit) / radix) {
+                        return false;
+                    }
+                    value = value * radix + digit;
+                }
+                out = value;
+                return true;
+            }
         }
 
-        BigInt::BigInt(const BigInt& cpy) {
-            _bigd = bdNew();
+        BigInt::BigInt() : _bigd(nullptr), _small(0), _negative(false) {
+        }
+
+        BigInt::BigInt(const BigInt& cpy) : BigInt() {
             _negative = cpy._negative;
-            bdSetEqual(_bigd, cpy._bigd);
+            _small = cpy._small;
+            if (!cpy.isSmall()) {
+                _bigd = bdNew();
+                bdSetEqual(_bigd, cpy._bigd);
+            }
         }
 
         BigInt::BigInt(const void *data, size_t length, bool negative) : BigInt() {
-            bdConvFromOctets(_bigd, reinterpret_cast<const unsigned char *>(data), length);
+            auto bytes = reinterpret_cast<const unsigned char *>(data);
+            while (length > 0 && *bytes == 0) {
+                bytes++;
+                length--;
+            }
+            if (length <= sizeof(uint64_t)) {
+                for (size_t i = 0; i < length; i++) {
+                    _small = (_small << 8) | bytes[i];
+                }
+            } else {
+                _bigd = bdNew();
+                bdConvFromOctets(_bigd, bytes, length);
+            }
             _negative = negative;
         }
 
@@ -73,40 +156,31 @@ namespace ledger {
 
         BigInt::BigInt(int value)
                 : BigInt() {
-            bdSetShort(_bigd, (bdigit_t)std::abs(value));
+            _small = (bdigit_t)std::abs(value);
             if (value < 0) {
                 _negative = true;
             }
         }
 
         BigInt::BigInt(unsigned int value) : BigInt() {
-            bdSetShort(_bigd, (bdigit_t)value);
+            _small = value;
             _negative = false;
         }
 
         BigInt::BigInt(unsigned long long value) : BigInt() {
-            auto bytes = endianness::scalar_type_to_array<unsigned long long>(value, endianness::Endianness::BIG);
-            bdConvFromOctets(_bigd, reinterpret_cast<const unsigned char *>(bytes), sizeof(unsigned long long));
-            std::free(bytes);
+            _small = value;
             _negative = false;
         }
 
         BigInt::BigInt(int64_t value) : BigInt() {
-            auto bytes = endianness::scalar_type_to_array<int64_t >(std::abs(value), endianness::Endianness::BIG);
-            bdConvFromOctets(_bigd, reinterpret_cast<const unsigned char *>(bytes), sizeof(int64_t));
-            std::free(bytes);
-            _negative = value < 0LL;
+            assignI64(value);
         }
 
         BigInt::BigInt(const std::string& str) : BigInt(str, 10)
         {};
 
         BigInt& BigInt::assignI64(int64_t value) {
-            auto bytes = endianness::scalar_type_to_array<int64_t >(std::abs(value), endianness::Endianness::BIG);
-            bdConvFromOctets(_bigd, reinterpret_cast<const unsigned char *>(bytes), sizeof(int64_t));
-            std::free(bytes);
-            _negative = value < 0LL;
-            return *this;
+            return assignScalar<int64_t>(value);
         }
 
         BigInt::BigInt(const std::string &str, int radix) : BigInt() {
@@ -117,9 +191,15 @@ namespace ledger {
                 }
 
                 _negative = str[0] == '-';
-                bdConvFromDecimal(_bigd, str.c_str());
+                if (!parseUint64(str.c_str(), radix, _small)) {
+                    _bigd = bdNew();
+                    bdConvFromDecimal(_bigd, str.c_str());
+                }
             } else if (radix == 16) {
-                bdConvFromHex(_bigd, str.c_str());
+                if (!parseUint64(str.c_str(), radix, _small)) {
+                    _bigd = bdNew();
+                    bdConvFromHex(_bigd, str.c_str());
+                }
             } else {
                 throw std::invalid_argument("Cannot handle radix");
             }
@@ -131,19 +211,110 @@ namespace ledger {
             }
         }
 
+        void BigInt::assignMagnitude(uint64_t magnitude) {
+            if (_bigd != nullptr) {
+                bdFree(&_bigd);
+                _bigd = nullptr;
+            }
+            _small = magnitude;
+        }
+
+        void BigInt::promote() {
+            if (isSmall()) {
+                _bigd = bdNew();
+                setBigdFromUint64(_bigd, _small);
+            }
+        }
+
+        void BigInt::normalize() {
+            if (!isSmall() && bdBitLength(_bigd) <= 64) {
+                _small = bigdToUint64(_bigd);
+                bdFree(&_bigd);
+                _bigd = nullptr;
+            }
+        }
+
+        void BigInt::addMagnitudes(BigInt &result, const BigInt &lhs, const BigInt &rhs) {
+            if (lhs.isSmall() && rhs.isSmall() && lhs._small <= std::numeric_limits<uint64_t>::max() - rhs._small) {
+                result.assignMagnitude(lhs._small + rhs._small);
+                return;
+            }
+            ScopedBigd l, r;
+            result.promote();
+            bdAdd(result._bigd, toBigd(lhs._bigd, lhs._small, l), toBigd(rhs._bigd, rhs._small, r));
+            result.normalize();
+        }
+
+        void BigInt::subtractMagnitudes(BigInt &result, const BigInt &lhs, const BigInt &rhs) {
+            if (lhs.isSmall() && rhs.isSmall() && lhs._small >= rhs._small) {
+                result.assignMagnitude(lhs._small - rhs._small);
+                return;
+            }
+            ScopedBigd l, r;
+            result.promote();
+            bdSubtract(result._bigd, toBigd(lhs._bigd, lhs._small, l), toBigd(rhs._bigd, rhs._small, r));
+            result.normalize();
+        }
+
+        void BigInt::multiplyMagnitudes(BigInt &result, const BigInt &lhs, const BigInt &rhs) {
+            if (lhs.isSmall() && rhs.isSmall() &&
+                (lhs._small == 0 || rhs._small <= std::numeric_limits<uint64_t>::max() / lhs._small)) {
+                result.assignMagnitude(lhs._small * rhs._small);
+                return;
+            }
+            ScopedBigd l, r;
+            result.promote();
+            bdMultiply(result._bigd, toBigd(lhs._bigd, lhs._small, l), toBigd(rhs._bigd, rhs._small, r));
+            result.normalize();
+        }
+
+        void BigInt::divideMagnitudes(BigInt &quotient, BigInt &remainder, const BigInt &lhs, const BigInt &rhs) {
+            if (lhs.isSmall() && rhs.isSmall() && rhs._small != 0) {
+                quotient.assignMagnitude(lhs._small / rhs._small);
+                remainder.assignMagnitude(lhs._small % rhs._small);
+                return;
+            }
+            ScopedBigd l, r;
+            quotient.promote();
+            remainder.promote();
+            bdDivide(quotient._bigd, remainder._bigd, toBigd(lhs._bigd, lhs._small, l), toBigd(rhs._bigd, rhs._small, r));
+            quotient.normalize();
+            remainder.normalize();
+        }
+
+        int BigInt::compareMagnitudes(const BigInt &lhs, const BigInt &rhs) {
+            // Magnitudes stored in a BIGD never fit in 64 bits
+            if (lhs.isSmall() && rhs.isSmall()) {
+                return lhs._small < rhs._small ? -1 : (lhs._small > rhs._small ? 1 : 0);
+            } else if (lhs.isSmall()) {
+                return -1;
+            } else if (rhs.isSmall()) {
+                return 1;
+            }
+            return bdCompare(lhs._bigd, rhs._bigd);
+        }
+
         int BigInt::toInt() const {
-            return bdToShort(_bigd) * (_negative ? -1 : 1);
+            return toUnsignedInt() * (_negative ? -1 : 1);
         }
 
         unsigned int BigInt::toUnsignedInt() const {
+            if (isSmall()) {
+                return static_cast<bdigit_t>(_small);
+            }
             return bdToShort(_bigd);
         }
 
         std::string BigInt::toString() const {
-            size_t nchars = bdConvToDecimal(_bigd, NULL, 0);
-            std::vector<char> s(nchars + 1);
-            bdConvToDecimal(_bigd, s.data(), nchars + 1);
-            auto out = std::string(s.data());
+            std::string out;
+            if (isSmall()) {
+                out = std::to_string(_small);
+            } else {
+                size_t nchars = bdConvToDecimal(_bigd, NULL, 0);
+                std::vector<char> s(nchars + 1);
+                bdConvToDecimal(_bigd, s.data(), nchars + 1);
+                out = std::string(s.data());
+            }
             if (this->isNegative()) {
                 out = "-" + out;
             }
@@ -151,10 +322,21 @@ namespace ledger {
         }
 
         std::string BigInt::toHexString() const {
-            size_t nchars = bdConvToHex(_bigd, NULL, 0);
-            std::vector<char> s(nchars + 1);
-            bdConvToHex(_bigd, s.data(), nchars + 1);
-            auto out = std::string(s.data());
+            std::string out;
+            if (isSmall()) {
+                static const char HEX_DIGITS[] = "0123456789abcdef";
+                auto value = _small;
+                do {
+                    out.push_back(HEX_DIGITS[value & 0xF]);
+                    value >>= 4;
+                } while (value != 0);
+                std::reverse(out.begin(), out.end());
+            } else {
+                size_t nchars = bdConvToHex(_bigd, NULL, 0);
+                std::vector<char> s(nchars + 1);
+                bdConvToHex(_bigd, s.data(), nchars + 1);
+                out = std::string(s.data());
+            }
             if (out.length() % 2 != 0) {
                 out = "0" + out;
             }
@@ -162,6 +344,10 @@ namespace ledger {
         }
 
         unsigned long BigInt::getBitSize() const {
+            if (isSmall()) {
+                auto digits = _small == 0 ? 0 : (_small >> 32 == 0 ? 1 : 2);
+                return digits * sizeof(SimpleInt) * 8;
+            }
             return bdSizeof(_bigd) * sizeof(SimpleInt) * 8;
         }
 
@@ -180,7 +366,7 @@ namespace ledger {
                 return rhs - this->positive();
             }
             BigInt result;
-            bdAdd(result._bigd, this->_bigd, rhs._bigd);
+            addMagnitudes(result, *this, rhs);
             result._negative = rhs.isNegative() && this->isNegative();
             return result;
         }
@@ -194,13 +380,13 @@ namespace ledger {
                 return (rhs - *this).negative();
             }
             BigInt result;
-            bdSubtract(result._bigd, this->_bigd, rhs._bigd);
+            subtractMagnitudes(result, *this, rhs);
             return result;
         }
 
         BigInt BigInt::operator*(const BigInt &rhs) const {
             BigInt result;
-            bdMultiply(result._bigd, this->_bigd, rhs._bigd);
+            multiplyMagnitudes(result, *this, rhs);
             result._negative = this->isNegative() != rhs.isNegative();
             return result;
         }
@@ -208,7 +394,7 @@ namespace ledger {
         BigInt BigInt::operator/(const BigInt &rhs) const {
             BigInt result;
             BigInt remainder;
-            bdDivide(result._bigd, remainder._bigd, this->_bigd, rhs._bigd);
+            divideMagnitudes(result, remainder, *this, rhs);
             result._negative = this->isNegative() != rhs.isNegative();
             return result;
         }
@@ -216,17 +402,24 @@ namespace ledger {
         BigInt BigInt::operator%(const BigInt &rhs) const {
             BigInt result;
             BigInt remainder;
-            bdDivide(result._bigd, remainder._bigd, this->_bigd, rhs._bigd);
+            divideMagnitudes(result, remainder, *this, rhs);
             remainder._negative = this->isNegative();
             return remainder;
         }
 
         BigInt &BigInt::operator++() {
-            if (this->isNegative()) {
+            auto decrement = this->isNegative();
+            if (isSmall() && (decrement ? _small != 0 : _small != std::numeric_limits<uint64_t>::max())) {
+                _small = decrement ? _small - 1 : _small + 1;
+                return *this;
+            }
+            promote();
+            if (decrement) {
                 bdDecrement(_bigd);
             } else {
                 bdIncrement(_bigd);
             }
+            normalize();
             return *this;
         }
 
@@ -237,11 +430,18 @@ namespace ledger {
         }
 
         BigInt &BigInt::operator--() {
-            if (this->isPositive()) {
+            auto decrement = this->isPositive();
+            if (isSmall() && (decrement ? _small != 0 : _small != std::numeric_limits<uint64_t>::max())) {
+                _small = decrement ? _small - 1 : _small + 1;
+                return *this;
+            }
+            promote();
+            if (decrement) {
                 bdDecrement(_bigd);
             } else {
                 bdIncrement(_bigd);
             }
+            normalize();
             return *this;
         }
 
@@ -253,7 +453,14 @@ namespace ledger {
 
         BigInt& BigInt::operator=(const BigInt &a) {
             if (this != &a) {
-                bdSetEqual(_bigd, a._bigd);
+                if (a.isSmall()) {
+                    assignMagnitude(a._small);
+                } else {
+                    if (isSmall()) {
+                        _bigd = bdNew();
+                    }
+                    bdSetEqual(_bigd, a._bigd);
+                }
                 _negative = a._negative;
             }
 
@@ -270,8 +477,10 @@ namespace ledger {
             }
 
             _bigd = a._bigd;
+            _small = a._small;
             _negative = a._negative;
             a._bigd = nullptr;
+            a._small = 0;
 
             return *this;
         }
@@ -285,7 +494,7 @@ namespace ledger {
         }
 
         bool BigInt::isZero() const {
-            return bdIsZero(_bigd) != 0;
+            return isSmall() ? _small == 0 : bdIsZero(_bigd) != 0;
         }
 
         BigInt BigInt::negative() const {
@@ -306,9 +515,9 @@ namespace ledger {
             } else if (this->isPositive() && rhs.isNegative()) {
                 return false;
             } else if (this->isNegative() && rhs.isNegative()) {
-                return bdCompare(this->_bigd, rhs._bigd) == 1;
+                return compareMagnitudes(*this, rhs) == 1;
             }
-            return bdCompare(this->_bigd, rhs._bigd) == -1;
+            return compareMagnitudes(*this, rhs) == -1;
         }
 
         bool BigInt::operator<=(const BigInt &rhs) const {
@@ -317,13 +526,13 @@ namespace ledger {
             } else if (this->isPositive() && rhs.isNegative()) {
                 return false;
             } else if (this->isNegative() && rhs.isNegative()) {
-                return bdCompare(this->_bigd, rhs._bigd) >= 0;
+                return compareMagnitudes(*this, rhs) >= 0;
             }
-            return bdCompare(this->_bigd, rhs._bigd) <= 0;
+            return compareMagnitudes(*this, rhs) <= 0;
         }
 
         bool BigInt::operator==(const BigInt &rhs) const {
-            return this->_negative == rhs._negative && bdCompare(this->_bigd, rhs._bigd) == 0;
+            return this->_negative == rhs._negative && compareMagnitudes(*this, rhs) == 0;
         }
 
         bool BigInt::operator!=(const BigInt &rhs) const {
@@ -340,12 +549,38 @@ namespace ledger {
 
         BigInt BigInt::pow(unsigned short p) const {
             BigInt result;
-            bdPower(result._bigd, _bigd, p);
             result._negative = isNegative() && (p % 2 != 0 || p == 0);
+            if (isSmall()) {
+                uint64_t value = 1;
+                auto fits = true;
+                for (unsigned short i = 0; i < p && fits && value != 0; i++) {
+                    fits = _small == 0 || value <= std::numeric_limits<uint64_t>::max() / _small;
+                    value *= _small;
+                }
+                if (fits) {
+                    result._small = value;
+                    return result;
+                }
+            }
+            ScopedBigd base;
+            result.promote();
+            bdPower(result._bigd, toBigd(_bigd, _small, base), p);
+            result.normalize();
             return result;
         }
 
         std::vector<uint8_t> BigInt::toByteArray() const {
+            if (isSmall()) {
+                // Zero is serialized as a single byte, like bigdigits does
+                std::vector<uint8_t> out;
+                auto value = _small;
+                do {
+                    out.push_back(static_cast<uint8_t>(value & 0xFF));
+                    value >>= 8;
+                } while (value != 0);
+                std::reverse(out.begin(), out.end());
+                return out;
+            }
             size_t nchars = bdConvToOctets(_bigd, NULL, 0);
             std::vector<uint8_t> out = std::vector<uint8_t >(nchars);
             bdConvToOctets(_bigd, reinterpret_cast<unsigned char *>(out.data()), nchars);
@@ -353,21 +588,11 @@ namespace ledger {
         }
 
         uint64_t BigInt::toUint64() const {
-            std::vector<uint8_t> result(sizeof(uint64_t));
-            bdConvToOctets(_bigd, result.data(), sizeof(uint64_t));
-            if (ledger::core::endianness::isSystemLittleEndian()) {
-                std::reverse(result.begin(), result.end());
-            }
-            return reinterpret_cast<uint64_t *>(result.data())[0];
+            return isSmall() ? _small : bigdToUint64(_bigd);
         }
 
         int64_t BigInt::toInt64() const {
-            std::vector<uint8_t> result(sizeof(uint64_t));
-            bdConvToOctets(_bigd, result.data(), sizeof(uint64_t));
-            if (ledger::core::endianness::isSystemLittleEndian()) {
-                std::reverse(result.begin(), result.end());
-            }
-            return reinterpret_cast<int64_t *>(result.data())[0] * (_negative ? -1 : 1);
+            return static_cast<int64_t>(toUint64()) * (_negative ? -1 : 1);
         }
 
         int BigInt::compare(const BigInt &rhs) const {
@@ -376,9 +601,9 @@ namespace ledger {
             } else if (this->isPositive() && rhs.isNegative()) {
                 return 1;
             } else if (this->isNegative() && rhs.isNegative()) {
-                return -bdCompare(this->_bigd, rhs._bigd);
+                return -compareMagnitudes(*this, rhs);
             }
-            return bdCompare(this->_bigd, rhs._bigd);
+            return compareMagnitudes(*this, rhs);
         }
 
         BigInt BigInt::fromHex(const std::string &str) {
@@ -399,8 +624,10 @@ namespace ledger {
 
         BigInt::BigInt(BigInt &&mov) {
             _bigd = mov._bigd;
+            _small = mov._small;
             _negative = mov._negative;
             mov._bigd = nullptr;
+            mov._small = 0;
         }
 
         bool BigInt::all_digits(std::string const& s) {
@@ -41,6 +41,7 @@
 
 #include <string>
 #include <vector>
+#include <cstdint>
 #include <bigd.h>
 #include <memory>
 #include <traits/arithmetic.hpp>
@@ -226,17 +227,16 @@ namespace ledger {
 
             template <typename T, isUnsigned<T> = true>
             BigInt& assignScalar(T value) {
-                auto bytes = endianness::scalar_type_to_array<T>(value, endianness::Endianness::BIG);
-                bdConvFromOctets(_bigd, reinterpret_cast<const unsigned char *>(bytes), sizeof(value));
-                std::free(bytes);
+                static_assert(sizeof(T) <= sizeof(uint64_t), "BigInt::assignScalar only supports types up to 64 bits");
+                assignMagnitude(static_cast<uint64_t>(value));
                 return *this;
             }
 
             template <typename T, isSigned<T> = true>
             BigInt& assignScalar(T value) {
-                auto bytes = endianness::scalar_type_to_array<T>(std::abs(value), endianness::Endianness::BIG);
-                bdConvFromOctets(_bigd, reinterpret_cast<const unsigned char *>(bytes), sizeof(value));
-                std::free(bytes);
+                static_assert(sizeof(T) <= sizeof(uint64_t), "BigInt::assignScalar only supports types up to 64 bits");
+                auto magnitude = static_cast<uint64_t>(static_cast<int64_t>(value));
+                assignMagnitude(value < 0 ? 0 - magnitude : magnitude);
                 _negative = value < 0LL;
                 return *this;
             }
@@ -244,7 +244,23 @@ namespace ledger {
             virtual ~BigInt();
 
         private:
+            bool isSmall() const {
+                return _bigd == nullptr;
+            }
+            void assignMagnitude(uint64_t magnitude);
+            void promote();
+            void normalize();
+
+            static void addMagnitudes(BigInt& result, const BigInt& lhs, const BigInt& rhs);
+            static void subtractMagnitudes(BigInt& result, const BigInt& lhs, const BigInt& rhs);
+            static void multiplyMagnitudes(BigInt& result, const BigInt& lhs, const BigInt& rhs);
+            static void divideMagnitudes(BigInt& quotient, BigInt& remainder, const BigInt& lhs, const BigInt& rhs);
+            static int compareMagnitudes(const BigInt& lhs, const BigInt& rhs);
+
+            // Magnitudes fitting in 64 bits are stored in _small and _bigd is null. _bigd is only
+            // allocated for larger magnitudes, which keeps amounts and fees off the heap.
             BIGD _bigd;
+            uint64_t _small;
             bool _negative;
         };
     }
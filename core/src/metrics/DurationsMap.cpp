@@ -31,38 +31,166 @@
 
 #include "DurationsMap.hpp"
 #include <api/DurationMetrics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <thread>
 
 namespace ledger {
     namespace core {
 
+        constexpr int DurationHistogram::SUB_BUCKET_BITS;
+        constexpr int DurationHistogram::SUB_BUCKETS;
+        constexpr int DurationHistogram::MAX_EXPONENT;
+        constexpr int DurationHistogram::BUCKETS;
+        constexpr int DurationHistogram::SHARDS;
+
+        DurationHistogram::DurationHistogram() {
+            reset();
+        }
+
+        int DurationHistogram::bucketOf(uint64_t micros) {
+            const auto maxValue = (static_cast<uint64_t>(1) << (MAX_EXPONENT + 1)) - 1;
+            micros = std::min(micros, maxValue);
+            if (micros < SUB_BUCKETS) {
+                return static_cast<int>(micros);
+            }
+            int exponent = SUB_BUCKET_BITS;
+            while ((micros >> (exponent + 1)) != 0) {
+                exponent += 1;
+            }
+            const auto subBucket = static_cast<int>((micros >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+            return SUB_BUCKETS + (exponent - SUB_BUCKET_BITS) * SUB_BUCKETS + subBucket;
+        }
+
+        uint64_t DurationHistogram::upperBoundOf(int bucket) {
+            if (bucket < SUB_BUCKETS) {
+                return static_cast<uint64_t>(bucket);
+            }
+            const auto shift = (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+            const auto subBucket = (bucket - SUB_BUCKETS) % SUB_BUCKETS;
+            return (static_cast<uint64_t>(SUB_BUCKETS + subBucket + 1) << shift) - 1;
+        }
+
+        DurationHistogram::Shard& DurationHistogram::currentShard() {
+            return _shards[std::hash<std::thread::id>()(std::this_thread::get_id()) % SHARDS];
+        }
+
+        void DurationHistogram::record(const std::chrono::high_resolution_clock::duration &duration) {
+            const auto micros = static_cast<uint64_t>(std::max<int64_t>(0,
+                    std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+            auto& shard = currentShard();
+            shard.buckets[bucketOf(micros)].fetch_add(1, std::memory_order_relaxed);
+            shard.total.fetch_add(micros, std::memory_order_relaxed);
+            auto max = shard.max.load(std::memory_order_relaxed);
+            while (micros > max && !shard.max.compare_exchange_weak(max, micros, std::memory_order_relaxed));
+        }
+
+        void DurationHistogram::reset() {
+            for (auto& shard : _shards) {
+                for (auto& bucket : shard.buckets) {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+                shard.total.store(0, std::memory_order_relaxed);
+                shard.max.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        api::HistogramMetric DurationHistogram::snapshot() const {
+            std::array<uint64_t, BUCKETS> buckets {};
+            uint64_t count = 0, total = 0, max = 0;
+            for (const auto& shard : _shards) {
+                for (auto i = 0; i < BUCKETS; i++) {
+                    buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+                }
+                total += shard.total.load(std::memory_order_relaxed);
+                max = std::max(max, shard.max.load(std::memory_order_relaxed));
+            }
+            // Count from the buckets so that percentiles stay consistent with concurrent records
+            for (auto bucket : buckets) {
+                count += bucket;
+            }
+            auto percentile = [&] (double p) -> int64_t {
+                if (count == 0) {
+                    return 0;
+                }
+                const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p * count)));
+                uint64_t seen = 0;
+                for (auto i = 0; i < BUCKETS; i++) {
+                    seen += buckets[i];
+                    if (seen >= rank) {
+                        return static_cast<int64_t>(std::min(upperBoundOf(i), max));
+                    }
+                }
+                return static_cast<int64_t>(max);
+            };
+            return api::HistogramMetric(
+                    static_cast<int64_t>(count),
+                    static_cast<int64_t>(total),
+                    percentile(0.50),
+                    percentile(0.95),
+                    percentile(0.99),
+                    static_cast<int64_t>(max)
+            );
+        }
 
         DurationsMap &DurationsMap::getInstance() {
             static DurationsMap instance;
             return instance;
         }
 
+        std::shared_ptr<DurationHistogram> DurationsMap::getHistogram(const std::string &name) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto& histogram = _histograms[name];
+            if (!histogram) {
+                histogram = std::make_shared<DurationHistogram>();
+            }
+            return histogram;
+        }
+
         void
         DurationsMap::record(const std::string &name, const std::chrono::high_resolution_clock::duration &duration) {
-            std::lock_guard<std::mutex> lock(_mutex);
-            auto existing = _metrics.find(name);
-            if (existing != _metrics.end()) {
-                existing->second.count += 1;
-                existing->second.total_ms += static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
-            } else {
-                _metrics[name] = api::DurationMetric(
-                        static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()),
-                        1
+            getHistogram(name)->record(duration);
+        }
+
+        std::unordered_map<std::string, api::DurationMetric> DurationsMap::getMetrics() {
+            std::unordered_map<std::string, api::DurationMetric> metrics;
+            for (const auto& histogram : getHistograms()) {
+                metrics[histogram.first] = api::DurationMetric(
+                        histogram.second.total_us / 1000,
+                        static_cast<int32_t>(histogram.second.count)
                 );
             }
+            return metrics;
+        }
+
+        std::unordered_map<std::string, api::HistogramMetric> DurationsMap::getHistograms() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::unordered_map<std::string, api::HistogramMetric> histograms;
+            for (const auto& histogram : _histograms) {
+                histograms[histogram.first] = histogram.second->snapshot();
+            }
+            return histograms;
         }
 
-        const std::unordered_map<std::string, api::DurationMetric>& DurationsMap::getMetrics() {
-            return _metrics;
+        void DurationsMap::reset() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (const auto& histogram : _histograms) {
+                histogram.second->reset();
+            }
         }
 
         std::unordered_map<std::string, api::DurationMetric> api::DurationMetrics::getAllDurationMetrics() {
             return DurationsMap::getInstance().getMetrics();
         }
 
+        std::unordered_map<std::string, api::HistogramMetric> api::DurationMetrics::getHistogramMetrics() {
+            return DurationsMap::getInstance().getHistograms();
+        }
+
+        void api::DurationMetrics::resetDurationMetrics() {
+            DurationsMap::getInstance().reset();
+        }
+
     }
-}
\ No newline at end of file
+}
@@ -33,22 +33,69 @@
 #define LEDGER_CORE_DURATIONSMAP_HPP
 
 #include <api/DurationMetric.hpp>
+#include <api/HistogramMetric.hpp>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
 namespace ledger {
     namespace core {
+        /**
+         * Log-linear histogram of durations, in microseconds. Each power of two is split in 8 buckets so that
+         * percentiles are reported with less than 12.5% of error. Records are spread over a few shards (one per
+         * recording thread, as long as there are fewer threads than shards) and only use relaxed atomics.
+         */
+        class DurationHistogram {
+        public:
+            static constexpr int SUB_BUCKET_BITS = 3;
+            static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+            // Values above 2^40 us (about 12 days) are clamped in the last bucket
+            static constexpr int MAX_EXPONENT = 40;
+            static constexpr int BUCKETS = SUB_BUCKETS * (MAX_EXPONENT - SUB_BUCKET_BITS + 2);
+            static constexpr int SHARDS = 8;
+
+            DurationHistogram();
+
+            void record(const std::chrono::high_resolution_clock::duration& duration);
+            void reset();
+            api::HistogramMetric snapshot() const;
+
+            static int bucketOf(uint64_t micros);
+            // Largest value falling in the given bucket
+            static uint64_t upperBoundOf(int bucket);
+
+        private:
+            struct Shard {
+                std::array<std::atomic<uint64_t>, BUCKETS> buckets;
+                std::atomic<uint64_t> total;
+                std::atomic<uint64_t> max;
+            };
+            Shard& currentShard();
+
+            std::array<Shard, SHARDS> _shards;
+        };
+
+        /**
+         * Process-wide registry of duration histograms. Metric names are expected to be static (e.g.
+         * "explorer_calls"), dynamic tags such as the account being synchronized only belong to logs.
+         */
         class DurationsMap {
         public:
             void record(const std::string& name,
                     const std::chrono::high_resolution_clock::duration& duration);
-            const std::unordered_map<std::string, api::DurationMetric>& getMetrics();
+            // Histograms are never released, callers may keep the returned pointer to skip the lookup
+            std::shared_ptr<DurationHistogram> getHistogram(const std::string& name);
+            std::unordered_map<std::string, api::DurationMetric> getMetrics();
+            std::unordered_map<std::string, api::HistogramMetric> getHistograms();
+            void reset();
 
             static DurationsMap& getInstance();
 
         private:
-            std::unordered_map<std::string, api::DurationMetric> _metrics;
+            std::unordered_map<std::string, std::shared_ptr<DurationHistogram>> _histograms;
             std::mutex _mutex;
         };
     }
@@ -0,0 +1,196 @@
+/*
+ *
+ * HttpCache
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "HttpCache.hpp"
+#include "../async/Promise.hpp"
+#include "../api/HttpReadBodyResult.hpp"
+#include "../utils/Exception.hpp"
+#include <boost/algorithm/string/predicate.hpp>
+
+namespace ledger {
+    namespace core {
+
+        namespace {
+            // Replays a response kept in memory, the body is returned by the first call to readBody
+            class CachedUrlConnection : public api::HttpUrlConnection {
+            public:
+                explicit CachedUrlConnection(const std::shared_ptr<const HttpCache::Response>& response)
+                    : _response(response), _consumed(false) {}
+
+                int32_t getStatusCode() override {
+                    return _response->statusCode;
+                }
+
+                std::string getStatusText() override {
+                    return _response->statusText;
+                }
+
+                std::unordered_map<std::string, std::string> getHeaders() override {
+                    return _response->headers;
+                }
+
+                api::HttpReadBodyResult readBody() override {
+                    std::vector<uint8_t> body;
+                    if (!_consumed) {
+                        body = _response->body;
+                        _consumed = true;
+                    }
+                    return api::HttpReadBodyResult(std::experimental::nullopt, std::move(body));
+                }
+
+            private:
+                std::shared_ptr<const HttpCache::Response> _response;
+                bool _consumed;
+            };
+
+            const int32_t HTTP_NOT_MODIFIED = 304;
+        }
+
+        const size_t HttpCache::DEFAULT_MAX_ENTRIES = 256;
+
+        HttpCache::HttpCache(size_t maxEntries) : _maxEntries(maxEntries) {}
+
+        Future<std::shared_ptr<api::HttpUrlConnection>> HttpCache::get(const std::string &key,
+                                                                       std::chrono::milliseconds ttl,
+                                                                       const std::shared_ptr<api::ExecutionContext> &context,
+                                                                       const Fetch &fetch) {
+            std::shared_ptr<const Response> stale;
+            Option<std::string> etag;
+            Promise<std::shared_ptr<const Response>> promise;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto entry = _entries.find(key);
+                if (entry != _entries.end()) {
+                    if (Clock::now() < entry->second.expiresAt) {
+                        return Future<std::shared_ptr<api::HttpUrlConnection>>::successful(replay(entry->second.response));
+                    }
+                    stale = entry->second.response;
+                    etag = entry->second.etag;
+                }
+                auto inflight = _inflight.find(key);
+                if (inflight != _inflight.end()) {
+                    return inflight->second.map<std::shared_ptr<api::HttpUrlConnection>>(context, &HttpCache::replay);
+                }
+                _inflight.emplace(key, promise.getFuture());
+            }
+
+            std::unordered_map<std::string, std::string> extraHeaders;
+            if (stale && etag.nonEmpty()) {
+                extraHeaders["If-None-Match"] = etag.getValue();
+            }
+
+            auto self = shared_from_this();
+            auto future = promise.getFuture();
+            // A fetch throwing synchronously fails like a failed request, the in flight entry must not outlive it
+            auto fetched = Try<Future<std::shared_ptr<api::HttpUrlConnection>>>::from([&] () {
+                return fetch(extraHeaders);
+            });
+            auto request = fetched.isSuccess() ? fetched.getValue() : Future<std::shared_ptr<api::HttpUrlConnection>>::failure(fetched.getFailure());
+            request.onComplete(context, [=] (const Try<std::shared_ptr<api::HttpUrlConnection>>& connection) mutable {
+                auto response = Try<std::shared_ptr<const Response>>::from([&] () -> std::shared_ptr<const Response> {
+                    if (connection.isFailure()) {
+                        throw connection.getFailure();
+                    }
+                    if (stale && connection.getValue()->getStatusCode() == HTTP_NOT_MODIFIED) {
+                        self->store(key, stale, etag, Clock::now() + ttl);
+                        return stale;
+                    }
+                    auto fresh = readResponse(connection.getValue());
+                    if (fresh->statusCode >= 200 && fresh->statusCode < 300) {
+                        self->store(key, fresh, getETag(*fresh), Clock::now() + ttl);
+                    }
+                    return fresh;
+                });
+                {
+                    std::lock_guard<std::mutex> lock(self->_lock);
+                    self->_inflight.erase(key);
+                }
+                promise.complete(response);
+            });
+            return future.map<std::shared_ptr<api::HttpUrlConnection>>(context, &HttpCache::replay);
+        }
+
+        void HttpCache::clear() {
+            std::lock_guard<std::mutex> lock(_lock);
+            _entries.clear();
+        }
+
+        size_t HttpCache::size() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _entries.size();
+        }
+
+        std::shared_ptr<const HttpCache::Response> HttpCache::readResponse(const std::shared_ptr<api::HttpUrlConnection> &connection) {
+            auto response = std::make_shared<Response>();
+            response->statusCode = connection->getStatusCode();
+            response->statusText = connection->getStatusText();
+            response->headers = connection->getHeaders();
+            while (true) {
+                auto chunk = connection->readBody();
+                if (chunk.error) {
+                    throw Exception(chunk.error.value().code, chunk.error.value().message,
+                                    std::static_pointer_cast<void>(connection));
+                }
+                if (!chunk.data || chunk.data->empty()) {
+                    break;
+                }
+                response->body.insert(response->body.end(), chunk.data->begin(), chunk.data->end());
+            }
+            return response;
+        }
+
+        Option<std::string> HttpCache::getETag(const Response &response) {
+            for (const auto& header : response.headers) {
+                if (boost::iequals(header.first, "ETag")) {
+                    return header.second;
+                }
+            }
+            return Option<std::string>::NONE;
+        }
+
+        std::shared_ptr<api::HttpUrlConnection> HttpCache::replay(const std::shared_ptr<const Response> &response) {
+            return std::make_shared<CachedUrlConnection>(response);
+        }
+
+        void HttpCache::store(const std::string &key, const std::shared_ptr<const Response> &response,
+                              const Option<std::string> &etag, Clock::time_point expiresAt) {
+            std::lock_guard<std::mutex> lock(_lock);
+            if (_entries.find(key) == _entries.end() && _entries.size() >= _maxEntries) {
+                auto now = Clock::now();
+                for (auto it = _entries.begin(); it != _entries.end();) {
+                    it = it->second.expiresAt <= now && it->second.etag.isEmpty() ? _entries.erase(it) : std::next(it);
+                }
+                if (_entries.size() >= _maxEntries) {
+                    _entries.erase(_entries.begin());
+                }
+            }
+            _entries[key] = Entry{response, etag, expiresAt};
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ *
+ * HttpCache
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_HTTPCACHE_HPP
+#define LEDGER_CORE_HTTPCACHE_HPP
+
+#include "../api/HttpUrlConnection.hpp"
+#include "../api/ExecutionContext.hpp"
+#include "../async/Future.hpp"
+#include "../utils/Option.hpp"
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * Responses of the GET requests which opted in with HttpRequest::cached, shared by all the
+         * requests of an HttpClient.
+         *
+         * Identical requests issued while one is in flight wait for it instead of hitting the network.
+         * A response stays fresh for the TTL given by the request, then it is revalidated with
+         * If-None-Match when the server sent an ETag: a 304 reuses the body already in memory.
+         * Only 2xx responses are stored.
+         */
+        class HttpCache : public std::enable_shared_from_this<HttpCache> {
+        public:
+            using Fetch = std::function<Future<std::shared_ptr<api::HttpUrlConnection>>(
+                const std::unordered_map<std::string, std::string>& extraHeaders)>;
+
+            struct Response {
+                int32_t statusCode;
+                std::string statusText;
+                std::unordered_map<std::string, std::string> headers;
+                std::vector<uint8_t> body;
+            };
+
+            explicit HttpCache(size_t maxEntries = DEFAULT_MAX_ENTRIES);
+
+            /**
+             * Get the response of the request identified by key, calling fetch only when it is neither
+             * fresh in the cache nor already in flight. Every caller gets its own connection replaying
+             * the response, as a body can only be read once.
+             */
+            Future<std::shared_ptr<api::HttpUrlConnection>> get(const std::string& key,
+                                                                std::chrono::milliseconds ttl,
+                                                                const std::shared_ptr<api::ExecutionContext>& context,
+                                                                const Fetch& fetch);
+
+            void clear();
+            size_t size();
+
+            static const size_t DEFAULT_MAX_ENTRIES;
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            struct Entry {
+                std::shared_ptr<const Response> response;
+                Option<std::string> etag;
+                Clock::time_point expiresAt;
+            };
+
+            static std::shared_ptr<const Response> readResponse(const std::shared_ptr<api::HttpUrlConnection>& connection);
+            static Option<std::string> getETag(const Response& response);
+            static std::shared_ptr<api::HttpUrlConnection> replay(const std::shared_ptr<const Response>& response);
+            void store(const std::string& key, const std::shared_ptr<const Response>& response,
+                       const Option<std::string>& etag, Clock::time_point expiresAt);
+
+            std::mutex _lock;
+            size_t _maxEntries;
+            std::unordered_map<std::string, Entry> _entries;
+            std::unordered_map<std::string, Future<std::shared_ptr<const Response>>> _inflight;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_HTTPCACHE_HPP
@@ -29,6 +29,8 @@
  *
  */
 #include "HttpClient.hpp"
+#include <map>
+#include <sstream>
 
 namespace ledger {
     namespace core {
@@ -39,6 +41,8 @@ namespace ledger {
             _client = client;
             _sequentialContext = sequentialContext;
             _threadpoolContext = threadpoolContext;
+            _cache = std::make_shared<HttpCache>();
+            _scheduler = std::make_shared<HttpRequestScheduler>(sequentialContext);
             if (_baseUrl.back() != '/') {
                 _baseUrl += "/";
             }
@@ -104,7 +108,9 @@ namespace ledger {
                     _client,
                     _sequentialContext,
                     _threadpoolContext,
-                    _logger
+                    _logger,
+                    _cache,
+                    _scheduler
             );
         }
 
@@ -112,13 +118,23 @@ namespace ledger {
             _logger = make_option(logger);
         }
 
+        void HttpClient::setRequestScheduler(const std::shared_ptr<HttpRequestScheduler> &scheduler) {
+            _scheduler = scheduler;
+        }
+
+        const std::shared_ptr<HttpRequestScheduler> &HttpClient::getRequestScheduler() const {
+            return _scheduler;
+        }
+
         HttpRequest::HttpRequest(api::HttpMethod method, const std::string &url,
                                  const std::unordered_map<std::string, std::string> &headers,
                                  const std::experimental::optional<std::vector<uint8_t>>& body,
                                  const std::shared_ptr<api::HttpClient> &client,
                                  const std::shared_ptr<api::ExecutionContext> & sequentialContext,
                                  const std::shared_ptr<api::ExecutionContext> & threadpoolContext,
-                                 const Option<std::shared_ptr<spdlog::logger>>& logger) {
+                                 const Option<std::shared_ptr<spdlog::logger>>& logger,
+                                 const std::shared_ptr<HttpCache>& cache,
+                                 const std::shared_ptr<HttpRequestScheduler>& scheduler) {
             _method = method;
             _url = url;
             _headers = headers;
@@ -128,6 +144,9 @@ namespace ledger {
             _threadpoolContext = threadpoolContext;
             _context = _sequentialContext;
             _logger = logger;
+            _cache = cache;
+            _scheduler = scheduler;
+            _priority = HttpRequestPriority::NORMAL;
         }
 
         HttpRequest::ApiRequest::ApiRequest(const std::shared_ptr<const ledger::core::HttpRequest>& self) {
@@ -138,7 +157,64 @@ namespace ledger {
             return std::make_shared<HttpRequest::ApiRequest>(std::make_shared<HttpRequest>(*this));
         }
 
+        HttpRequest HttpRequest::cached(std::chrono::milliseconds ttl) const {
+            HttpRequest request = *this;
+            request._cacheTtl = ttl;
+            return request;
+        }
+
+        HttpRequest HttpRequest::prioritized() const {
+            HttpRequest request = *this;
+            request._priority = HttpRequestPriority::HIGH;
+            return request;
+        }
+
         Future<std::shared_ptr<api::HttpUrlConnection>> HttpRequest::operator()() const {
+            auto response = [&] () {
+                if (!_cache || _cacheTtl.isEmpty() || _method != api::HttpMethod::GET) {
+                    return execute();
+                }
+                auto self = std::make_shared<HttpRequest>(*this);
+                return _cache->get(getCacheKey(), _cacheTtl.getValue(), _context, [self] (const std::unordered_map<std::string, std::string>& extraHeaders) {
+                    HttpRequest request = *self;
+                    for (const auto& header : extraHeaders) {
+                        request._headers[header.first] = header.second;
+                    }
+                    return request.execute();
+                });
+            }();
+            return response.map<std::shared_ptr<api::HttpUrlConnection>>(_context, [] (const std::shared_ptr<api::HttpUrlConnection>& connection) {
+                if (connection->getStatusCode() < 200 || connection->getStatusCode() >= 300) {
+                    throw Exception(HttpRequest::getErrorCode(connection->getStatusCode()), connection->getStatusText(),
+                                    Option<std::shared_ptr<void>>(std::static_pointer_cast<void>(connection)));
+                }
+                return connection;
+            });
+        }
+
+        std::string HttpRequest::getCacheKey() const {
+            std::map<std::string, std::string> headers(_headers.begin(), _headers.end());
+            std::stringstream key;
+            key << _url;
+            for (const auto& header : headers) {
+                key << '\n' << header.first << ": " << header.second;
+            }
+            return key.str();
+        }
+
+        Future<std::shared_ptr<api::HttpUrlConnection>> HttpRequest::execute() const {
+            if (!_scheduler) {
+                return send();
+            }
+            // POST is the only method which is not idempotent, it is never sent twice
+            auto idempotent = _method != api::HttpMethod::POST;
+            auto self = std::make_shared<HttpRequest>(*this);
+            return _scheduler->schedule(_url, _priority, idempotent, [self] () {
+                return self->send();
+            });
+        }
+
+        Future<std::shared_ptr<api::HttpUrlConnection>> HttpRequest::send() const {
             auto request = std::dynamic_pointer_cast<ApiRequest>(toApiRequest());
             _client->execute(request);
             _logger.foreach([&] (const std::shared_ptr<spdlog::logger>& logger) {
@@ -149,10 +225,6 @@ namespace ledger {
                 logger.foreach([&] (const std::shared_ptr<spdlog::logger>& l) {
                     l->info("{} {} - {} {}", api::to_string(request->getMethod()), request->getUrl(),  connection->getStatusCode(), connection->getStatusText());
                 });
-                if (connection->getStatusCode() < 200 || connection->getStatusCode() >= 300) {
-                    throw Exception(HttpRequest::getErrorCode(connection->getStatusCode()), connection->getStatusText(),
-                                    Option<std::shared_ptr<void>>(std::static_pointer_cast<void>(connection)));
-                }
                 return connection;
             });
         }
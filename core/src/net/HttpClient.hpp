@@ -40,10 +40,13 @@
 #include "../utils/optional.hpp"
 #include <unordered_map>
 #include <memory>
+#include <chrono>
 #include "../async/Future.hpp"
 #include "../async/Promise.hpp"
 #include "../utils/Either.hpp"
 #include "HttpUrlConnectionInputStream.hpp"
+#include "HttpCache.hpp"
+#include "HttpRequestScheduler.hpp"
 
 #include "../debug/logger.hpp"
 #include "../utils/Option.hpp"
@@ -68,9 +71,23 @@ namespace ledger {
                         const std::shared_ptr<api::HttpClient> &client,
                         const std::shared_ptr<api::ExecutionContext> & sequentialContext,
                         const std::shared_ptr<api::ExecutionContext>& threadpoolContext,
-                        const Option<std::shared_ptr<spdlog::logger>>& logger);
+                        const Option<std::shared_ptr<spdlog::logger>>& logger,
+                        const std::shared_ptr<HttpCache>& cache = nullptr,
+                        const std::shared_ptr<HttpRequestScheduler>& scheduler = nullptr);
             Future<std::shared_ptr<api::HttpUrlConnection>> operator()() const;
 
+            /**
+             * Opt in the response cache of the client (GET requests only): identical requests in flight
+             * share the same response, which is then reused for ttl and revalidated with its ETag.
+             */
+            HttpRequest cached(std::chrono::milliseconds ttl) const;
+
+            /**
+             * Send the request ahead of the normal priority ones waiting for the same host (see
+             * HttpRequestScheduler).
+             */
+            HttpRequest prioritized() const;
+
             template <typename Success, typename Failure, typename Handler>
             Future<Either<Failure, std::shared_ptr<Success>>> json(Handler handler, bool multiThread = false) const {
                 _context = (multiThread ? _threadpoolContext : _sequentialContext);
@@ -105,6 +122,14 @@ namespace ledger {
             std::shared_ptr<api::ExecutionContext> _threadpoolContext;
             mutable std::shared_ptr<api::ExecutionContext> _context;
             Option<std::shared_ptr<spdlog::logger>> _logger;
+            std::shared_ptr<HttpCache> _cache;
+            Option<std::chrono::milliseconds> _cacheTtl;
+            std::shared_ptr<HttpRequestScheduler> _scheduler;
+            HttpRequestPriority _priority;
+
+            Future<std::shared_ptr<api::HttpUrlConnection>> execute() const;
+            Future<std::shared_ptr<api::HttpUrlConnection>> send() const;
+            std::string getCacheKey() const;
 
             static api::ErrorCode getErrorCode(int32_t statusCode) {
                 return statusCode >= 200 && statusCode < 300 ? api::ErrorCode::FUTURE_WAS_SUCCESSFULL :
@@ -163,6 +188,8 @@ namespace ledger {
             HttpClient& addHeader(const std::string& key, const std::string& value);
             HttpClient& removeHeader(const std::string& key);
             void setLogger(const std::shared_ptr<spdlog::logger>& logger);
+            void setRequestScheduler(const std::shared_ptr<HttpRequestScheduler>& scheduler);
+            const std::shared_ptr<HttpRequestScheduler>& getRequestScheduler() const;
 
         private:
             HttpRequest createRequest(api::HttpMethod method,
@@ -178,6 +205,8 @@ namespace ledger {
             std::shared_ptr<api::ExecutionContext> _threadpoolContext;
             std::unordered_map<std::string, std::string> _headers;
             Option<std::shared_ptr<spdlog::logger>> _logger;
+            std::shared_ptr<HttpCache> _cache;
+            std::shared_ptr<HttpRequestScheduler> _scheduler;
         };
     }
 }
@@ -0,0 +1,242 @@
+/*
+ *
+ * HttpRequestScheduler
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "HttpRequestScheduler.hpp"
+#include "../utils/LambdaRunnable.hpp"
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/lexical_cast.hpp>
+
+namespace ledger {
+    namespace core {
+
+        HttpRequestScheduler::Parameters::Parameters()
+            : maxConcurrentRequestsPerHost(16),
+              maxRetries(3),
+              retryBaseDelay(250),
+              retryMaxDelay(10000) {}
+
+        HttpRequestScheduler::HttpRequestScheduler(const std::shared_ptr<api::ExecutionContext> &context,
+                                                   const Parameters &parameters)
+            : _context(context), _parameters(parameters), _metrics(), _random(std::random_device()()) {
+            _parameters.maxConcurrentRequestsPerHost = std::max(_parameters.maxConcurrentRequestsPerHost, 1);
+        }
+
+        Future<std::shared_ptr<api::HttpUrlConnection>> HttpRequestScheduler::schedule(const std::string &url,
+                                                                                       HttpRequestPriority priority,
+                                                                                       bool idempotent,
+                                                                                       const Send &send) {
+            auto job = std::make_shared<Job>();
+            job->host = getHost(url);
+            job->priority = priority;
+            job->idempotent = idempotent;
+            job->send = send;
+            job->attempts = 0;
+            auto future = job->promise.getFuture();
+            enqueue(job, false);
+            return future;
+        }
+
+        HttpRequestScheduler::Metrics HttpRequestScheduler::getMetrics() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _metrics;
+        }
+
+        int32_t HttpRequestScheduler::getConcurrencyLimit(const std::string &host) {
+            std::lock_guard<std::mutex> lock(_lock);
+            return getHostState(host).limit;
+        }
+
+        std::string HttpRequestScheduler::getHost(const std::string &url) {
+            auto begin = url.find("://");
+            begin = begin == std::string::npos ? 0 : begin + 3;
+            auto end = url.find_first_of("/?#", begin);
+            return url.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+        }
+
+        void HttpRequestScheduler::enqueue(const std::shared_ptr<Job> &job, bool retry) {
+            std::vector<std::shared_ptr<Job>> ready;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto& host = getHostState(job->host);
+                auto& queue = job->priority == HttpRequestPriority::HIGH ? host.high : host.normal;
+                job->enqueuedAt = Clock::now();
+                // A retried request already waited its turn once
+                if (retry) {
+                    queue.push_front(job);
+                } else {
+                    queue.push_back(job);
+                }
+                ready = dequeue(host);
+            }
+            for (const auto& next : ready) {
+                start(next);
+            }
+        }
+
+        std::vector<std::shared_ptr<HttpRequestScheduler::Job>> HttpRequestScheduler::dequeue(Host &host) {
+            std::vector<std::shared_ptr<Job>> ready;
+            auto now = Clock::now();
+            while (host.inFlight < host.limit && (!host.high.empty() || !host.normal.empty())) {
+                auto& queue = host.high.empty() ? host.normal : host.high;
+                auto job = queue.front();
+                queue.pop_front();
+                host.inFlight += 1;
+                job->startedAt = now;
+                auto waited = std::chrono::duration_cast<std::chrono::microseconds>(now - job->enqueuedAt);
+                _metrics.requests += 1;
+                _metrics.queueTime += waited;
+                _metrics.maxQueueTime = std::max(_metrics.maxQueueTime, waited);
+                ready.push_back(job);
+            }
+            return ready;
+        }
+
+        void HttpRequestScheduler::start(const std::shared_ptr<Job> &job) {
+            auto self = shared_from_this();
+            auto response = Try<Future<std::shared_ptr<api::HttpUrlConnection>>>::from([&] () {
+                return job->send();
+            });
+            if (response.isFailure()) {
+                Try<std::shared_ptr<api::HttpUrlConnection>> failure;
+                failure.fail(response.getFailure());
+                onResponse(job, failure);
+                return;
+            }
+            auto future = response.getValue();
+            future.onComplete(ImmediateExecutionContext::INSTANCE, [self, job] (const Try<std::shared_ptr<api::HttpUrlConnection>>& result) {
+                self->onResponse(job, result);
+            });
+        }
+
+        void HttpRequestScheduler::onResponse(const std::shared_ptr<Job> &job,
+                                              const Try<std::shared_ptr<api::HttpUrlConnection>> &response) {
+            std::vector<std::shared_ptr<Job>> ready;
+            bool retry = false;
+            std::chrono::milliseconds retryDelay(0);
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto& host = getHostState(job->host);
+                host.inFlight -= 1;
+                _metrics.networkTime += std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - job->startedAt);
+
+                if (isThrottled(response)) {
+                    host.limit = std::max(host.limit / 2, 1);
+                } else if (isSuccessful(response) && host.limit < _parameters.maxConcurrentRequestsPerHost) {
+                    host.limit += 1;
+                }
+
+                retry = job->idempotent && job->attempts < _parameters.maxRetries && isRetryable(response);
+                if (retry) {
+                    job->attempts += 1;
+                    _metrics.retries += 1;
+                    retryDelay = getRetryDelay(job->attempts, response);
+                }
+                ready = dequeue(host);
+            }
+            for (const auto& next : ready) {
+                start(next);
+            }
+
+            if (!retry) {
+                job->promise.complete(response);
+            } else if (retryDelay.count() == 0) {
+                enqueue(job, true);
+            } else {
+                auto self = shared_from_this();
+                _context->delay(make_runnable([self, job] () {
+                    self->enqueue(job, true);
+                }), retryDelay.count());
+            }
+        }
+
+        HttpRequestScheduler::Host &HttpRequestScheduler::getHostState(const std::string &host) {
+            auto it = _hosts.find(host);
+            if (it == _hosts.end()) {
+                it = _hosts.emplace(host, Host()).first;
+                it->second.inFlight = 0;
+                it->second.limit = _parameters.maxConcurrentRequestsPerHost;
+            }
+            return it->second;
+        }
+
+        std::chrono::milliseconds HttpRequestScheduler::getRetryDelay(int32_t attempts,
+                                                                      const Try<std::shared_ptr<api::HttpUrlConnection>> &response) {
+            // Honor the delay asked by the server, in seconds (the HTTP date form is not supported)
+            if (response.isSuccess()) {
+                for (const auto& header : response.getValue()->getHeaders()) {
+                    int64_t seconds;
+                    if (boost::iequals(header.first, "Retry-After") &&
+                        boost::conversion::try_lexical_convert(header.second, seconds) && seconds >= 0) {
+                        return std::min(std::chrono::milliseconds(seconds * 1000), _parameters.retryMaxDelay);
+                    }
+                }
+            }
+            // Full jitter: anywhere between 0 and the exponential bound, so that the clients throttled
+            // together do not come back together
+            auto bound = _parameters.retryBaseDelay.count() << std::min(attempts - 1, 20);
+            bound = std::min<int64_t>(bound, _parameters.retryMaxDelay.count());
+            std::uniform_int_distribution<int64_t> distribution(0, std::max<int64_t>(bound, 0));
+            return std::chrono::milliseconds(distribution(_random));
+        }
+
+        bool HttpRequestScheduler::isRetryable(const Try<std::shared_ptr<api::HttpUrlConnection>> &response) {
+            if (response.isFailure()) {
+                switch (response.getFailure().getErrorCode()) {
+                    case api::ErrorCode::NO_INTERNET_CONNECTIVITY:
+                    case api::ErrorCode::UNABLE_TO_RESOLVE_HOST:
+                    case api::ErrorCode::UNABLE_TO_CONNECT_TO_HOST:
+                    case api::ErrorCode::HTTP_TIMEOUT:
+                        return true;
+                    default:
+                        return false;
+                }
+            }
+            switch (response.getValue()->getStatusCode()) {
+                case 429:
+                case 500:
+                case 502:
+                case 503:
+                case 504:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        bool HttpRequestScheduler::isSuccessful(const Try<std::shared_ptr<api::HttpUrlConnection>> &response) {
+            return response.isSuccess() &&
+                   response.getValue()->getStatusCode() >= 200 && response.getValue()->getStatusCode() < 300;
+        }
+
+        bool HttpRequestScheduler::isThrottled(const Try<std::shared_ptr<api::HttpUrlConnection>> &response) {
+            return response.isSuccess() &&
+                   (response.getValue()->getStatusCode() == 429 || response.getValue()->getStatusCode() == 503);
+        }
+    }
+}
@@ -0,0 +1,144 @@
+/*
+ *
+ * HttpRequestScheduler
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_HTTPREQUESTSCHEDULER_HPP
+#define LEDGER_CORE_HTTPREQUESTSCHEDULER_HPP
+
+#include "../api/HttpUrlConnection.hpp"
+#include "../api/ExecutionContext.hpp"
+#include "../async/Future.hpp"
+#include "../async/Promise.hpp"
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+
+namespace ledger {
+    namespace core {
+
+        enum class HttpRequestPriority {
+            // Requests a user is waiting for (e.g. broadcasts), they go ahead of the queued ones
+            HIGH,
+            NORMAL
+        };
+
+        /**
+         * Queues the requests of an HttpClient so that at most maxConcurrentRequestsPerHost are in flight
+         * for a given host, high priority ones first.
+         *
+         * Idempotent requests failing with a network error or answered with 429, 500, 502, 503 or 504
+         * are sent again after a jittered exponential delay (or the Retry-After of the response). A 429
+         * or a 503 also halves the concurrency of the host, which grows back by one with every successful
+         * response.
+         */
+        class HttpRequestScheduler : public std::enable_shared_from_this<HttpRequestScheduler> {
+        public:
+            using Send = std::function<Future<std::shared_ptr<api::HttpUrlConnection>>()>;
+
+            struct Parameters {
+                int32_t maxConcurrentRequestsPerHost;
+                int32_t maxRetries;
+                std::chrono::milliseconds retryBaseDelay;
+                std::chrono::milliseconds retryMaxDelay;
+
+                Parameters();
+            };
+
+            struct Metrics {
+                // Requests sent to the network, retries included
+                uint64_t requests;
+                uint64_t retries;
+                // Time spent waiting for a slot of the host, then waiting for the response
+                std::chrono::microseconds queueTime;
+                std::chrono::microseconds networkTime;
+                std::chrono::microseconds maxQueueTime;
+            };
+
+            /**
+             * @param context Context used to wait before retrying, responses are handled on the thread
+             * completing them
+             */
+            HttpRequestScheduler(const std::shared_ptr<api::ExecutionContext>& context,
+                                 const Parameters& parameters = Parameters());
+
+            Future<std::shared_ptr<api::HttpUrlConnection>> schedule(const std::string& url,
+                                                                     HttpRequestPriority priority,
+                                                                     bool idempotent,
+                                                                     const Send& send);
+
+            Metrics getMetrics();
+            int32_t getConcurrencyLimit(const std::string& host);
+
+            static std::string getHost(const std::string& url);
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            struct Job {
+                std::string host;
+                HttpRequestPriority priority;
+                bool idempotent;
+                Send send;
+                int32_t attempts;
+                Clock::time_point enqueuedAt;
+                Clock::time_point startedAt;
+                Promise<std::shared_ptr<api::HttpUrlConnection>> promise;
+            };
+
+            struct Host {
+                std::deque<std::shared_ptr<Job>> high;
+                std::deque<std::shared_ptr<Job>> normal;
+                int32_t inFlight;
+                int32_t limit;
+            };
+
+            void enqueue(const std::shared_ptr<Job>& job, bool retry);
+            std::vector<std::shared_ptr<Job>> dequeue(Host& host);
+            void start(const std::shared_ptr<Job>& job);
+            void onResponse(const std::shared_ptr<Job>& job, const Try<std::shared_ptr<api::HttpUrlConnection>>& response);
+            Host& getHostState(const std::string& host);
+            std::chrono::milliseconds getRetryDelay(int32_t attempts, const Try<std::shared_ptr<api::HttpUrlConnection>>& response);
+
+            static bool isRetryable(const Try<std::shared_ptr<api::HttpUrlConnection>>& response);
+            static bool isSuccessful(const Try<std::shared_ptr<api::HttpUrlConnection>>& response);
+            static bool isThrottled(const Try<std::shared_ptr<api::HttpUrlConnection>>& response);
+
+            std::shared_ptr<api::ExecutionContext> _context;
+            Parameters _parameters;
+            std::mutex _lock;
+            std::unordered_map<std::string, Host> _hosts;
+            Metrics _metrics;
+            std::mt19937 _random;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_HTTPREQUESTSCHEDULER_HPP
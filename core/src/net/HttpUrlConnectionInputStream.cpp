@@ -40,28 +40,26 @@ namespace ledger {
             _connection = connection;
             _index = 0;
             _offset = 0;
+            _eof = false;
             refill();
         }
 
         HttpUrlConnectionInputStream::Ch HttpUrlConnectionInputStream::Peek() {
-            if (_index >= _buffer.size())
+            if (_index >= _buffer.size() && !refill())
                 return '\0';
-            else
-                return (Ch)_buffer[_index];
+            return (Ch)_buffer[_index];
         }
 
         HttpUrlConnectionInputStream::Ch HttpUrlConnectionInputStream::Take() {
-            if (_index >= _buffer.size())
+            if (_index >= _buffer.size() && !refill())
                 return '\0';
-            else {
-                auto c = (Ch) _buffer[_index];
-                _index += 1;
-                return c;
-            }
+            auto c = (Ch) _buffer[_index];
+            _index += 1;
+            return c;
         }
 
         size_t HttpUrlConnectionInputStream::Tell() const {
-            return (size_t)(_index + _offset);
+            return _index + _offset;
         }
 
         HttpUrlConnectionInputStream::Ch *HttpUrlConnectionInputStream::PutBegin() {
@@ -82,8 +80,9 @@ namespace ledger {
             return 0;
         }
 
-        void HttpUrlConnectionInputStream::refill() {
-            if (_index >= _buffer.size()) {
+        bool HttpUrlConnectionInputStream::refill() {
+            // The body is over once readBody returned an empty chunk, never ask for more after that
+            while (!_eof && _index >= _buffer.size()) {
                 auto result = _connection->readBody();
                 if (result.error) {
                     throw Exception(result.error.value().code,
@@ -91,10 +90,17 @@ namespace ledger {
                                     std::static_pointer_cast<void>(_connection)
                     );
                 }
-                _index = 0;
                 _offset += _buffer.size();
-               _buffer = result.data.value();
+                _index = 0;
+                if (result.data && !result.data->empty()) {
+                    _buffer = std::move(result.data.value());
+                } else {
+                    _buffer.clear();
+                    _buffer.shrink_to_fit();
+                    _eof = true;
+                }
             }
+            return _index < _buffer.size();
         }
     }
 }
\ No newline at end of file
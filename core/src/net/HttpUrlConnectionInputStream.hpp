@@ -37,6 +37,11 @@
 
 namespace ledger {
  namespace core {
+     /**
+      * rapidjson input stream reading the body of a connection chunk by chunk. Chunks returned by
+      * readBody are moved into the stream (never copied) and released as soon as the parser consumed
+      * them, so at most one chunk of the body is held in memory while parsing.
+      */
      class HttpUrlConnectionInputStream {
      public:
          typedef char Ch;
@@ -50,13 +55,14 @@ namespace ledger {
          size_t PutEnd(Ch*);
 
      private:
-         inline void refill();
+         inline bool refill();
 
      private:
          std::shared_ptr<api::HttpUrlConnection> _connection;
          std::vector<uint8_t> _buffer;
-         off_t _index;
-         off_t _offset;
+         size_t _index;
+         size_t _offset;
+         bool _eof;
      };
  }
 }
@@ -0,0 +1,524 @@
+/*
+ *
+ * FilePreferencesBackend
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "FilePreferencesBackend.hpp"
+#include "../api/PreferencesChangeType.hpp"
+#include "../api/RandomNumberGenerator.hpp"
+#include "../bytes/BytesReader.h"
+#include "../bytes/BytesWriter.h"
+#include "../crypto/SHA256.hpp"
+#include "../utils/Exception.hpp"
+#include "../utils/LambdaRunnable.hpp"
+#include "../utils/hex.h"
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+#include <stdexcept>
+
+namespace ledger {
+    namespace core {
+
+        namespace {
+            const std::string FILE_MAGIC("LPRF\x01", 5);
+            const size_t FRAME_SIZE_LENGTH = 4;
+            const size_t FRAME_CHECKSUM_LENGTH = 4;
+
+            // Records stored in a frame payload
+            enum RecordType : uint8_t {
+                RECORD_PUT = 0,
+                RECORD_DELETE = 1,
+                // Encryption salt (empty when the file is not encrypted), the key is empty
+                RECORD_SALT = 2,
+            };
+
+            std::vector<uint8_t> toBytes(const std::string& str) {
+                return std::vector<uint8_t>(str.begin(), str.end());
+            }
+
+            // [LE payload size][payload][first 4 bytes of SHA256(payload)]
+            void encodeFrame(const std::vector<uint8_t>& payload, std::vector<uint8_t>& out) {
+                const auto size = static_cast<uint32_t>(payload.size());
+                for (size_t i = 0; i < FRAME_SIZE_LENGTH; i++) {
+                    out.push_back(static_cast<uint8_t>(size >> (8 * i)));
+                }
+                out.insert(out.end(), payload.begin(), payload.end());
+                const auto checksum = SHA256::bytesToBytesHash(payload);
+                out.insert(out.end(), checksum.begin(), checksum.begin() + FRAME_CHECKSUM_LENGTH);
+            }
+        }
+
+        std::shared_ptr<FilePreferencesBackend>
+        FilePreferencesBackend::open(const std::string& path,
+                                     const std::shared_ptr<api::ExecutionContext>& context,
+                                     std::chrono::milliseconds commitWindow) {
+            std::shared_ptr<FilePreferencesBackend> backend(new FilePreferencesBackend(path, context, commitWindow));
+            backend->load();
+            return backend;
+        }
+
+        FilePreferencesBackend::FilePreferencesBackend(const std::string& path,
+                                                       const std::shared_ptr<api::ExecutionContext>& context,
+                                                       std::chrono::milliseconds commitWindow)
+            : _path(path), _context(context), _commitWindow(commitWindow), _flushScheduled(false), _liveSize(0),
+              _logSize(0), _rewriteNeeded(false) {
+        }
+
+        FilePreferencesBackend::~FilePreferencesBackend() {
+            try {
+                flush();
+            } catch (...) {
+                // Nothing to do, the file is left as it was before the pending changes
+            }
+        }
+
+        void FilePreferencesBackend::load() {
+            std::vector<uint8_t> content;
+            {
+                std::ifstream input(_path, std::ios::binary);
+                if (input.is_open()) {
+                    content.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+                }
+            }
+
+            if (content.empty()) {
+                rewrite();
+                return;
+            }
+            if (content.size() < FILE_MAGIC.size() ||
+                !std::equal(FILE_MAGIC.begin(), FILE_MAGIC.end(), content.begin())) {
+                throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Invalid preferences file {}", _path);
+            }
+
+            // Replay the frames, stopping at the first torn or corrupted one
+            auto offset = FILE_MAGIC.size();
+            while (content.size() - offset >= FRAME_SIZE_LENGTH + FRAME_CHECKSUM_LENGTH) {
+                size_t size = 0;
+                for (size_t i = 0; i < FRAME_SIZE_LENGTH; i++) {
+                    size |= static_cast<size_t>(content[offset + i]) << (8 * i);
+                }
+                if (content.size() - offset - FRAME_SIZE_LENGTH - FRAME_CHECKSUM_LENGTH < size) {
+                    break;
+                }
+                auto begin = content.begin() + offset + FRAME_SIZE_LENGTH;
+                std::vector<uint8_t> payload(begin, begin + size);
+                auto checksum = SHA256::bytesToBytesHash(payload);
+                if (!std::equal(checksum.begin(), checksum.begin() + FRAME_CHECKSUM_LENGTH, begin + size) ||
+                    !applyFrame(payload)) {
+                    break;
+                }
+                offset += FRAME_SIZE_LENGTH + size + FRAME_CHECKSUM_LENGTH;
+            }
+
+            if (offset != content.size()) {
+                // Drop the garbage so that the next frames are not appended after it
+                rewrite();
+                return;
+            }
+            _file.open(_path, std::ios::binary | std::ios::app);
+            if (!_file.is_open()) {
+                throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Unable to open preferences file {}", _path);
+            }
+            _logSize = content.size();
+        }
+
+        bool FilePreferencesBackend::applyFrame(const std::vector<uint8_t>& payload) {
+            struct Record {
+                uint8_t type;
+                std::string key;
+                std::vector<uint8_t> value;
+            };
+            // Decode the whole frame first, a frame is either fully applied or not at all
+            std::vector<Record> records;
+            try {
+                BytesReader reader(payload);
+                auto readBytes = [&reader] () {
+                    auto length = reader.readNextVarInt();
+                    if (length > reader.available()) {
+                        throw std::out_of_range("Truncated preferences record");
+                    }
+                    return reader.read(length);
+                };
+                while (reader.hasNext()) {
+                    Record record;
+                    record.type = reader.readNextByte();
+                    auto key = readBytes();
+                    record.key.assign(key.begin(), key.end());
+                    if (record.type == RECORD_PUT || record.type == RECORD_SALT) {
+                        record.value = readBytes();
+                    } else if (record.type != RECORD_DELETE) {
+                        return false;
+                    }
+                    records.push_back(std::move(record));
+                }
+            } catch (...) {
+                return false;
+            }
+
+            for (auto& record : records) {
+                if (record.type == RECORD_SALT) {
+                    _salt.assign(record.value.begin(), record.value.end());
+                    continue;
+                }
+                auto it = _values.find(record.key);
+                if (it != _values.end()) {
+                    _liveSize -= it->first.size() + it->second.size();
+                    _values.erase(it);
+                }
+                if (record.type == RECORD_PUT) {
+                    _liveSize += record.key.size() + record.value.size();
+                    _values.emplace(std::move(record.key), std::move(record.value));
+                }
+            }
+            return true;
+        }
+
+        std::experimental::optional<std::vector<uint8_t>> FilePreferencesBackend::get(const std::vector<uint8_t>& key) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            const std::string k(key.begin(), key.end());
+            auto it = _values.find(k);
+            if (it == _values.end()) {
+                return std::experimental::nullopt;
+            }
+            if (_cipher.isEmpty()) {
+                return it->second;
+            }
+            auto cached = _cache.find(k);
+            if (cached != _cache.end()) {
+                return cached->second;
+            }
+            auto value = decrypt(*_cipher, it->second);
+            if (_cache.size() >= MAX_CACHED_VALUES) {
+                _cache.clear();
+            }
+            _cache.emplace(k, value);
+            return value;
+        }
+
+        bool FilePreferencesBackend::commit(const std::vector<api::PreferencesChange>& changes) {
+            bool flushNow = false;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (const auto& change : changes) {
+                    const std::string key(change.key.begin(), change.key.end());
+                    auto it = _values.find(key);
+                    if (it != _values.end()) {
+                        _liveSize -= it->first.size() + it->second.size();
+                    }
+                    if (change.type == api::PreferencesChangeType::PUT_TYPE) {
+                        auto stored = _cipher.isEmpty() ? change.value : encrypt(*_cipher, change.value);
+                        appendRecord(RECORD_PUT, key, stored);
+                        _liveSize += key.size() + stored.size();
+                        if (_cipher.nonEmpty()) {
+                            _cache[key] = change.value;
+                        }
+                        _values[key] = std::move(stored);
+                    } else {
+                        appendRecord(RECORD_DELETE, key, {});
+                        _cache.erase(key);
+                        if (it != _values.end()) {
+                            _values.erase(it);
+                        }
+                    }
+                }
+                if (_commitWindow.count() <= 0 || !_context || _pending.size() >= MAX_PENDING_SIZE) {
+                    flushNow = true;
+                } else if (!_flushScheduled) {
+                    _flushScheduled = true;
+                    scheduleFlush();
+                }
+            }
+            if (flushNow) {
+                try {
+                    flush();
+                } catch (...) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void FilePreferencesBackend::appendRecord(uint8_t type, const std::string& key, const std::vector<uint8_t>& value) {
+            BytesWriter writer;
+            writer.writeByte(type);
+            writer.writeVarInt(key.size());
+            writer.writeString(key);
+            if (type != RECORD_DELETE) {
+                writer.writeVarInt(value.size());
+                writer.writeByteArray(value);
+            }
+            auto record = writer.toByteArray();
+            _pending.insert(_pending.end(), record.begin(), record.end());
+        }
+
+        void FilePreferencesBackend::scheduleFlush() {
+            std::weak_ptr<FilePreferencesBackend> weakSelf = shared_from_this();
+            _context->delay(make_runnable([weakSelf] () {
+                auto self = weakSelf.lock();
+                if (!self) {
+                    return;
+                }
+                try {
+                    self->flush();
+                } catch (...) {
+                    // The changes are kept pending and written by the next flush
+                }
+            }), _commitWindow.count());
+        }
+
+        void FilePreferencesBackend::flush() {
+            std::lock_guard<std::mutex> fileLock(_fileMutex);
+            std::vector<uint8_t> payload;
+            size_t liveSize;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                payload.swap(_pending);
+                _flushScheduled = false;
+                liveSize = _liveSize;
+            }
+            if (payload.empty()) {
+                return;
+            }
+            try {
+                if (_rewriteNeeded) {
+                    // The last write may have left part of a frame on disk, a frame appended after it
+                    // would never be loaded. The snapshot holds the payload as well.
+                    rewrite();
+                    return;
+                }
+                writeFrame(payload);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                payload.insert(payload.end(), _pending.begin(), _pending.end());
+                _pending.swap(payload);
+                throw;
+            }
+            if (_logSize > COMPACTION_MIN_SIZE && _logSize > COMPACTION_RATIO * liveSize) {
+                rewrite();
+            }
+        }
+
+        void FilePreferencesBackend::writeFrame(const std::vector<uint8_t>& payload) {
+            std::vector<uint8_t> frame;
+            frame.reserve(FRAME_SIZE_LENGTH + payload.size() + FRAME_CHECKSUM_LENGTH);
+            encodeFrame(payload, frame);
+            _file.write(reinterpret_cast<const char*>(frame.data()), frame.size());
+            _file.flush();
+            if (!_file.good()) {
+                _file.clear();
+                _rewriteNeeded = true;
+                throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Unable to write preferences file {}", _path);
+            }
+            _logSize += frame.size();
+        }
+
+        void FilePreferencesBackend::compact() {
+            std::lock_guard<std::mutex> fileLock(_fileMutex);
+            rewrite();
+        }
+
+        std::vector<uint8_t> FilePreferencesBackend::snapshot() const {
+            BytesWriter writer;
+            if (!_salt.empty()) {
+                writer.writeByte(RECORD_SALT);
+                writer.writeVarInt(0);
+                writer.writeVarInt(_salt.size());
+                writer.writeString(_salt);
+            }
+            for (const auto& entry : _values) {
+                writer.writeByte(RECORD_PUT);
+                writer.writeVarInt(entry.first.size());
+                writer.writeString(entry.first);
+                writer.writeVarInt(entry.second.size());
+                writer.writeByteArray(entry.second);
+            }
+            return writer.toByteArray();
+        }
+
+        // Must be called with _fileMutex held
+        void FilePreferencesBackend::rewrite() {
+            std::vector<uint8_t> content(FILE_MAGIC.begin(), FILE_MAGIC.end());
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                encodeFrame(snapshot(), content);
+                // The snapshot already contains every pending change
+                _pending.clear();
+            }
+
+            const auto tmpPath = _path + ".tmp";
+            {
+                std::ofstream output(tmpPath, std::ios::binary | std::ios::trunc);
+                output.write(reinterpret_cast<const char*>(content.data()), content.size());
+                output.flush();
+                if (!output.good()) {
+                    throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Unable to write preferences file {}", tmpPath);
+                }
+            }
+            if (_file.is_open()) {
+                _file.close();
+            }
+#if defined(_WIN32) || defined(_WIN64)
+            std::remove(_path.c_str());
+#endif
+            if (std::rename(tmpPath.c_str(), _path.c_str()) != 0) {
+                throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Unable to replace preferences file {}", _path);
+            }
+            _file.open(_path, std::ios::binary | std::ios::app);
+            if (!_file.is_open()) {
+                throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Unable to open preferences file {}", _path);
+            }
+            _logSize = content.size();
+            _rewriteNeeded = false;
+        }
+
+        void FilePreferencesBackend::setEncryption(const std::shared_ptr<api::RandomNumberGenerator>& rng,
+                                                   const std::string& password) {
+            std::lock_guard<std::mutex> fileLock(_fileMutex);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _cache.clear();
+                if (!_salt.empty()) {
+                    _cipher = AESCipher(rng, password, _salt, PBKDF2_ITERATIONS);
+                    return;
+                }
+                // First encryption, cipher everything already stored
+                _salt = newSalt(rng);
+                _cipher = AESCipher(rng, password, _salt, PBKDF2_ITERATIONS);
+                _liveSize = 0;
+                for (auto& entry : _values) {
+                    entry.second = encrypt(*_cipher, entry.second);
+                    _liveSize += entry.first.size() + entry.second.size();
+                }
+            }
+            rewrite();
+        }
+
+        void FilePreferencesBackend::unsetEncryption() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cipher = Option<AESCipher>();
+            _cache.clear();
+        }
+
+        bool FilePreferencesBackend::resetEncryption(const std::shared_ptr<api::RandomNumberGenerator>& rng,
+                                                     const std::string& oldPassword,
+                                                     const std::string& newPassword) {
+            std::lock_guard<std::mutex> fileLock(_fileMutex);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (oldPassword.empty() != _salt.empty()) {
+                    // Either no salt to decipher with, or ciphered data and no password
+                    return false;
+                }
+                if (oldPassword.empty() && newPassword.empty()) {
+                    return true;
+                }
+
+                // Work on a copy so that a wrong password leaves the store untouched
+                auto values = _values;
+                auto salt = newPassword.empty() ? std::string() : newSalt(rng);
+                Option<AESCipher> cipher;
+                if (!newPassword.empty()) {
+                    cipher = AESCipher(rng, newPassword, salt, PBKDF2_ITERATIONS);
+                }
+                try {
+                    Option<AESCipher> oldCipher;
+                    if (!oldPassword.empty()) {
+                        oldCipher = AESCipher(rng, oldPassword, _salt, PBKDF2_ITERATIONS);
+                    }
+                    for (auto& entry : values) {
+                        if (oldCipher.nonEmpty()) {
+                            entry.second = decrypt(*oldCipher, entry.second);
+                        }
+                        if (cipher.nonEmpty()) {
+                            entry.second = encrypt(*cipher, entry.second);
+                        }
+                    }
+                } catch (...) {
+                    return false;
+                }
+
+                _values.swap(values);
+                _salt = salt;
+                _cipher = cipher;
+                _cache.clear();
+                _liveSize = 0;
+                for (const auto& entry : _values) {
+                    _liveSize += entry.first.size() + entry.second.size();
+                }
+            }
+            rewrite();
+            return true;
+        }
+
+        std::string FilePreferencesBackend::getEncryptionSalt() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _salt;
+        }
+
+        void FilePreferencesBackend::clear() {
+            std::lock_guard<std::mutex> fileLock(_fileMutex);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                // The encryption settings are kept, only the data is dropped
+                _values.clear();
+                _cache.clear();
+                _liveSize = 0;
+            }
+            rewrite();
+        }
+
+        size_t FilePreferencesBackend::getPendingSize() const {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _pending.size();
+        }
+
+        size_t FilePreferencesBackend::getLogSize() const {
+            std::lock_guard<std::mutex> lock(_fileMutex);
+            return _logSize;
+        }
+
+        std::string FilePreferencesBackend::newSalt(const std::shared_ptr<api::RandomNumberGenerator>& rng) const {
+            return hex::toString(rng->getRandomBytes(SALT_SIZE));
+        }
+
+        std::vector<uint8_t> FilePreferencesBackend::encrypt(AESCipher& cipher, const std::vector<uint8_t>& value) {
+            BytesReader reader(value);
+            BytesWriter writer;
+            cipher.encrypt(reader, writer);
+            return writer.toByteArray();
+        }
+
+        std::vector<uint8_t> FilePreferencesBackend::decrypt(const AESCipher& cipher, const std::vector<uint8_t>& value) {
+            BytesReader reader(value);
+            BytesWriter writer;
+            cipher.decrypt(reader, writer);
+            return writer.toByteArray();
+        }
+
+    }
+}
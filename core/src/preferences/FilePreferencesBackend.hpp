@@ -0,0 +1,152 @@
+/*
+ *
+ * FilePreferencesBackend
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_FILEPREFERENCESBACKEND_HPP
+#define LEDGER_CORE_FILEPREFERENCESBACKEND_HPP
+
+#include "../api/PreferencesBackend.hpp"
+#include "../api/PreferencesChange.hpp"
+#include "../api/ExecutionContext.hpp"
+#include "../crypto/AESCipher.hpp"
+#include "../utils/Option.hpp"
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * PreferencesBackend provided by the core and stored in a single local file.
+         *
+         * The file is an append-only log of change batches which is rewritten (compacted) once it
+         * grows too large compared to the live data set. All the stored values are kept in memory,
+         * and decrypted values are cached on first read so that repeated reads never hit the disk nor
+         * the cipher. Commits are applied to memory right away and are group-committed to the file:
+         * every commit received during the commit window is written with a single append.
+         * Changes not yet flushed are lost if the process dies before the end of the window, use a
+         * window of 0 to write synchronously on every commit.
+         */
+        class FilePreferencesBackend : public api::PreferencesBackend,
+                                       public std::enable_shared_from_this<FilePreferencesBackend> {
+        public:
+            static constexpr std::chrono::milliseconds::rep DEFAULT_COMMIT_WINDOW_MS = 50;
+            // Pending bytes forcing a synchronous flush, whatever the commit window
+            static constexpr size_t MAX_PENDING_SIZE = 1024 * 1024;
+            // The log is compacted when it is bigger than both values
+            static constexpr size_t COMPACTION_MIN_SIZE = 1024 * 1024;
+            static constexpr size_t COMPACTION_RATIO = 2;
+            static constexpr uint32_t PBKDF2_ITERATIONS = 10000;
+            static constexpr size_t SALT_SIZE = 32;
+            // The decrypted values cache is dropped when it reaches this size
+            static constexpr size_t MAX_CACHED_VALUES = 4096;
+
+            /**
+             * Open (or create) the preferences stored at the given path.
+             * @param path Absolute path of the file (see api::PathResolver::resolvePreferencesPath).
+             * @param context Context on which delayed group commits run. With no context, every commit
+             * is written synchronously.
+             * @param commitWindow Maximum delay between a commit and its write to the file.
+             */
+            static std::shared_ptr<FilePreferencesBackend> open(
+                    const std::string& path,
+                    const std::shared_ptr<api::ExecutionContext>& context,
+                    std::chrono::milliseconds commitWindow = std::chrono::milliseconds(DEFAULT_COMMIT_WINDOW_MS));
+
+            ~FilePreferencesBackend() override;
+
+            std::experimental::optional<std::vector<uint8_t>> get(const std::vector<uint8_t>& key) override;
+            bool commit(const std::vector<api::PreferencesChange>& changes) override;
+            void setEncryption(const std::shared_ptr<api::RandomNumberGenerator>& rng, const std::string& password) override;
+            void unsetEncryption() override;
+            bool resetEncryption(const std::shared_ptr<api::RandomNumberGenerator>& rng,
+                                 const std::string& oldPassword,
+                                 const std::string& newPassword) override;
+            std::string getEncryptionSalt() override;
+            void clear() override;
+
+            /**
+             * Write the pending changes to the file now.
+             */
+            void flush();
+            /**
+             * Rewrite the file with the live data only.
+             */
+            void compact();
+
+            size_t getPendingSize() const;
+            size_t getLogSize() const;
+
+        private:
+            FilePreferencesBackend(const std::string& path,
+                                   const std::shared_ptr<api::ExecutionContext>& context,
+                                   std::chrono::milliseconds commitWindow);
+
+            void load();
+            void scheduleFlush();
+            void writeFrame(const std::vector<uint8_t>& payload);
+            void rewrite();
+            bool applyFrame(const std::vector<uint8_t>& payload);
+            std::string newSalt(const std::shared_ptr<api::RandomNumberGenerator>& rng) const;
+            void appendRecord(uint8_t type, const std::string& key, const std::vector<uint8_t>& value);
+            std::vector<uint8_t> snapshot() const;
+            static std::vector<uint8_t> encrypt(AESCipher& cipher, const std::vector<uint8_t>& value);
+            static std::vector<uint8_t> decrypt(const AESCipher& cipher, const std::vector<uint8_t>& value);
+
+        private:
+            const std::string _path;
+            const std::shared_ptr<api::ExecutionContext> _context;
+            const std::chrono::milliseconds _commitWindow;
+
+            // Guards everything below but the file, the file is only touched with _fileMutex held.
+            // When both are needed _fileMutex is always taken first.
+            mutable std::mutex _mutex;
+            std::unordered_map<std::string, std::vector<uint8_t>> _values;
+            std::unordered_map<std::string, std::vector<uint8_t>> _cache;
+            std::vector<uint8_t> _pending;
+            bool _flushScheduled;
+            size_t _liveSize;
+            std::string _salt;
+            Option<AESCipher> _cipher;
+
+            mutable std::mutex _fileMutex;
+            std::ofstream _file;
+            size_t _logSize;
+            // Set when a write failed, the next flush rewrites the whole file instead of appending
+            bool _rewriteNeeded;
+        };
+
+    }
+}
+
+#endif //LEDGER_CORE_FILEPREFERENCESBACKEND_HPP
@@ -30,30 +30,154 @@
  */
 
 #include "DateUtils.hpp"
-#include <regex>
 #include "Exception.hpp"
-#include <boost/lexical_cast.hpp>
+#include <cstring>
 #include <ctime>
-#include <unordered_map>
 
 namespace {
-    const std::unordered_map<std::string, std::string> MONTHS = {
-            {"Jan", "01"},
-            {"Feb", "02"},
-            {"Mar", "03"},
-            {"Apr", "04"},
-            {"May", "05"},
-            {"Jun", "06"},
-            {"Jul", "07"},
-            {"Aug", "08"},
-            {"Sep", "09"},
-            {"Oct", "10"},
-            {"Nov", "11"},
-            {"Dec", "12"},
+    const char* const MONTHS[] = {
+            "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
     };
 
-    constexpr auto PARSE_JSON_DATE_REGEX("([0-9]+)-([0-9]+)-([0-9]+)T([0-9]+):([0-9]+):([0-9]+)[\\.0-9]*([Z]?)");
-    constexpr auto FORMAT_JSON_DATE_REGEX("([0-9]+)-([a-zA-Z]+)-([0-9]+) ([0-9]+):([0-9]+):([0-9]+)[\\.0-9]*([Z]?)");
+    struct DateFields {
+        int64_t year;
+        int64_t month;
+        int64_t day;
+        int64_t hours;
+        int64_t minutes;
+        int64_t seconds;
+        bool utc;
+    };
+
+    // Sequential reader over a date string, each method advances the cursor only on success.
+    // Dates are parsed in place, without any allocation, as they are read for every date
+    // column of every row loaded from the database (see soci-date.h).
+    struct DateReader {
+        const char* it;
+        const char* end;
+
+        bool number(int64_t& out) {
+            // More digits than any meaningful date field is treated as a mismatch (avoids overflows)
+            static const auto MAX_DIGITS = 9;
+            auto begin = it;
+            int64_t value = 0;
+            while (it != end && *it >= '0' && *it <= '9' && it - begin < MAX_DIGITS) {
+                value = value * 10 + (*it - '0');
+                ++it;
+            }
+            if (it == begin || (it != end && *it >= '0' && *it <= '9')) {
+                return false;
+            }
+            out = value;
+            return true;
+        }
+
+        bool expect(char c) {
+            if (it == end || *it != c) {
+                return false;
+            }
+            ++it;
+            return true;
+        }
+
+        // Matches a three letters month name as output by the explorers ("Jan", "Feb"...)
+        bool month(int64_t& out) {
+            auto begin = it;
+            while (it != end && ((*it >= 'a' && *it <= 'z') || (*it >= 'A' && *it <= 'Z'))) {
+                ++it;
+            }
+            if (it - begin == 3) {
+                for (auto i = 0; i < 12; i++) {
+                    if (std::strncmp(begin, MONTHS[i], 3) == 0) {
+                        out = i + 1;
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        // Optional fractional part of the seconds (ignored) and 'Z' suffix, then the end of the string
+        bool tail(bool& utc) {
+            while (it != end && ((*it >= '0' && *it <= '9') || *it == '.')) {
+                ++it;
+            }
+            utc = expect('Z');
+            return it == end;
+        }
+    };
+
+    // YYYY-MM-DDTHH:MM:SS[.sss][Z]
+    bool parseJSONDate(const char* str, std::size_t size, DateFields& out) {
+        DateReader reader {str, str + size};
+        return reader.number(out.year) && reader.expect('-') &&
+               reader.number(out.month) && reader.expect('-') &&
+               reader.number(out.day) && reader.expect('T') &&
+               reader.number(out.hours) && reader.expect(':') &&
+               reader.number(out.minutes) && reader.expect(':') &&
+               reader.number(out.seconds) && reader.tail(out.utc);
+    }
+
+    // YYYY-Mon-DD HH:MM:SS[.sss][Z]
+    bool parseFormattedDate(const char* str, std::size_t size, DateFields& out) {
+        DateReader reader {str, str + size};
+        return reader.number(out.year) && reader.expect('-') &&
+               reader.month(out.month) && reader.expect('-') &&
+               reader.number(out.day) && reader.expect(' ') &&
+               reader.number(out.hours) && reader.expect(':') &&
+               reader.number(out.minutes) && reader.expect(':') &&
+               reader.number(out.seconds) && reader.tail(out.utc);
+    }
+
+    int64_t floorDiv(int64_t a, int64_t b) {
+        return a / b - ((a % b != 0 && (a < 0) != (b < 0)) ? 1 : 0);
+    }
+
+    // Days since 1970-01-01 of a proleptic gregorian date (http://howardhinnant.github.io/date_algorithms.html)
+    int64_t daysFromCivil(int64_t year, int64_t month, int64_t day) {
+        year -= month <= 2 ? 1 : 0;
+        const auto era = floorDiv(year, 400);
+        const auto yoe = year - era * 400;
+        const auto doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const auto doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+
+    void civilFromDays(int64_t days, int64_t& year, int64_t& month, int64_t& day) {
+        days += 719468;
+        const auto era = floorDiv(days, 146097);
+        const auto doe = days - era * 146097;
+        const auto yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const auto doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const auto mp = (5 * doy + 2) / 153;
+        day = doy - (153 * mp + 2) / 5 + 1;
+        month = mp + (mp < 10 ? 3 : -9);
+        year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+    }
+
+    // Out of range fields overflow on the next ones (e.g. month 13 is January of the next year),
+    // like timegm does. Dates the system clock cannot hold (it only covers a few centuries around
+    // 1970 with a nanosecond resolution) are rejected instead of wrapping around.
+    bool toTimePoint(const DateFields& fields, std::chrono::system_clock::time_point& out) {
+        using namespace std::chrono;
+        const auto month = fields.month - 1;
+        const auto year = fields.year + floorDiv(month, 12);
+        const auto days = daysFromCivil(year, month - floorDiv(month, 12) * 12 + 1, 1) + fields.day - 1;
+        const auto seconds = days * 86400 + fields.hours * 3600 + fields.minutes * 60 + fields.seconds;
+        if (seconds > duration_cast<std::chrono::seconds>(system_clock::duration::max()).count() ||
+            seconds < duration_cast<std::chrono::seconds>(system_clock::duration::min()).count()) {
+            return false;
+        }
+        out = system_clock::time_point(std::chrono::seconds(seconds));
+        return true;
+    }
+
+    void writeDigits(char* out, int64_t value, int width) {
+        for (auto i = width - 1; i >= 0; i--) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
 }
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -67,79 +191,59 @@ namespace {
 namespace ledger {
     namespace core {
         std::chrono::system_clock::time_point ledger::core::DateUtils::fromJSON(const std::string &str) {
-            static const std::regex parseJsonDateRegex {PARSE_JSON_DATE_REGEX};
-
-            std::cmatch what;
-
-            if (regex_match(str.c_str(), what, parseJsonDateRegex)) {
-                auto year = boost::lexical_cast<unsigned int>(std::string(what[1].first, what[1].second));
-                auto month = boost::lexical_cast<unsigned int>(std::string(what[2].first, what[2].second));
-                auto day = boost::lexical_cast<unsigned int>(std::string(what[3].first, what[3].second));
-                auto hours = boost::lexical_cast<unsigned int>(std::string(what[4].first, what[4].second));
-                auto minutes = boost::lexical_cast<unsigned int>(std::string(what[5].first, what[5].second));
-                auto seconds = boost::lexical_cast<unsigned int>(std::string(what[6].first, what[6].second));
-                auto localTime = std::string(what[7].first, what[7].second);
-
-                if (localTime != "Z") {
+            DateFields fields;
+            std::chrono::system_clock::time_point date;
+            if (parseJSONDate(str.data(), str.size(), fields)) {
+                if (!fields.utc) {
                     throw make_exception(api::ErrorCode::INVALID_DATE_FORMAT, "Cannot create date from local date {}", str);
                 }
-
-                struct tm time;
-                time.tm_year = year - 1900;
-                time.tm_mon = month - 1;
-                time.tm_hour = hours;
-                time.tm_mday = day;
-                time.tm_hour = hours;
-                time.tm_min = minutes;
-                time.tm_sec = seconds;
-
-                return std::chrono::time_point_cast<std::chrono::seconds>(std::chrono::system_clock::from_time_t(timegm(&time)));
-            } else {
-                try {
-                    auto formattedDate = formatDateFromJSON(str);
-                    return fromJSON(formattedDate);
-                } catch (...) {
-                    throw make_exception(api::ErrorCode::INVALID_DATE_FORMAT, "Cannot convert {} to date", str);
+                if (toTimePoint(fields, date)) {
+                    return date;
                 }
+            } else if (parseFormattedDate(str.data(), str.size(), fields) && toTimePoint(fields, date)) {
+                // Formatted dates are always read as UTC (see formatDateFromJSON)
+                return date;
             }
+            throw make_exception(api::ErrorCode::INVALID_DATE_FORMAT, "Cannot convert {} to date", str);
         }
     }
 
     std::string ledger::core::DateUtils::formatDateFromJSON(const std::string &str) {
-        static const std::regex formatJsonDateRegex {FORMAT_JSON_DATE_REGEX};
-
-        std::cmatch what;
-
-        if (regex_match(str.c_str(), what, formatJsonDateRegex)) {
-            auto year = boost::lexical_cast<unsigned int>(std::string(what[1].first, what[1].second));
-            auto month = boost::lexical_cast<std::string>(std::string(what[2].first, what[2].second));
-            auto day = boost::lexical_cast<unsigned int>(std::string(what[3].first, what[3].second));
-            auto hours = boost::lexical_cast<unsigned int>(std::string(what[4].first, what[4].second));
-            auto minutes = boost::lexical_cast<unsigned int>(std::string(what[5].first, what[5].second));
-            auto seconds = boost::lexical_cast<unsigned int>(std::string(what[6].first, what[6].second));
-            auto numMonth = MONTHS.at(month);
-
-            if (numMonth.empty()) {
-                throw make_exception(api::ErrorCode::INVALID_DATE_FORMAT, "Failed to get month {} from date {}", month, str);
-            }
-
-            return fmt::format("{}-{}-{}T{}:{}:{}Z", year, numMonth, day, hours, minutes, seconds);
+        DateFields fields;
+        if (parseFormattedDate(str.data(), str.size(), fields)) {
+            return fmt::format("{}-{:02}-{}T{}:{}:{}Z", fields.year, fields.month, fields.day,
+                               fields.hours, fields.minutes, fields.seconds);
         } else {
             throw make_exception(api::ErrorCode::INVALID_DATE_FORMAT, "Cannot format {} to date YYYY-MM-DDTHH:MM:SSZ", str);
         }
     }
 
     std::string ledger::core::DateUtils::toJSON(const std::chrono::system_clock::time_point &date) {
-        std::tm tm = {0};
-        std::time_t tt = std::chrono::system_clock::to_time_t(date);
-
-#if defined(_WIN32) || defined(_WIN64)
-        gmtime_s(&tm, &tt);
-#else
-        gmtime_r(&tt, &tm);
-#endif
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(date.time_since_epoch()).count();
+        const auto days = floorDiv(seconds, 86400);
+        const auto secondsOfDay = seconds - days * 86400;
+        int64_t year, month, day;
+        civilFromDays(days, year, month, day);
+        if (year < 0 || year > 9999) {
+            return fmt::format("{:04}-{:02}-{:02}T{:02}:{:02}:{:02}Z", year, month, day,
+                               secondsOfDay / 3600, secondsOfDay / 60 % 60, secondsOfDay % 60);
+        }
 
-        return fmt::format("{:04}-{:02}-{:02}T{:02}:{:02}:{:02}Z", 1900 + tm.tm_year, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+        // YYYY-MM-DDTHH:MM:SSZ
+        char out[20];
+        writeDigits(out, year, 4);
+        out[4] = '-';
+        writeDigits(out + 5, month, 2);
+        out[7] = '-';
+        writeDigits(out + 8, day, 2);
+        out[10] = 'T';
+        writeDigits(out + 11, secondsOfDay / 3600, 2);
+        out[13] = ':';
+        writeDigits(out + 14, secondsOfDay / 60 % 60, 2);
+        out[16] = ':';
+        writeDigits(out + 17, secondsOfDay % 60, 2);
+        out[19] = 'Z';
+        return std::string(out, sizeof(out));
     }
 
     std::chrono::system_clock::time_point ledger::core::DateUtils::now() {
@@ -74,6 +74,11 @@ namespace ledger {
                 _cache.erase(key);
             }
 
+            void clear() {
+                std::lock_guard<std::mutex> lock(_lock);
+                _cache.clear();
+            }
+
         private:
             Duration getNowDurationSinceEpoch() {
                 return std::chrono::duration_cast<Duration>(std::chrono::steady_clock::now().time_since_epoch());
@@ -57,6 +57,15 @@ namespace ledger {
                 _value = optional<T>(v);
             }
 
+            Try(T&& v) {
+                _value = optional<T>(std::move(v));
+            }
+
+            Try(const Try<T>&) = default;
+            Try(Try<T>&&) = default;
+            Try<T>& operator=(const Try<T>&) = default;
+            Try<T>& operator=(Try<T>&&) = default;
+
             Try(api::ErrorCode code, const std::string& message) {
                 fail(code, message);
             }
@@ -73,6 +82,10 @@ namespace ledger {
                 _value = v;
             }
 
+            void success(T&& v) {
+                _value = std::move(v);
+            }
+
             const T& getValue() const {
                 return _value.value();
             }
@@ -138,7 +151,8 @@ namespace ledger {
             optional<T> _value;
 
         public:
-            static const Try<T> from(std::function<T ()> lambda) {
+            template <typename Callable>
+            static Try<T> from(Callable&& lambda) {
                 Try<T> result;
                 try {
                     result.success(lambda());
@@ -214,6 +214,7 @@ namespace algorand {
         }
 
         return _http->POST(constants::purestakeTransactionsEndpoint, transaction, headers)
+            .prioritized()
             .json(false)
             .map<std::string>(_executionContext, [correlationId](const HttpRequest::JsonResult& response) {
                     const auto& json = std::get<1>(response)->GetObject();
@@ -544,7 +544,7 @@ namespace ledger {
                     const std::vector<Operation> &operations) {
                 if (operations.empty())
                     return;
-                Benchmarker rawInsert("raw_db_insert_algorand", nullptr);
+                Benchmarker rawInsert("raw_db_insert_algorand", BENCHMARK_HISTOGRAM("raw_db_insert_algorand"), nullptr);
                 rawInsert.start();
                 PreparedStatement<OperationBinding> operationStmt;
                 PreparedStatement<BlockBinding> blockStmt;
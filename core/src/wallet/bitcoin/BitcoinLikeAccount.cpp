@@ -49,8 +49,11 @@
 #include <api/BitcoinLikeOutputListCallback.hpp>
 #include <api/BitcoinLikeInput.hpp>
 #include <wallet/common/database/BlockDatabaseHelper.h>
+#include <wallet/common/database/BalanceCheckpointDatabaseHelper.h>
 #include <wallet/bitcoin/transaction_builders/BitcoinLikeTransactionBuilder.h>
 #include <wallet/bitcoin/transaction_builders/BitcoinLikeStrategyUtxoPicker.h>
+#include <api/Configuration.hpp>
+#include <api/ConfigurationDefaults.hpp>
 #include <wallet/bitcoin/database/BitcoinLikeTransactionDatabaseHelper.h>
 #include <wallet/common/database/OperationDatabaseHelper.h>
 #include <wallet/bitcoin/api_impl/BitcoinLikeTransactionApi.h>
@@ -185,6 +188,23 @@ void inflateOptimisticUpdateFees(
         });
     toFillTx.fees = inputValue - outputValue;
 }
+
+/// Apply an operation to a running balance
+void updateBalance(const Operation &operation, BigInt &sum) {
+    switch (operation.type) {
+        case api::OperationType::RECEIVE: {
+            sum = sum + operation.amount;
+            break;
+        }
+        case api::OperationType::SEND: {
+            sum = sum - (operation.amount + operation.fees.getValueOr(BigInt::ZERO));
+            break;
+        }
+        case api::OperationType::NONE:
+        default:
+            break;
+    }
+}
 } // namespace
 
 namespace ledger {
@@ -199,7 +219,19 @@ namespace ledger {
             _synchronizer = synchronizer;
             _keychain = keychain;
             _keychain->getAllObservableAddresses(0, 40);
-            _picker = std::make_shared<BitcoinLikeStrategyUtxoPicker>(getWallet()->getPool()->getThreadPoolExecutionContext(), getWallet()->getCurrency());
+            auto maxParallelLookups = getWallet()->getConfiguration()->getInt(api::Configuration::TRANSACTION_BUILDER_MAX_PARALLEL_LOOKUPS)
+                    .value_or(api::ConfigurationDefaults::DEFAULT_TRANSACTION_BUILDER_MAX_PARALLEL_LOOKUPS);
+            _picker = std::make_shared<BitcoinLikeStrategyUtxoPicker>(getWallet()->getPool()->getThreadPoolExecutionContext(), getWallet()->getCurrency(), maxParallelLookups);
+            auto rawTransactionStoreSize = getWallet()->getConfiguration()->getInt(api::Configuration::RAW_TRANSACTION_STORE_MAX_SIZE)
+                    .value_or(api::ConfigurationDefaults::DEFAULT_RAW_TRANSACTION_STORE_MAX_SIZE);
+            if (rawTransactionStoreSize > 0) {
+                _rawTransactions = std::make_shared<BitcoinLikeRawTransactionStore>(
+                        getWallet()->getPool()->getThreadPoolExecutionContext(),
+                        getWallet()->getDatabase(),
+                        explorer,
+                        getWallet()->getCurrency().name,
+                        rawTransactionStoreSize);
+            }
             _currentBlockHeight = 0;
         }
 
@@ -357,6 +389,7 @@ namespace ledger {
                 soci::session sql(getWallet()->getDatabase()->getPool());
                 soci::transaction tr(sql);
                 BitcoinLikeOperationDatabaseHelper::bulkInsert(sql, ops);
+                updateBalanceCheckpoints(sql);
                 tr.commit();
                 // Emit
                 emitNewOperationsEvent(ops);
@@ -639,15 +672,24 @@ namespace ledger {
                     return keychain->contains(addr);
                 };
 
-                //Get operations related to an account
-                OperationDatabaseHelper::queryOperations(sql, uid, operations, filter);
+                // Start from the balance at the end of the last day preceding the requested window (if
+                // any) so only the operations from that day are replayed
+                BigInt sum;
+                auto checkpoint = BalanceCheckpointDatabaseHelper::getLastCheckpointBefore(
+                        sql, uid, BalanceCheckpointDatabaseHelper::dayOf(startDate));
+                if (checkpoint.nonEmpty()) {
+                    sum = checkpoint.getValue().balance;
+                    OperationDatabaseHelper::queryOperationsAfter(
+                            sql, uid, BalanceCheckpointDatabaseHelper::endOfDay(checkpoint.getValue().day), operations, filter);
+                } else {
+                    OperationDatabaseHelper::queryOperations(sql, uid, operations, filter);
+                }
 
                 auto lowerDate = startDate;
                 auto upperDate = DateUtils::incrementDate(startDate, precision);
 
                 std::vector<std::shared_ptr<api::Amount>> amounts;
                 std::size_t operationsCount = 0;
-                BigInt sum;
                 while (lowerDate <= endDate && operationsCount < operations.size()) {
 
                     auto operation = operations[operationsCount];
@@ -659,19 +701,7 @@ namespace ledger {
                     }
 
                     if (operation.date <= upperDate) {
-                        switch (operation.type) {
-                            case api::OperationType::RECEIVE: {
-                                sum = sum + operation.amount;
-                                break;
-                            }
-                            case api::OperationType::SEND: {
-                                sum = sum - (operation.amount + operation.fees.getValueOr(BigInt::ZERO));
-                                break;
-                            }
-                            case api::OperationType::NONE:
-                            default:
-                                break;
-                        }
+                        updateBalance(operation, sum);
                     }
                     operationsCount += 1;
                 }
@@ -686,6 +716,38 @@ namespace ledger {
             });
         }
 
+        void BitcoinLikeAccount::updateBalanceCheckpoints(soci::session &sql) {
+            const auto& uid = getAccountUid();
+            auto keychain = getKeychain();
+            std::function<bool(const std::string &)> filter = [&keychain](const std::string addr) -> bool {
+                return keychain->contains(addr);
+            };
+
+            // Checkpoints invalidated by the operations just inserted are already gone (see migration 29),
+            // only replay the operations following the last remaining one
+            std::vector<Operation> operations;
+            BigInt sum;
+            auto last = BalanceCheckpointDatabaseHelper::getLastCheckpoint(sql, uid);
+            if (last.nonEmpty()) {
+                sum = last.getValue().balance;
+                OperationDatabaseHelper::queryOperationsAfter(
+                        sql, uid, BalanceCheckpointDatabaseHelper::endOfDay(last.getValue().day), operations, filter);
+            } else {
+                OperationDatabaseHelper::queryOperations(sql, uid, operations, filter);
+            }
+
+            std::vector<BalanceCheckpoint> checkpoints;
+            for (const auto& operation : operations) {
+                auto day = BalanceCheckpointDatabaseHelper::dayOf(operation.date);
+                if (checkpoints.empty() || checkpoints.back().day != day) {
+                    checkpoints.emplace_back(day, sum);
+                }
+                updateBalance(operation, sum);
+                checkpoints.back().balance = sum;
+            }
+            BalanceCheckpointDatabaseHelper::putCheckpoints(sql, uid, checkpoints);
+        }
+
         std::shared_ptr<BitcoinLikeAccount> BitcoinLikeAccount::getSelf() {
             return std::dynamic_pointer_cast<BitcoinLikeAccount>(shared_from_this());
         }
@@ -818,7 +880,8 @@ namespace ledger {
                                               _keychain,
                                               lastBlockHeight,
                                               logger(),
-                                              partial)
+                                              partial,
+                                              _rawTransactions)
             );
         }
 
@@ -49,6 +49,7 @@
 #include <wallet/bitcoin/types.h>
 
 #include <wallet/bitcoin/synchronizers/BitcoinLikeAccountSynchronizer.hpp>
+#include <wallet/bitcoin/BitcoinLikeRawTransactionStore.hpp>
 
 namespace ledger {
     namespace core {
@@ -154,12 +155,17 @@ namespace ledger {
                                          const BitcoinLikeBlockchainExplorerTransaction& tx);
             inline void computeOperationTrust(Operation& operation,
                                               const BitcoinLikeBlockchainExplorerTransaction& tx);
+            // Refresh the daily balance checkpoints following the last valid one, must be called
+            // after operations of the account have been inserted
+            void updateBalanceCheckpoints(soci::session& sql);
             std::vector<std::shared_ptr<api::Address>> fromBitcoinAddressesToAddresses(const std::vector<std::shared_ptr<BitcoinLikeAddress>> &addresses);
 
             std::shared_ptr<BitcoinLikeKeychain> _keychain;
             std::shared_ptr<BitcoinLikeBlockchainExplorer> _explorer;
             std::shared_ptr<BitcoinLikeAccountSynchronizer> _synchronizer;
             std::shared_ptr<BitcoinLikeUtxoPicker> _picker;
+            // Null when disabled by the configuration
+            std::shared_ptr<BitcoinLikeRawTransactionStore> _rawTransactions;
             std::shared_ptr<api::EventBus> _currentSyncEventBus;
             std::mutex _synchronizationLock;
             uint64_t _currentBlockHeight;
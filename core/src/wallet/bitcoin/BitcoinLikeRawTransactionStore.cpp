@@ -0,0 +1,148 @@
+/*
+ *
+ * BitcoinLikeRawTransactionStore
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "BitcoinLikeRawTransactionStore.hpp"
+#include <async/algorithm.h>
+#include <database/soci-backend-utils.h>
+#include <utils/Option.hpp>
+#include <wallet/bitcoin/database/BitcoinLikeRawTransactionDatabaseHelper.h>
+#include <chrono>
+#include <unordered_set>
+
+namespace ledger {
+    namespace core {
+
+        namespace {
+            int64_t nowMillis() {
+                return std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count();
+            }
+        }
+
+        BitcoinLikeRawTransactionStore::BitcoinLikeRawTransactionStore(const std::shared_ptr<api::ExecutionContext>& context,
+                                                                       const std::shared_ptr<DatabaseSessionPool>& database,
+                                                                       const std::shared_ptr<BitcoinLikeBlockchainExplorer>& explorer,
+                                                                       const std::string& currencyName,
+                                                                       int64_t maxSize)
+            : DedicatedContext(context), _database(database), _explorer(explorer), _currencyName(currencyName),
+              _maxSize(maxSize) {
+        }
+
+        Future<std::vector<uint8_t>> BitcoinLikeRawTransactionStore::getRawTransaction(const std::string& hash) {
+            auto self = shared_from_this();
+            return async<Option<std::vector<uint8_t>>>([=] () {
+                std::unordered_map<std::string, std::vector<uint8_t>> found;
+                soci::session sql(self->_database->getPool());
+                BitcoinLikeRawTransactionDatabaseHelper::getRawTransactions(sql, self->_currencyName, {hash}, nowMillis(), found);
+                auto it = found.find(hash);
+                if (it == found.end()) {
+                    return Option<std::vector<uint8_t>>();
+                }
+                return Option<std::vector<uint8_t>>(std::move(it->second));
+            }).flatMap<std::vector<uint8_t>>(getContext(), [=] (const Option<std::vector<uint8_t>>& raw) {
+                if (raw.hasValue()) {
+                    return Future<std::vector<uint8_t>>::successful(raw.getValue());
+                }
+                return self->_explorer->getRawTransaction(hash).map<std::vector<uint8_t>>(self->getContext(), [=] (const Bytes& bytes) {
+                    try {
+                        self->store({{hash, bytes.getContainer()}});
+                    } catch (...) {
+                        // The transaction will simply be fetched again next time
+                    }
+                    return bytes.getContainer();
+                });
+            });
+        }
+
+        Future<Unit> BitcoinLikeRawTransactionStore::prefetch(const std::vector<std::string>& hashes) {
+            auto self = shared_from_this();
+            std::unordered_set<std::string> unique;
+            std::vector<std::string> requested;
+            for (const auto& hash : hashes) {
+                if (unique.insert(hash).second) {
+                    requested.push_back(hash);
+                }
+            }
+            return async<std::vector<std::string>>([=] () {
+                std::unordered_map<std::string, std::vector<uint8_t>> found;
+                soci::session sql(self->_database->getPool());
+                for (size_t begin = 0; begin < requested.size(); begin += soci::MAX_IN_CLAUSE_SIZE) {
+                    const auto end = std::min(requested.size(), begin + soci::MAX_IN_CLAUSE_SIZE);
+                    BitcoinLikeRawTransactionDatabaseHelper::getRawTransactions(
+                            sql, self->_currencyName,
+                            std::vector<std::string>(requested.begin() + begin, requested.begin() + end),
+                            nowMillis(), found);
+                }
+                std::vector<std::string> missing;
+                for (const auto& hash : requested) {
+                    if (found.find(hash) == found.end()) {
+                        missing.push_back(hash);
+                    }
+                }
+                return missing;
+            }).flatMap<Unit>(getContext(), [=] (const std::vector<std::string>& missing) {
+                using Fetched = Option<std::pair<std::string, std::vector<uint8_t>>>;
+                std::vector<Future<Fetched>> fetches;
+                fetches.reserve(missing.size());
+                for (const auto& hash : missing) {
+                    fetches.push_back(self->_explorer->getRawTransaction(hash).map<Fetched>(self->getContext(), [=] (const Bytes& bytes) {
+                        return Fetched(std::make_pair(hash, bytes.getContainer()));
+                    }).recover(self->getContext(), [] (const Exception&) {
+                        return Fetched();
+                    }));
+                }
+                return async::sequence(self->getContext(), fetches).map<Unit>(self->getContext(), [=] (const std::vector<Fetched>& results) {
+                    std::vector<std::pair<std::string, std::vector<uint8_t>>> fetched;
+                    for (const auto& result : results) {
+                        if (result.hasValue()) {
+                            fetched.push_back(result.getValue());
+                        }
+                    }
+                    self->store(fetched);
+                    return unit;
+                });
+            });
+        }
+
+        void BitcoinLikeRawTransactionStore::store(const std::vector<std::pair<std::string, std::vector<uint8_t>>>& rawTransactions) {
+            if (rawTransactions.empty()) {
+                return;
+            }
+            const auto now = nowMillis();
+            soci::session sql(_database->getPool());
+            soci::transaction tr(sql);
+            for (const auto& rawTransaction : rawTransactions) {
+                BitcoinLikeRawTransactionDatabaseHelper::putRawTransaction(sql, _currencyName, rawTransaction.first, rawTransaction.second, now);
+            }
+            BitcoinLikeRawTransactionDatabaseHelper::evictRawTransactions(sql, _currencyName, _maxSize);
+            tr.commit();
+        }
+
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ *
+ * BitcoinLikeRawTransactionStore
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_BITCOINLIKERAWTRANSACTIONSTORE_HPP
+#define LEDGER_CORE_BITCOINLIKERAWTRANSACTIONSTORE_HPP
+
+#include <async/DedicatedContext.hpp>
+#include <database/DatabaseSessionPool.hpp>
+#include <wallet/bitcoin/explorers/BitcoinLikeBlockchainExplorer.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+        /**
+         * Serialized transactions needed to sign the inputs spending their outputs, kept in the wallet
+         * database. Transactions are fetched from the explorer on first use only, and the least
+         * recently used ones are evicted once the store exceeds its maximum size.
+         */
+        class BitcoinLikeRawTransactionStore : public DedicatedContext,
+                                               public std::enable_shared_from_this<BitcoinLikeRawTransactionStore> {
+        public:
+            BitcoinLikeRawTransactionStore(const std::shared_ptr<api::ExecutionContext>& context,
+                                           const std::shared_ptr<DatabaseSessionPool>& database,
+                                           const std::shared_ptr<BitcoinLikeBlockchainExplorer>& explorer,
+                                           const std::string& currencyName,
+                                           int64_t maxSize);
+
+            Future<std::vector<uint8_t>> getRawTransaction(const std::string& hash);
+
+            /**
+             * Fetch all the given transactions missing from the store with concurrent explorer requests
+             * and store them at once. Transactions that cannot be fetched are skipped, they will be
+             * fetched again on use.
+             */
+            Future<Unit> prefetch(const std::vector<std::string>& hashes);
+
+        private:
+            void store(const std::vector<std::pair<std::string, std::vector<uint8_t>>>& rawTransactions);
+
+            std::shared_ptr<DatabaseSessionPool> _database;
+            std::shared_ptr<BitcoinLikeBlockchainExplorer> _explorer;
+            std::string _currencyName;
+            int64_t _maxSize;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_BITCOINLIKERAWTRANSACTIONSTORE_HPP
@@ -34,6 +34,9 @@
 #include <wallet/common/database/AccountDatabaseHelper.h>
 #include <api/ConfigurationDefaults.hpp>
 #include <api/KeychainEngines.hpp>
+#include <api/BlockchainObserverEngines.hpp>
+#include <events/LambdaEventReceiver.hpp>
+#include <wallet/pool/WalletPool.hpp>
 #include <wallet/bitcoin/database/BitcoinLikeAccountDatabaseHelper.h>
 #include "BitcoinLikeAccount.hpp"
 #include <algorithm>
@@ -152,15 +155,16 @@ namespace ledger {
                 AccountDatabaseHelper::createAccount(sql, self->getWalletUid(), index);
                 BitcoinLikeAccountDatabaseHelper::createAccount(sql, self->getWalletUid(), index, keychain->getRestoreKey());
                 tr.commit();
-                auto account = std::static_pointer_cast<api::Account>(std::make_shared<BitcoinLikeAccount>(
+                auto account = std::make_shared<BitcoinLikeAccount>(
                         self->shared_from_this(),
                         index,
                         self->_explorer,
                         self->_synchronizerFactory(),
                         keychain
-                ));
-                self->addAccountInstanceToInstanceCache(std::dynamic_pointer_cast<AbstractAccount>(account));
-                return account;
+                );
+                self->addAccountInstanceToInstanceCache(account);
+                self->subscribeToNotifications(account);
+                return std::static_pointer_cast<api::Account>(account);
             });
         }
 
@@ -219,11 +223,43 @@ namespace ledger {
             auto xpubPath = scheme.getSchemeTo(DerivationSchemeLevel::ACCOUNT_INDEX).getPath();
             auto keychain = _keychainFactory->restore(entry.index, xpubPath, getConfig(), entry.xpub,
             getAccountInternalPreferences(entry.index), getCurrency());
-            return std::make_shared<BitcoinLikeAccount>(shared_from_this(),
-                                                        entry.index,
-                                                        _explorer,
-                                                        _synchronizerFactory(),
-                                                        keychain);
+            auto account = std::make_shared<BitcoinLikeAccount>(shared_from_this(),
+                                                                entry.index,
+                                                                _explorer,
+                                                                _synchronizerFactory(),
+                                                                keychain);
+            subscribeToNotifications(account);
+            return account;
+        }
+
+        void BitcoinLikeWallet::subscribeToNotifications(const std::shared_ptr<BitcoinLikeAccount> &account) {
+            auto engine = getConfiguration()->getString(api::Configuration::BLOCKCHAIN_OBSERVER_ENGINE).value_or("");
+            if (engine != api::BlockchainObserverEngines::LEDGER_API || !getCurrency().bitcoinLikeNetworkParameters) {
+                return;
+            }
+            auto endpoint = fmt::format(
+                    getConfiguration()->getString(api::Configuration::BLOCKCHAIN_OBSERVER_WS_ENDPOINT)
+                            .value_or(api::ConfigurationDefaults::BLOCKCHAIN_OBSERVER_WS_ENDPOINT),
+                    getCurrency().bitcoinLikeNetworkParameters.value().Identifier
+            );
+            std::weak_ptr<BitcoinLikeAccount> weakAccount = account;
+            PushSynchronizer::Subscriber subscriber;
+            subscriber.uid = account->getAccountUid();
+            subscriber.ownsAddress = [weakAccount] (const std::string& address) {
+                auto a = weakAccount.lock();
+                return a && a->getKeychain()->contains(address);
+            };
+            subscriber.synchronize = [weakAccount] () {
+                auto a = weakAccount.lock();
+                if (!a)
+                    return Future<Unit>::successful(unit);
+                Promise<Unit> promise;
+                a->synchronize()->subscribe(a->getContext(), make_promise_receiver(promise,
+                        {api::EventCode::SYNCHRONIZATION_SUCCEED, api::EventCode::SYNCHRONIZATION_SUCCEED_ON_PREVIOUSLY_EMPTY_ACCOUNT},
+                        {api::EventCode::SYNCHRONIZATION_FAILED}));
+                return promise.getFuture();
+            };
+            getPool()->getPushSynchronizer()->subscribe(endpoint, subscriber);
         }
 
         std::shared_ptr<BitcoinLikeBlockchainExplorer> BitcoinLikeWallet::getBlockchainExplorer() {
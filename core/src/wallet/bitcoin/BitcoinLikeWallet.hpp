@@ -43,6 +43,7 @@
 
 namespace ledger {
     namespace core {
+        class BitcoinLikeAccount;
         class BitcoinLikeWallet : public virtual api::BitcoinLikeWallet, public virtual AbstractWallet {
         public:
             static const api::WalletType type;
@@ -82,6 +83,9 @@ namespace ledger {
 
         private:
             std::shared_ptr<BitcoinLikeWallet> getSelf();
+            // Lets the pool push synchronizer sync the account on explorer notifications, if the
+            // wallet is configured with an observer engine
+            void subscribeToNotifications(const std::shared_ptr<BitcoinLikeAccount>& account);
 
         private:
             std::shared_ptr<BitcoinLikeBlockchainExplorer> _explorer;
@@ -40,6 +40,8 @@
 #include <math/Base58.hpp>
 #include <api/KeychainEngines.hpp>
 #include <api/BitcoinLikeTransactionBuilder.hpp>
+#include <api/BoolCallback.hpp>
+#include <utils/ImmediateExecutionContext.hpp>
 
 namespace ledger {
     namespace core {
@@ -352,6 +354,28 @@ namespace ledger {
             return api::BitcoinLikeSignatureState::SIGNING_SUCCEED;
         }
 
+        void BitcoinLikeTransactionApi::prefetchPreviousTransactions(const std::shared_ptr<api::BoolCallback> &callback) {
+            prefetchPreviousTransactions().callback(ImmediateExecutionContext::INSTANCE, callback);
+        }
+
+        Future<bool> BitcoinLikeTransactionApi::prefetchPreviousTransactions() {
+            std::shared_ptr<BitcoinLikeRawTransactionStore> store;
+            std::vector<std::string> hashes;
+            for (const auto& input : _inputs) {
+                auto writableInput = std::dynamic_pointer_cast<BitcoinLikeWritableInputApi>(input);
+                if (writableInput && writableInput->getRawTransactionStore()) {
+                    store = writableInput->getRawTransactionStore();
+                    hashes.push_back(writableInput->getPreviousTxHash().value());
+                }
+            }
+            if (!store) {
+                return Future<bool>::successful(false);
+            }
+            return store->prefetch(hashes).map<bool>(ImmediateExecutionContext::INSTANCE, [] (const Unit&) {
+                return true;
+            });
+        }
+
         int32_t BitcoinLikeTransactionApi::getVersion() {
             return _version;
         }
@@ -123,6 +123,8 @@ namespace ledger {
             api::BitcoinLikeSignatureState setSignatures(const std::vector<api::BitcoinLikeSignature> & signatures, bool override = false) override;
 
             api::BitcoinLikeSignatureState setDERSignatures(const std::vector<std::vector<uint8_t>> & signatures, bool override = false) override;
+            void prefetchPreviousTransactions(const std::shared_ptr<api::BoolCallback> & callback) override;
+            Future<bool> prefetchPreviousTransactions();
 
             BitcoinLikeTransactionApi &addInput(const std::shared_ptr<BitcoinLikeWritableInputApi> &input);
 
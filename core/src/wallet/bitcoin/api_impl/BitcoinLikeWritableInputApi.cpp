@@ -44,8 +44,9 @@ namespace ledger {
                 const std::shared_ptr<api::Amount> &amount, const std::string &previousTxHash, int32_t index,
                 const std::vector<uint8_t> &scriptSig,
                 const std::shared_ptr<api::BitcoinLikeOutput> &previousOutput,
-                const std::string &keychainEngine) :
-                _explorer(explorer), _context(context), _sequence(sequence),
+                const std::string &keychainEngine,
+                const std::shared_ptr<BitcoinLikeRawTransactionStore> &rawTransactions) :
+                _explorer(explorer), _rawTransactions(rawTransactions), _context(context), _sequence(sequence),
                 _pubKeys(pubKeys), _paths(paths), _address(address), _index(index),
                 _amount(amount), _previousHash(previousTxHash),
                 _previousScript(previousOutput) {
@@ -131,11 +132,18 @@ namespace ledger {
         }
 
         Future<std::vector<uint8_t>> BitcoinLikeWritableInputApi::getPreviousTransaction() {
+            if (_rawTransactions) {
+                return _rawTransactions->getRawTransaction(getPreviousTxHash().value());
+            }
             return _explorer->getRawTransaction(getPreviousTxHash().value()).map<std::vector<uint8_t> >(_context,
                                                                                                         [](const Bytes &bytes) {
                                                                                                             return bytes.getContainer();
                                                                                                         });
         }
 
+        const std::shared_ptr<BitcoinLikeRawTransactionStore>& BitcoinLikeWritableInputApi::getRawTransactionStore() const {
+            return _rawTransactions;
+        }
+
     }
 }
\ No newline at end of file
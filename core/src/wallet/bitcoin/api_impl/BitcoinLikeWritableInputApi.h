@@ -36,6 +36,7 @@
 #include <wallet/bitcoin/BitcoinLikeAccount.hpp>
 #include <wallet/common/api_impl/DerivationPathApi.h>
 #include <wallet/bitcoin/scripts/BitcoinLikeScript.h>
+#include <wallet/bitcoin/BitcoinLikeRawTransactionStore.hpp>
 
 
 namespace ledger {
@@ -54,7 +55,8 @@ namespace ledger {
                     int32_t index,
                     const std::vector<uint8_t>& scriptSig,
                     const std::shared_ptr<api::BitcoinLikeOutput>& previousOutput,
-                    const std::string &keychainEngine = ""
+                    const std::string &keychainEngine = "",
+                    const std::shared_ptr<BitcoinLikeRawTransactionStore>& rawTransactions = nullptr
             );
             optional<std::string> getAddress() override;
             std::vector<std::vector<uint8_t>> getPublicKeys() override;
@@ -75,12 +77,14 @@ namespace ledger {
             int64_t getSequence() override;
             void getPreviousTransaction(const std::shared_ptr<api::BinaryCallback> &callback) override;
             Future<std::vector<uint8_t>> getPreviousTransaction();
+            const std::shared_ptr<BitcoinLikeRawTransactionStore>& getRawTransactionStore() const;
             void setP2PKHSigScript(const std::vector<uint8_t> &signature) override;
 
 
 
         private:
             std::shared_ptr<ledger::core::BitcoinLikeBlockchainExplorer> _explorer;
+            std::shared_ptr<BitcoinLikeRawTransactionStore> _rawTransactions;
             std::shared_ptr<ledger::core::api::ExecutionContext> _context;
             uint32_t _sequence;
             std::vector<std::vector<uint8_t> > _pubKeys;
@@ -235,7 +235,9 @@ namespace {
     };
 
     const auto UPSERT_OUTPUT = db::stmt<OutputBinding>(
-            "INSERT INTO bitcoin_outputs VALUES(:idx, :tx_uid, :hash, :amount, :script, :address, "
+            "INSERT INTO bitcoin_outputs(idx, transaction_uid, transaction_hash, amount, script, address, "
+            "account_uid, block_height, replaceable) "
+            "VALUES(:idx, :tx_uid, :hash, :amount, :script, :address, "
             ":account_uid, :block_height, :replaceable) "
             "ON CONFLICT DO NOTHING", [] (auto& s, auto&  b) {
                 s, use(b.index), use(b.txUid), use(b.txHash), use(b.amount),
@@ -251,7 +253,7 @@ namespace ledger {
                 const std::vector<Operation> &operations) {
             if (operations.empty())
                 return;
-            Benchmarker rawInsert("raw_db_insert", nullptr);
+            Benchmarker rawInsert("raw_db_insert", BENCHMARK_HISTOGRAM("raw_db_insert"), nullptr);
             rawInsert.start();
             PreparedStatement<OperationBinding> operationStmt;
             PreparedStatement<BlockBinding> blockStmt;
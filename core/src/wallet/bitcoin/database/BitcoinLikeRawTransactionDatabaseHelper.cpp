@@ -0,0 +1,128 @@
+/*
+ *
+ * BitcoinLikeRawTransactionDatabaseHelper
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "BitcoinLikeRawTransactionDatabaseHelper.h"
+#include <database/soci-backend-utils.h>
+#include <database/soci-number.h>
+#include <algorithm>
+#include <utils/hex.h>
+
+using namespace soci;
+
+namespace ledger {
+    namespace core {
+
+        void BitcoinLikeRawTransactionDatabaseHelper::getRawTransactions(soci::session& sql,
+                                                                         const std::string& currencyName,
+                                                                         const std::vector<std::string>& hashes,
+                                                                         int64_t usedAt,
+                                                                         std::unordered_map<std::string, std::vector<uint8_t>>& out) {
+            if (hashes.empty()) {
+                return;
+            }
+            const auto placeholders = in_placeholders(hashes.size());
+            std::vector<std::string> found;
+            {
+                details::prepare_temp_type query = (sql.prepare <<
+                        "SELECT hash, raw FROM bitcoin_raw_transactions "
+                        "WHERE currency_name = :currency AND hash IN (" << placeholders << ")", use(currencyName));
+                use_all(query, hashes);
+                rowset<row> rows(query);
+                for (auto& row : rows) {
+                    auto hash = row.get<std::string>(0);
+                    out[hash] = hex::toByteArray(row.get<std::string>(1));
+                    found.push_back(std::move(hash));
+                }
+            }
+            if (found.empty()) {
+                return;
+            }
+            details::prepare_temp_type update = (sql.prepare <<
+                    "UPDATE bitcoin_raw_transactions SET last_used = :used "
+                    "WHERE currency_name = :currency AND hash IN (" << in_placeholders(found.size()) << ")",
+                    use(usedAt), use(currencyName));
+            use_all(update, found);
+            statement(update).execute(true);
+        }
+
+        void BitcoinLikeRawTransactionDatabaseHelper::putRawTransaction(soci::session& sql,
+                                                                        const std::string& currencyName,
+                                                                        const std::string& hash,
+                                                                        const std::vector<uint8_t>& raw,
+                                                                        int64_t usedAt) {
+            const auto hexRaw = hex::toString(raw);
+            const auto size = static_cast<int64_t>(raw.size());
+            sql << "INSERT INTO bitcoin_raw_transactions VALUES(:currency, :hash, :raw, :size, :used) "
+                   "ON CONFLICT(currency_name, hash) DO UPDATE SET last_used = :last_used",
+                   use(currencyName), use(hash), use(hexRaw), use(size), use(usedAt), use(usedAt);
+        }
+
+        int64_t BitcoinLikeRawTransactionDatabaseHelper::getRawTransactionsSize(soci::session& sql,
+                                                                                const std::string& currencyName) {
+            int64_t size = 0;
+            sql << "SELECT COALESCE(SUM(size), 0) FROM bitcoin_raw_transactions WHERE currency_name = :currency",
+                   use(currencyName), into(size);
+            return size;
+        }
+
+        size_t BitcoinLikeRawTransactionDatabaseHelper::evictRawTransactions(soci::session& sql,
+                                                                             const std::string& currencyName,
+                                                                             int64_t maxSize) {
+            auto size = getRawTransactionsSize(sql, currencyName);
+            if (size <= maxSize) {
+                return 0;
+            }
+            std::vector<std::string> evicted;
+            {
+                rowset<row> rows = (sql.prepare <<
+                        "SELECT hash, size FROM bitcoin_raw_transactions "
+                        "WHERE currency_name = :currency ORDER BY last_used", use(currencyName));
+                for (auto& row : rows) {
+                    if (size <= maxSize) {
+                        break;
+                    }
+                    evicted.push_back(row.get<std::string>(0));
+                    size -= soci::get_number<int64_t>(row, 1);
+                }
+            }
+            for (size_t begin = 0; begin < evicted.size(); begin += MAX_IN_CLAUSE_SIZE) {
+                const auto end = std::min(evicted.size(), begin + MAX_IN_CLAUSE_SIZE);
+                std::vector<std::string> slice(evicted.begin() + begin, evicted.begin() + end);
+                details::prepare_temp_type deletion = (sql.prepare <<
+                        "DELETE FROM bitcoin_raw_transactions "
+                        "WHERE currency_name = :currency AND hash IN (" << in_placeholders(slice.size()) << ")",
+                        use(currencyName));
+                use_all(deletion, slice);
+                statement(deletion).execute(true);
+            }
+            return evicted.size();
+        }
+
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ *
+ * BitcoinLikeRawTransactionDatabaseHelper
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_BITCOINLIKERAWTRANSACTIONDATABASEHELPER_H
+#define LEDGER_CORE_BITCOINLIKERAWTRANSACTIONDATABASEHELPER_H
+
+#include <soci.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+        class BitcoinLikeRawTransactionDatabaseHelper {
+        public:
+            /**
+             * Get the serialized transactions with the given hashes and mark them as used.
+             * @param sql
+             * @param currencyName
+             * @param hashes At most soci::MAX_IN_CLAUSE_SIZE transaction hashes
+             * @param usedAt Time (ms since epoch) stored as the last use of the found transactions
+             * @param out Raw transactions indexed by hash, unknown hashes are skipped
+             */
+            static void getRawTransactions(soci::session& sql,
+                                           const std::string& currencyName,
+                                           const std::vector<std::string>& hashes,
+                                           int64_t usedAt,
+                                           std::unordered_map<std::string, std::vector<uint8_t>>& out);
+
+            static void putRawTransaction(soci::session& sql,
+                                          const std::string& currencyName,
+                                          const std::string& hash,
+                                          const std::vector<uint8_t>& raw,
+                                          int64_t usedAt);
+
+            /**
+             * Remove the least recently used transactions until the store is not bigger than maxSize.
+             * @return The number of removed transactions
+             */
+            static size_t evictRawTransactions(soci::session& sql, const std::string& currencyName, int64_t maxSize);
+
+            static int64_t getRawTransactionsSize(soci::session& sql, const std::string& currencyName);
+        };
+    }
+}
+
+#endif //LEDGER_CORE_BITCOINLIKERAWTRANSACTIONDATABASEHELPER_H
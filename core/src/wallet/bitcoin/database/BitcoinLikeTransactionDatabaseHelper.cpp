@@ -34,6 +34,7 @@
 #include <database/soci-option.h>
 #include <database/soci-date.h>
 #include <database/soci-number.h>
+#include <database/soci-backend-utils.h>
 
 #include <iostream>
 using namespace std;
@@ -79,33 +80,33 @@ namespace ledger {
             return false;
         }
 
-        bool BitcoinLikeTransactionDatabaseHelper::inflateTransaction(soci::session &sql,
-                                                                      const soci::row &row,
-                                                                      const std::string &accountUid,
-                                                                      BitcoinLikeBlockchainExplorerTransaction &out) {
-            out.hash = row.get<std::string>(0);
-            out.version = (uint32_t) row.get<int32_t>(1);
-            out.receivedAt = row.get<std::chrono::system_clock::time_point>(2);
-            out.lockTime = (uint64_t) row.get<int>(3);
-            if (row.get_indicator(4) != i_null) {
-                BitcoinLikeBlockchainExplorer::Block block;
-                block.hash = row.get<std::string>(4);
-                block.height = get_number<uint64_t>(row, 5);
-                block.time = row.get<std::chrono::system_clock::time_point>(6);
-                block.currencyName = row.get<std::string>(7);
-                out.block = block;
+        namespace {
+            // Columns of the transaction rows (optionally followed by other columns)
+            const char TRANSACTION_COLUMNS[] =
+                    "tx.hash, tx.version, tx.time, tx.locktime, "
+                    "block.hash, block.height, block.time, block.currency_name";
+
+            void inflateTransactionRow(const soci::row &row, BitcoinLikeBlockchainExplorerTransaction &out) {
+                out.hash = row.get<std::string>(0);
+                out.version = (uint32_t) row.get<int32_t>(1);
+                out.receivedAt = row.get<std::chrono::system_clock::time_point>(2);
+                out.lockTime = (uint64_t) row.get<int>(3);
+                if (row.get_indicator(4) != i_null) {
+                    BitcoinLikeBlockchainExplorer::Block block;
+                    block.hash = row.get<std::string>(4);
+                    block.height = get_number<uint64_t>(row, 5);
+                    block.time = row.get<std::chrono::system_clock::time_point>(6);
+                    block.currencyName = row.get<std::string>(7);
+                    out.block = block;
+                }
             }
 
-            auto btcTxUid = BitcoinLikeTransactionDatabaseHelper::createBitcoinTransactionUid(accountUid, out.hash);
+            // Columns of the input rows (optionally followed by other columns)
+            const char INPUT_COLUMNS[] =
+                    "ti.input_idx, i.previous_output_idx, i.previous_tx_hash, i.amount, i.address, i.coinbase,"
+                    "i.sequence";
 
-            // Fetch inputs
-            rowset<soci::row> inputRows = (sql.prepare <<
-                "SELECT ti.input_idx, i.previous_output_idx, i.previous_tx_hash, i.amount, i.address, i.coinbase,"
-                        "i.sequence "
-                "FROM bitcoin_transaction_inputs AS ti "
-                "INNER JOIN bitcoin_inputs AS i ON ti.input_uid = i.uid "
-                "WHERE ti.transaction_uid = :txuid ORDER BY ti.input_idx", use(btcTxUid));
-            for (auto& inputRow : inputRows) {
+            BitcoinLikeBlockchainExplorerInput inflateInputRow(const soci::row &inputRow) {
                 BitcoinLikeBlockchainExplorerInput input;
                 input.index = get_number<uint64_t>(inputRow, 0);
                 input.previousTxOutputIndex = inputRow.get<Option<int>>(1).map<uint32_t>([] (const int& v) {
@@ -118,7 +119,42 @@ namespace ledger {
                 input.address = inputRow.get<Option<std::string>>(4);
                 input.coinbase = inputRow.get<Option<std::string>>(5);
                 input.sequence = get_number<uint32_t>(inputRow, 6);
-                out.inputs.push_back(input);
+                return input;
+            }
+
+            // Columns of the output rows (optionally followed by other columns)
+            const char OUTPUT_COLUMNS[] = "idx, amount, script, address, block_height, replaceable";
+
+            BitcoinLikeBlockchainExplorerOutput inflateOutputRow(const soci::row &outputRow) {
+                BitcoinLikeBlockchainExplorerOutput output;
+                output.index = (uint64_t) outputRow.get<int>(0);
+                output.value.assignScalar(outputRow.get<long long>(1));
+                output.script = outputRow.get<std::string>(2);
+                output.address = outputRow.get<Option<std::string>>(3);
+                if (outputRow.get_indicator(4) != i_null) {
+                    output.blockHeight = soci::get_number<uint64_t>(outputRow, 4);
+                }
+                output.replaceable = soci::get_number<int>(outputRow, 5) == 1;
+                return output;
+            }
+        }
+
+        bool BitcoinLikeTransactionDatabaseHelper::inflateTransaction(soci::session &sql,
+                                                                      const soci::row &row,
+                                                                      const std::string &accountUid,
+                                                                      BitcoinLikeBlockchainExplorerTransaction &out) {
+            inflateTransactionRow(row, out);
+
+            auto btcTxUid = BitcoinLikeTransactionDatabaseHelper::createBitcoinTransactionUid(accountUid, out.hash);
+
+            // Fetch inputs
+            rowset<soci::row> inputRows = (sql.prepare <<
+                "SELECT " << INPUT_COLUMNS << " "
+                "FROM bitcoin_transaction_inputs AS ti "
+                "INNER JOIN bitcoin_inputs AS i ON ti.input_uid = i.uid "
+                "WHERE ti.transaction_uid = :txuid ORDER BY ti.input_idx", use(btcTxUid));
+            for (auto& inputRow : inputRows) {
+                out.inputs.push_back(inflateInputRow(inputRow));
             }
 
             // Fetch outputs
@@ -127,28 +163,67 @@ namespace ledger {
             //of same transaction (filter on account_uid won't solve the issue because
             //bitcoin_outputs going to external accounts have NULL account_uid)
             rowset<soci::row> outputRows = (sql.prepare <<
-                    "SELECT idx, amount, script, address, block_height, replaceable "
+                    "SELECT " << OUTPUT_COLUMNS << " "
                     "FROM bitcoin_outputs WHERE transaction_hash = :hash AND transaction_uid = :tx_uid "
                     "ORDER BY idx", use(out.hash), use(btcTxUid)
             );
 
             for (auto& outputRow : outputRows) {
-                BitcoinLikeBlockchainExplorerOutput output;
-                output.index = (uint64_t) outputRow.get<int>(0);
-                output.value.assignScalar(outputRow.get<long long>(1));
-                output.script = outputRow.get<std::string>(2);
-                output.address = outputRow.get<Option<std::string>>(3);
-                if (outputRow.get_indicator(4) != i_null) {
-                    output.blockHeight = soci::get_number<uint64_t>(outputRow, 4);
-                }
-                output.replaceable = soci::get_number<int>(outputRow, 5) == 1;
-                out.outputs.push_back(std::move(output));
+                out.outputs.push_back(inflateOutputRow(outputRow));
             }
 
             // Enjoy the silence.
             return true;
         }
 
+        void BitcoinLikeTransactionDatabaseHelper::getTransactionsByUids(
+                soci::session &sql,
+                const std::vector<std::string> &btcTxUids,
+                std::unordered_map<std::string, BitcoinLikeBlockchainExplorerTransaction> &out) {
+            if (btcTxUids.empty()) {
+                return;
+            }
+            const auto placeholders = in_placeholders(btcTxUids.size());
+
+            details::prepare_temp_type txStatement = (sql.prepare <<
+                    "SELECT " << TRANSACTION_COLUMNS << ", tx.transaction_uid "
+                    "FROM bitcoin_transactions AS tx "
+                    "LEFT JOIN blocks AS block ON tx.block_uid = block.uid "
+                    "WHERE tx.transaction_uid IN (" << placeholders << ")");
+            use_all(txStatement, btcTxUids);
+            rowset<row> txRows(txStatement);
+            for (auto& row : txRows) {
+                inflateTransactionRow(row, out[row.get<std::string>(8)]);
+            }
+
+            details::prepare_temp_type inputStatement = (sql.prepare <<
+                    "SELECT " << INPUT_COLUMNS << ", ti.transaction_uid "
+                    "FROM bitcoin_transaction_inputs AS ti "
+                    "INNER JOIN bitcoin_inputs AS i ON ti.input_uid = i.uid "
+                    "WHERE ti.transaction_uid IN (" << placeholders << ") ORDER BY ti.input_idx");
+            use_all(inputStatement, btcTxUids);
+            rowset<row> inputRows(inputStatement);
+            for (auto& inputRow : inputRows) {
+                auto tx = out.find(inputRow.get<std::string>(7));
+                if (tx != out.end()) {
+                    tx->second.inputs.push_back(inflateInputRow(inputRow));
+                }
+            }
+
+            details::prepare_temp_type outputStatement = (sql.prepare <<
+                    "SELECT " << OUTPUT_COLUMNS << ", transaction_uid "
+                    "FROM bitcoin_outputs WHERE transaction_uid IN (" << placeholders << ") "
+                    "ORDER BY idx");
+            use_all(outputStatement, btcTxUids);
+            rowset<row> outputRows(outputStatement);
+            for (auto& outputRow : outputRows) {
+                auto tx = out.find(outputRow.get<std::string>(6));
+                if (tx != out.end()) {
+                    tx->second.outputs.push_back(inflateOutputRow(outputRow));
+                }
+            }
+        }
+
         void
         BitcoinLikeTransactionDatabaseHelper::getMempoolTransactions(soci::session &sql, const std::string &accountUid,
                                                                      std::vector<BitcoinLikeBlockchainExplorerTransaction> &out) {
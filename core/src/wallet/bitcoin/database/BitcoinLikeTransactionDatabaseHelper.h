@@ -32,6 +32,7 @@
 #define LEDGER_CORE_BITCOINLIKETRANSACTIONDATABASEHELPER_H
 
 #include <soci.h>
+#include <unordered_map>
 #include <wallet/bitcoin/explorers/BitcoinLikeBlockchainExplorer.hpp>
 
 namespace ledger {
@@ -54,6 +55,17 @@ namespace ledger {
                                                   const std::string &accountUid,
                                                   BitcoinLikeBlockchainExplorerTransaction& out);
 
+            /**
+             * Get the transactions with the given uids (see createBitcoinTransactionUid) using a single
+             * query per table. Transactions are indexed by uid in the output, unknown uids are skipped.
+             * @param sql
+             * @param btcTxUids At most soci::MAX_IN_CLAUSE_SIZE transaction uids
+             * @param out
+             */
+            static void getTransactionsByUids(soci::session& sql,
+                                              const std::vector<std::string>& btcTxUids,
+                                              std::unordered_map<std::string, BitcoinLikeBlockchainExplorerTransaction>& out);
+
             /**
              * Get all mempool transactions for the given account from database.
              * @param sql
@@ -44,9 +44,7 @@ namespace ledger {
                                                              std::function<bool(const std::string &address)> filter) {
             rowset<row> rows = (sql.prepare <<
                                             "SELECT o.address FROM bitcoin_outputs AS o "
-                                                    " LEFT OUTER JOIN bitcoin_inputs AS i ON i.previous_tx_uid = o.transaction_uid "
-                                                    " AND i.previous_output_idx = o.idx"
-                                                    " WHERE i.previous_tx_uid IS NULL AND o.account_uid = :uid", use(accountUid));
+                                                    " WHERE o.account_uid = :uid AND o.spent = 0", use(accountUid));
             std::size_t count = 0;
             for (auto& row : rows) {
                 if (row.get_indicator(0) != i_null && filter(row.get<std::string>(0)))
@@ -63,9 +61,7 @@ namespace ledger {
                                             "SELECT o.address, o.idx, o.transaction_hash, o.amount, o.script, o.block_height,"
                                                     "replaceable"
                                                     " FROM bitcoin_outputs AS o "
-                                                    " LEFT OUTER JOIN bitcoin_inputs AS i ON i.previous_tx_uid = o.transaction_uid "
-                                                    " AND i.previous_output_idx = o.idx"
-                                                    " WHERE i.previous_tx_uid IS NULL AND o.account_uid = :uid"
+                                                    " WHERE o.account_uid = :uid AND o.spent = 0"
                                                     " ORDER BY block_height LIMIT :count OFFSET :off",
                                                     use(accountUid), use(count), use(offset));
 
@@ -95,8 +91,7 @@ namespace ledger {
                 session.prepare <<
                     "SELECT o.address, o.idx, o.transaction_hash, o.amount, o.script, o.block_height "
                     "FROM bitcoin_outputs AS o "
-                    "LEFT OUTER JOIN bitcoin_inputs AS i ON i.previous_tx_uid = o.transaction_uid AND i.previous_output_idx = o.idx "
-                    "WHERE i.previous_tx_uid IS NULL AND o.account_uid = :uid "
+                    "WHERE o.account_uid = :uid AND o.spent = 0 "
                     "ORDER BY o.block_height",
                 use(accountUid));
 
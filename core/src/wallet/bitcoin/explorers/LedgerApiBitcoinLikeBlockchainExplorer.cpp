@@ -57,7 +57,7 @@ namespace ledger {
             return _http->POST(fmt::format("/blockchain/{}/{}/transactions/send", getExplorerVersion(), getNetworkParameters().Identifier),
                                std::vector<uint8_t>(bodyString.begin(), bodyString.end()),
                                headers
-            ).json().template map<String>(getExplorerContext(), [] (const HttpRequest::JsonResult& result) -> String {
+            ).prioritized().json().template map<String>(getExplorerContext(), [] (const HttpRequest::JsonResult& result) -> String {
                 auto& json = *std::get<1>(result);
                 return json["result"].GetString();
             });
@@ -116,6 +116,7 @@ namespace ledger {
             bool parseNumbersAsString = true;
             auto networkId = getNetworkParameters().Identifier;
             return _http->GET(fmt::format("/blockchain/{}/{}/fees", getExplorerVersion(), networkId))
+                    .cached(std::chrono::seconds(30))
                     .json(parseNumbersAsString).map<std::vector<std::shared_ptr<api::BigInt>>>(getExplorerContext(), [networkId] (const HttpRequest::JsonResult& result) {
                         auto& json = *std::get<1>(result);
                         if (!json.IsObject()) {
@@ -139,35 +139,19 @@ namespace ledger {
             return true;
         }
 
-        //TODO the two following methods are similar. Merge them if possible
         std::vector<BitcoinLikeKeychain::Address> CommonBitcoinLikeKeychains::getAllObservableAddresses(uint32_t from, uint32_t to) {
             auto currency = getCurrency();
             std::vector<BitcoinLikeKeychain::Address> res;
             res.reserve((to - from + 1) * 2);
             auto preferencesEdit = getPreferences()->edit();
             bool hasDBChange = false;
-            for (int iPurpose : {KeyPurpose::RECEIVE, KeyPurpose::CHANGE})
+            for (auto purpose : {KeyPurpose::RECEIVE, KeyPurpose::CHANGE})
             {
-                for (int index = from; index <= to; index++)
+                auto addresses = getAddressRange(purpose, from, to, preferencesEdit, hasDBChange);
+                for (auto index = from; index <= to; index++)
                 {
-                    auto localPath = getDerivationScheme()
-                        .setAccountIndex(getAccountIndex())
-                        .setCoinType(currency.bip44CoinType)
-                        .setNode(iPurpose).setAddressIndex(index).getPath().toString();
-                    auto cacheKey = fmt::format("path:{}", localPath);
-                    auto address = getPreferences()->getString(cacheKey, "");
-
-                    if (address.empty()) {
-                        auto xpub = iPurpose == KeyPurpose::RECEIVE ? _publicNodeXpub : _internalNodeXpub;
-                        auto p = getDerivationScheme().getSchemeFrom(DerivationSchemeLevel::NODE).shift(1)
-                            .setAccountIndex(getAccountIndex())
-                            .setCoinType(currency.bip44CoinType)
-                            .setNode(iPurpose).setAddressIndex(index).getPath().toString();
-                        address = BitcoinLikeAddress::fromPublicKey(xpub, currency, p, _keychainEngine);
-                        preferencesEdit = preferencesEdit->putString(cacheKey, address)->putString(fmt::format("address:{}", address), localPath);
-                        hasDBChange = true;
-                    }
-                    res.emplace_back(std::dynamic_pointer_cast<BitcoinLikeAddress>(BitcoinLikeAddress::parse(address, getCurrency(), Option<std::string>(localPath))));
+                    auto localPath = getLocalPath(purpose, index);
+                    res.emplace_back(std::dynamic_pointer_cast<BitcoinLikeAddress>(BitcoinLikeAddress::parse(addresses[index - from], currency, Option<std::string>(localPath))));
                 }
             }
             if (hasDBChange) {
@@ -177,34 +161,16 @@ namespace ledger {
         }
 
         std::vector<std::string> CommonBitcoinLikeKeychains::getAllObservableAddressString(uint32_t from, uint32_t to) {
-            auto currency = getCurrency();
             std::vector<std::string> res;
             res.reserve((to - from + 1) * 2);
             auto preferencesEdit = getPreferences()->edit();
             bool hasDBChange = false;
-            for (int index = from; index <= to; index++)
+            auto receiveAddresses = getAddressRange(KeyPurpose::RECEIVE, from, to, preferencesEdit, hasDBChange);
+            auto changeAddresses = getAddressRange(KeyPurpose::CHANGE, from, to, preferencesEdit, hasDBChange);
+            for (auto index = from; index <= to; index++)
             {
-                for (int iPurpose : {KeyPurpose::RECEIVE, KeyPurpose::CHANGE})
-                {
-                    auto localPath = getDerivationScheme()
-                        .setAccountIndex(getAccountIndex())
-                        .setCoinType(currency.bip44CoinType)
-                        .setNode(iPurpose).setAddressIndex(index).getPath().toString();
-                    auto p = getDerivationScheme().getSchemeFrom(DerivationSchemeLevel::NODE).shift(1)
-                        .setAccountIndex(getAccountIndex())
-                        .setCoinType(currency.bip44CoinType)
-                        .setNode(iPurpose).setAddressIndex(index).getPath().toString();
-                    auto cacheKey = fmt::format("path:{}", localPath);
-                    auto address = getPreferences()->getString(cacheKey, "");
-
-                    if (address.empty()) {
-                        auto xpub = iPurpose == KeyPurpose::RECEIVE ? _publicNodeXpub : _internalNodeXpub;
-                        address = BitcoinLikeAddress::fromPublicKey(xpub, currency, p, _keychainEngine);
-                        preferencesEdit = preferencesEdit->putString(cacheKey, address)->putString(fmt::format("address:{}", address), localPath);
-                        hasDBChange = true;
-                    }
-                    res.emplace_back(address);
-                }
+                res.emplace_back(receiveAddresses[index - from]);
+                res.emplace_back(changeAddresses[index - from]);
             }
             if (hasDBChange) {
                 preferencesEdit->commit();
@@ -212,6 +178,74 @@ namespace ledger {
             return res;
         }
 
+        std::vector<std::string> CommonBitcoinLikeKeychains::getAddressRange(KeyPurpose purpose, uint32_t from, uint32_t to,
+                                                                             std::shared_ptr<api::PreferencesEditor> &preferencesEdit,
+                                                                             bool &hasDBChange) {
+            std::vector<std::string> addresses(to - from + 1);
+            bool hasMissingAddress = false;
+            uint32_t firstMissingIndex = 0, lastMissingIndex = 0;
+            for (auto index = from; index <= to; index++) {
+                auto &address = addresses[index - from];
+                address = getPreferences()->getString(fmt::format("path:{}", getLocalPath(purpose, index)), "");
+                if (address.empty()) {
+                    if (!hasMissingAddress) {
+                        firstMissingIndex = index;
+                        hasMissingAddress = true;
+                    }
+                    lastMissingIndex = index;
+                }
+            }
+
+            if (hasMissingAddress) {
+                auto derived = deriveAddresses(purpose, firstMissingIndex, lastMissingIndex);
+                for (auto index = firstMissingIndex; index <= lastMissingIndex; index++) {
+                    auto &address = addresses[index - from];
+                    if (!address.empty()) {
+                        continue;
+                    }
+                    auto localPath = getLocalPath(purpose, index);
+                    address = derived[index - firstMissingIndex];
+                    preferencesEdit = preferencesEdit->putString(fmt::format("path:{}", localPath), address)->putString(fmt::format("address:{}", address), localPath);
+                    hasDBChange = true;
+                }
+            }
+
+            for (auto index = from; index <= to; index++) {
+                indexAddress(addresses[index - from], purpose, index);
+            }
+            return addresses;
+        }
+
+        std::vector<std::string> CommonBitcoinLikeKeychains::deriveAddresses(KeyPurpose purpose, uint32_t from, uint32_t to) {
+            auto currency = getCurrency();
+            auto iPurpose = (purpose == KeyPurpose::RECEIVE) ? 0 : 1;
+            auto xpub = purpose == KeyPurpose::RECEIVE ? _publicNodeXpub : _internalNodeXpub;
+            auto getRelativePath = [&] (uint32_t index) {
+                return getDerivationScheme().getSchemeFrom(DerivationSchemeLevel::NODE).shift(1)
+                        .setAccountIndex(getAccountIndex())
+                        .setCoinType(currency.bip44CoinType)
+                        .setNode(iPurpose)
+                        .setAddressIndex((int) index).getPath();
+            };
+
+            std::vector<std::string> addresses;
+            addresses.reserve(to - from + 1);
+            auto firstPath = getRelativePath(from);
+            if (firstPath.getDepth() == 1 && firstPath.getLastChildNum() == from) {
+                // Addresses are direct children of the node, derive the whole range from the parsed node key
+                auto publicKeys = std::static_pointer_cast<BitcoinLikeExtendedPublicKey>(xpub)->deriveChildrenPublicKeys(from, to);
+                for (const auto &publicKey : publicKeys) {
+                    auto hash160 = BitcoinLikeAddress::fromPublicKeyToHash160(publicKey, currency, _keychainEngine);
+                    addresses.emplace_back(BitcoinLikeAddress(currency, hash160, _keychainEngine).toString());
+                }
+            } else {
+                for (auto index = from; index <= to; index++) {
+                    addresses.emplace_back(BitcoinLikeAddress::fromPublicKey(xpub, currency, getRelativePath(index).toString(), _keychainEngine));
+                }
+            }
+            return addresses;
+        }
+
         BitcoinLikeKeychain::Address CommonBitcoinLikeKeychains::getFreshAddress(BitcoinLikeKeychain::KeyPurpose purpose) {
             KeychainPersistentState state = getState();
             return derive(purpose, (purpose == KeyPurpose::RECEIVE ? state.maxConsecutiveReceiveIndex : state.maxConsecutiveChangeIndex));
@@ -234,21 +268,17 @@ namespace ledger {
 
         Option<BitcoinLikeKeychain::KeyPurpose>
         CommonBitcoinLikeKeychains::getAddressPurpose(const std::string &address) const {
-            return getAddressDerivationPath(address).flatMap<KeyPurpose>([] (const std::string& p) {
-                DerivationPath derivation(p);
-                if (derivation.getDepth() > 1) {
-                    return Option<KeyPurpose>(derivation.getParent().getLastChildNum() == 0 ? KeyPurpose::RECEIVE : KeyPurpose::CHANGE);
-                } else {
-                    return Option<KeyPurpose>();
-                }
+            return findAddress(address).map<KeyPurpose>([] (const AddressIndexEntry& entry) {
+                return entry.purpose;
             });
         }
 
         Option<std::string> CommonBitcoinLikeKeychains::getAddressDerivationPath(const std::string &address) const {
-            auto path = getPreferences()->getString(fmt::format("address:{}", address), "");
-            if (path.empty()) {
+            auto entry = findAddress(address);
+            if (entry.isEmpty()) {
                 return Option<std::string>();
             } else {
+                auto path = getLocalPath(entry.getValue().purpose, entry.getValue().index);
                 auto derivation = DerivationPath(getExtendedPublicKey()->getRootPath()) + DerivationPath(path);
                 return Option<std::string>(derivation.toString());
             }
@@ -301,7 +331,7 @@ namespace ledger {
         }
 
         bool CommonBitcoinLikeKeychains::contains(const std::string &address) const {
-            return getAddressDerivationPath(address).nonEmpty();
+            return findAddress(address).nonEmpty();
         }
 
         std::vector<BitcoinLikeKeychain::Address> CommonBitcoinLikeKeychains::getAllAddresses() {
@@ -322,10 +352,11 @@ namespace ledger {
         }
 
         Option<std::vector<uint8_t>> CommonBitcoinLikeKeychains::getPublicKey(const std::string &address) const {
-            auto path = getPreferences()->getString(fmt::format("address:{}", address), "");
-            if (path.empty()) {
-                Option<std::vector<uint8_t>>();
+            auto entry = findAddress(address);
+            if (entry.isEmpty()) {
+                return Option<std::vector<uint8_t>>();
             }
+            auto path = getLocalPath(entry.getValue().purpose, entry.getValue().index);
             return Option<std::vector<uint8_t>>(_xpub->derivePublicKey(path));
         }
 
@@ -358,8 +389,53 @@ namespace ledger {
                         ->putString(fmt::format("address:{}", address), localPath)
                         ->commit();
             }
+            indexAddress(address, purpose, (uint32_t) index);
             return std::dynamic_pointer_cast<BitcoinLikeAddress>(BitcoinLikeAddress::parse(address, getCurrency(), Option<std::string>(localPath)));
         }
+
+        std::string CommonBitcoinLikeKeychains::getLocalPath(KeyPurpose purpose, uint32_t index) const {
+            auto scheme = getDerivationScheme();
+            return scheme
+                    .setAccountIndex(getAccountIndex())
+                    .setCoinType(getCurrency().bip44CoinType)
+                    .setNode(purpose == KeyPurpose::RECEIVE ? 0 : 1)
+                    .setAddressIndex((int) index).getPath().toString();
+        }
+
+        void CommonBitcoinLikeKeychains::indexAddress(const std::string &address, KeyPurpose purpose, uint32_t index) const {
+            std::lock_guard<std::mutex> lock(_addressIndexLock);
+            _addressIndex[address] = AddressIndexEntry {purpose, index};
+        }
+
+        Option<CommonBitcoinLikeKeychains::AddressIndexEntry> CommonBitcoinLikeKeychains::findAddress(const std::string &address) const {
+            std::lock_guard<std::mutex> lock(_addressIndexLock);
+            if (!_isAddressIndexLoaded) {
+                loadAddressIndex();
+                _isAddressIndexLoaded = true;
+            }
+            auto it = _addressIndex.find(address);
+            if (it == _addressIndex.end()) {
+                return Option<AddressIndexEntry>();
+            }
+            return Option<AddressIndexEntry>(it->second);
+        }
+
+        void CommonBitcoinLikeKeychains::loadAddressIndex() const {
+            // Addresses are derived by contiguous ranges, so the derivation cache is scanned for each
+            // purpose until more than an observable range of consecutive indexes is missing
+            for (auto purpose : {KeyPurpose::RECEIVE, KeyPurpose::CHANGE}) {
+                uint32_t missing = 0;
+                for (uint32_t index = 0; missing <= _observableRange; index++) {
+                    auto address = getPreferences()->getString(fmt::format("path:{}", getLocalPath(purpose, index)), "");
+                    if (address.empty()) {
+                        missing += 1;
+                        continue;
+                    }
+                    missing = 0;
+                    _addressIndex.emplace(address, AddressIndexEntry {purpose, index});
+                }
+            }
+        }
     }
 }
 
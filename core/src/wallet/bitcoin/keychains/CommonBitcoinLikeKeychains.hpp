@@ -33,6 +33,8 @@
 
 #include "BitcoinLikeKeychain.hpp"
 #include <set>
+#include <mutex>
+#include <unordered_map>
 #include "../../../collections/DynamicObject.hpp"
 #include <bitcoin/BitcoinLikeAddress.hpp>
 
@@ -102,10 +104,43 @@ namespace ledger {
             std::string _keychainEngine;
 
         private:
+            struct AddressIndexEntry {
+                KeyPurpose purpose;
+                uint32_t index;
+            };
+
             BitcoinLikeKeychain::Address derive(KeyPurpose purpose, off_t index);
             void saveState(KeychainPersistentState state) const;
-            
+            std::string getLocalPath(KeyPurpose purpose, uint32_t index) const;
+
+            /**
+             * @brief Get the addresses of a purpose from index `from` to index `to` (both included). Addresses
+             * missing from the preferences cache are derived as a single range and added to the given editor.
+             */
+            std::vector<std::string> getAddressRange(KeyPurpose purpose, uint32_t from, uint32_t to,
+                                                     std::shared_ptr<api::PreferencesEditor> &preferencesEdit,
+                                                     bool &hasDBChange);
+            std::vector<std::string> deriveAddresses(KeyPurpose purpose, uint32_t from, uint32_t to);
+
+            /**
+             * @brief Register a derived address in the in-memory address index
+             */
+            void indexAddress(const std::string &address, KeyPurpose purpose, uint32_t index) const;
+
+            /**
+             * @brief Look an address up in the in-memory address index, loading the index
+             * from preferences on first use
+             *
+             * @return the purpose and index of the address if it belongs to the keychain
+             */
+            Option<AddressIndexEntry> findAddress(const std::string &address) const;
+            void loadAddressIndex() const;
+
             std::shared_ptr<api::BitcoinLikeExtendedPublicKey> _xpub;
+            // Ownership checks are served from this index instead of preferences lookups
+            mutable std::mutex _addressIndexLock;
+            mutable bool _isAddressIndexLoaded {false};
+            mutable std::unordered_map<std::string, AddressIndexEntry> _addressIndex;
         };
     }
 }
@@ -56,6 +56,8 @@ namespace ledger {
                 std::shared_ptr<AbstractWallet> wallet;
                 std::shared_ptr<DynamicObject> configuration;
                 uint32_t halfBatchSize;
+                uint32_t maxParallelBatches;
+                std::mutex synchronizationLock;
                 std::shared_ptr<BitcoinLikeKeychain> keychain;
                 Option<BlockchainExplorerAccountSynchronizationSavedState> savedState;
                 std::shared_ptr<BitcoinLikeAccount> account;
@@ -96,6 +98,7 @@ namespace ledger {
             Future<Unit> synchronizeBatches(uint32_t currentBatchIndex, std::shared_ptr<SynchronizationBuddy> buddy);
             Future<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>> getTransactionBulk(int currentBatchIndex, const std::shared_ptr<SynchronizationBuddy>& buddy);
             Future<bool> synchronizeBatch(uint32_t currentBatchIndex, std::shared_ptr<SynchronizationBuddy> buddy, bool hadTransactions = false);
+            Future<bool> interpretBatch(uint32_t currentBatchIndex, std::shared_ptr<SynchronizationBuddy> buddy, Future<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>> bulk, bool hadTransactions);
             Future<std::vector<std::shared_ptr<BitcoinLikeBlockchainExplorer::TransactionsBulk>>> requestTransactionsFromExplorer(const std::shared_ptr<SynchronizationBuddy>& buddy);
             static std::pair<std::string, Option<std::string>> getHashkeyAndBlockhash(int currentBatchIndex, const std::shared_ptr<SynchronizationBuddy>& buddy);
 
@@ -43,7 +43,8 @@ namespace ledger {
     namespace core {
 
         BitcoinLikeStrategyUtxoPicker::BitcoinLikeStrategyUtxoPicker(const std::shared_ptr<api::ExecutionContext> &context,
-                                                                     const api::Currency &currency) : BitcoinLikeUtxoPicker(context, currency) {
+                                                                     const api::Currency &currency,
+                                                                     int32_t maxParallelLookups) : BitcoinLikeUtxoPicker(context, currency, maxParallelLookups) {
 
         }
 
@@ -85,21 +86,14 @@ namespace ledger {
 
         Future<BigInt> BitcoinLikeStrategyUtxoPicker::computeAggregatedAmount(
             const std::shared_ptr<BitcoinLikeUtxoPicker::Buddy> &buddy) {
-            // NOTE: We can turn that lambda to a free function and pass the context and the buddy as arguments
-            auto go = [context = getContext(), buddy] (auto go, auto it, auto v) {
-                if (it == buddy->request.inputs.end())
-                    return Future<BigInt>::successful(v);
-                const auto& i = *it;
-                const auto outputIndex = i.outputIndex;
-                // NOTE: why always 1 ?
-                buddy->logger->info("GET TX 1");
-                return buddy->getTransaction(i.transactionHash).template flatMap<BigInt>(context, [=] (auto const& tx) mutable {
-                    buddy->logger->info("GOT TX 1");
-                    return go(go, ++it, v + tx->outputs[outputIndex].value);
-                });
-            };
-            // NOTE: we can now use buddy->transaction->inputs which is filled during fillInputs by user inputs
-            return go(go, buddy->request.inputs.begin(), BigInt());
+            // The transactions are looked up once here and reused when the inputs are filled
+            return resolveInputTransactions(buddy).map<BigInt>(getContext(), [buddy] (const Unit&) {
+                BigInt amount;
+                for (auto const &input : buddy->request.inputs) {
+                    amount = amount + buddy->inputTransactions.at(input.transactionHash)->outputs[input.outputIndex].value;
+                }
+                return amount;
+            });
         }
 
         std::vector<BitcoinLikeUtxo>
@@ -45,7 +45,8 @@ namespace ledger {
         class BitcoinLikeStrategyUtxoPicker : public BitcoinLikeUtxoPicker {
         public:
             BitcoinLikeStrategyUtxoPicker(const std::shared_ptr<api::ExecutionContext> &context,
-                                          const api::Currency &currency);
+                                          const api::Currency &currency,
+                                          int32_t maxParallelLookups = api::ConfigurationDefaults::DEFAULT_TRANSACTION_BUILDER_MAX_PARALLEL_LOOKUPS);
         public:
             static std::vector<BitcoinLikeUtxo> filterWithKnapsackSolver(const std::shared_ptr<Buddy>& buddy,
                 const std::vector<BitcoinLikeUtxo>& utxos,
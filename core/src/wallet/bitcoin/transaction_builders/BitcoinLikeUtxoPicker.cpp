@@ -35,13 +35,18 @@
 #include <api/BitcoinLikeScriptChunk.hpp>
 #include <wallet/bitcoin/api_impl/BitcoinLikeScriptApi.h>
 #include <wallet/bitcoin/api_impl/BitcoinLikeTransactionApi.h>
+#include <async/algorithm.h>
+#include <atomic>
+#include <unordered_set>
 
 namespace ledger {
     namespace core {
 
         BitcoinLikeUtxoPicker::BitcoinLikeUtxoPicker(const std::shared_ptr<api::ExecutionContext> &context,
-                                                     const api::Currency &currency) : DedicatedContext(context),
-                                                                                      _currency(currency)
+                                                     const api::Currency &currency,
+                                                     int32_t maxParallelLookups) : DedicatedContext(context),
+                                                                                   _currency(currency),
+                                                                                   _maxParallelLookups(std::max(maxParallelLookups, 1))
         {}
 
         BitcoinLikeTransactionBuildFunction
@@ -51,7 +56,8 @@ namespace ledger {
                                                 const std::shared_ptr<BitcoinLikeKeychain> &keychain,
                                                 const uint64_t currentBlockHeight,
                                                 const std::shared_ptr<spdlog::logger>& logger,
-                                                bool partial)
+                                                bool partial,
+                                                const std::shared_ptr<BitcoinLikeRawTransactionStore>& rawTransactions)
         {
             auto self = shared_from_this();
             logger->info("Get build function");
@@ -60,7 +66,7 @@ namespace ledger {
                     logger->info("{} Constructing BitcoinLikeTransactionBuildFunction with blockHeight: {}", CORRELATIONID_PREFIX(r.correlationId), currentBlockHeight);
                     auto tx = std::make_shared<BitcoinLikeTransactionApi>(self->_currency, r.correlationId, keychain->getKeychainEngine(), currentBlockHeight);
                     auto filteredGetUtxo = createFilteredUtxoFunction(r, keychain, getUtxo);
-                    return std::make_shared<Buddy>(r, filteredGetUtxo, getTransaction, explorer, keychain, logger, tx, partial);
+                    return std::make_shared<Buddy>(r, filteredGetUtxo, getTransaction, explorer, keychain, logger, tx, partial, rawTransactions);
                 }).flatMap<std::shared_ptr<api::BitcoinLikeTransaction>>(self->getContext(), [=] (const std::shared_ptr<Buddy>& buddy) -> Future<std::shared_ptr<api::BitcoinLikeTransaction>> {
                     buddy->logger->info("Buddy created");
                     return self->fillInputs(buddy).flatMap<Unit>(self->getContext(), [=] (const Unit&) -> Future<Unit> {
@@ -164,25 +170,15 @@ namespace ledger {
 
             auto self = shared_from_this();
 
-            auto performFill = [self, buddy](auto performFill, auto index)
-            {
-                if (index >= buddy->request.inputs.size()) {
-                    return Future<Unit>::successful(unit);
-                }
-
-                auto const &input = buddy->request.inputs[index];
-
-                return buddy->getTransaction(input.transactionHash).template flatMap<Unit>(self->getContext(), [=](auto const &tx) {
-                    auto const utxo = makeUtxo(tx->outputs[input.outputIndex], self->getCurrency());
-
-                    self->fillInput(buddy, utxo, input.sequence);
-
-                    return performFill(performFill, index + 1);
-                });
-            };
-
-            // first fill inputs from user-defined input descriptors
-            return performFill(performFill, 0)
+            // first fill inputs from user-defined input descriptors, in the order of the request
+            return resolveInputTransactions(buddy)
+                .template map<Unit>(getContext(), [self, buddy](auto const&) {
+                    for (auto const &input : buddy->request.inputs) {
+                        auto const &tx = buddy->inputTransactions.at(input.transactionHash);
+                        self->fillInput(buddy, makeUtxo(tx->outputs[input.outputIndex], self->getCurrency()), input.sequence);
+                    }
+                    return unit;
+                })
                 .filter(getContext(), [buddy](auto const&) {
                     return buddy->request.utxoPicker.nonEmpty();
                 })
@@ -204,6 +200,52 @@ namespace ledger {
                 });
         }
 
+        Future<Unit> BitcoinLikeUtxoPicker::resolveInputTransactions(const std::shared_ptr<Buddy>& buddy) {
+            if (buddy->inputTransactionsResolution.nonEmpty()) {
+                return buddy->inputTransactionsResolution.getValue();
+            }
+
+            auto hashes = std::make_shared<std::vector<std::string>>();
+            std::unordered_set<std::string> seen;
+            for (auto const &input : buddy->request.inputs) {
+                if (seen.insert(input.transactionHash).second) {
+                    hashes->push_back(input.transactionHash);
+                }
+            }
+
+            // Each lane picks the next hash to look up until none is left, so that at most
+            // _maxParallelLookups requests are in flight whatever the number of inputs is.
+            // Results are written at the index of their hash, lanes never touch the same slot.
+            auto next = std::make_shared<std::atomic<size_t>>(0);
+            auto results = std::make_shared<std::vector<std::shared_ptr<BitcoinLikeBlockchainExplorerTransaction>>>(hashes->size());
+            auto context = getContext();
+            auto lookup = [=] (auto lookup) -> Future<Unit> {
+                auto const index = next->fetch_add(1);
+                if (index >= hashes->size()) {
+                    return Future<Unit>::successful(unit);
+                }
+                return buddy->getTransaction((*hashes)[index]).template flatMap<Unit>(context, [=] (auto const &tx) {
+                    (*results)[index] = tx;
+                    return lookup(lookup);
+                });
+            };
+
+            std::vector<Future<Unit>> lanes;
+            auto const laneCount = std::min(hashes->size(), static_cast<size_t>(_maxParallelLookups));
+            for (size_t lane = 0; lane < laneCount; lane++) {
+                lanes.push_back(lookup(lookup));
+            }
+
+            auto resolution = async::sequence(context, lanes).template map<Unit>(context, [=] (auto const&) {
+                for (size_t index = 0; index < hashes->size(); index++) {
+                    buddy->inputTransactions[(*hashes)[index]] = (*results)[index];
+                }
+                return unit;
+            });
+            buddy->inputTransactionsResolution = resolution;
+            return resolution;
+        }
+
         void BitcoinLikeUtxoPicker::fillInput(const std::shared_ptr<BitcoinLikeUtxoPicker::Buddy> &buddy,
                                               const BitcoinLikeUtxo &utxo,
                                               const uint32_t sequence) {
@@ -234,7 +276,9 @@ namespace ledger {
                             utxo.transactionHash,
                             utxo.index,
                             {},
-                            std::make_shared<BitcoinLikeOutputApi>(toExplorerOutput(utxo), _currency)
+                            std::make_shared<BitcoinLikeOutputApi>(toExplorerOutput(utxo), _currency),
+                            buddy->keychain->getKeychainEngine(),
+                            buddy->rawTransactions
                         )
                 );
                 buddy->transaction->addInput(input);
@@ -38,6 +38,7 @@
 #include <wallet/bitcoin/types.h>
 #include <wallet/bitcoin/explorers/BitcoinLikeBlockchainExplorer.hpp>
 #include <api/Currency.hpp>
+#include <api/ConfigurationDefaults.hpp>
 #include <async/Future.hpp>
 #include <api/BitcoinLikeOutput.hpp>
 #include <wallet/bitcoin/transaction_builders/BitcoinLikeUtxo.hpp>
@@ -46,6 +47,7 @@ namespace ledger {
     namespace core {
         class BitcoinLikeTransactionApi;
         class BitcoinLikeWritableInputApi;
+        class BitcoinLikeRawTransactionStore;
         using BitcoinLikeGetUtxoFunction = std::function<Future<std::vector<BitcoinLikeUtxo>>()>;
         using BitcoinLikeGetTxFunction = std::function<FuturePtr<BitcoinLikeBlockchainExplorerTransaction>(const std::string&)>;
 
@@ -53,7 +55,8 @@ namespace ledger {
         public:
             BitcoinLikeUtxoPicker(
                     const std::shared_ptr<api::ExecutionContext> &context,
-                    const api::Currency& currency
+                    const api::Currency& currency,
+                    int32_t maxParallelLookups = api::ConfigurationDefaults::DEFAULT_TRANSACTION_BUILDER_MAX_PARALLEL_LOOKUPS
             );
             virtual BitcoinLikeTransactionBuildFunction getBuildFunction(
                     const BitcoinLikeGetUtxoFunction& getUtxo,
@@ -62,7 +65,8 @@ namespace ledger {
                     const std::shared_ptr<BitcoinLikeKeychain>& keychain,
                     const uint64_t currentBlockHeight,
                     const std::shared_ptr<spdlog::logger>& logger,
-                    bool partial);
+                    bool partial,
+                    const std::shared_ptr<BitcoinLikeRawTransactionStore>& rawTransactions = nullptr);
             const api::Currency& getCurrency() const;
 
             struct Buddy {
@@ -74,8 +78,10 @@ namespace ledger {
                         const std::shared_ptr<BitcoinLikeKeychain>& k,
                         const std::shared_ptr<spdlog::logger>& l,
                         std::shared_ptr<BitcoinLikeTransactionApi> t,
-                        bool partial) : request(r), explorer(e), keychain(k), transaction(t), getUtxo(g),
-                          getTransaction(tx), logger(l), isPartial(partial)
+                        bool partial,
+                        const std::shared_ptr<BitcoinLikeRawTransactionStore>& raw = nullptr)
+                        : request(r), explorer(e), keychain(k), transaction(t), getUtxo(g),
+                          getTransaction(tx), logger(l), isPartial(partial), rawTransactions(raw)
                 {
                     if(request.wipe) {
                         outputAmount = ledger::core::BigInt::ZERO;
@@ -94,12 +100,24 @@ namespace ledger {
                 std::shared_ptr<spdlog::logger> logger;
                 BigInt changeAmount;
                 bool isPartial;
+                // Optional, previous transactions of the inputs are fetched from the explorer without it
+                std::shared_ptr<BitcoinLikeRawTransactionStore> rawTransactions;
+                // Transactions referenced by request.inputs, looked up once per build and shared by all the
+                // phases (see resolveInputTransactions)
+                Option<Future<Unit>> inputTransactionsResolution;
+                std::unordered_map<std::string, std::shared_ptr<BitcoinLikeBlockchainExplorerTransaction>> inputTransactions;
             };
         protected:
             virtual Future<Unit> fillInputs(const std::shared_ptr<Buddy>& buddy);
             virtual Future<std::vector<BitcoinLikeUtxo>> filterInputs(const std::shared_ptr<Buddy>& buddy) = 0;
             virtual Future<Unit> fillOutputs(const std::shared_ptr<Buddy>& buddy);
             virtual Future<Unit> fillTransactionInfo(const std::shared_ptr<Buddy>& buddy);
+            /**
+             * Look up the transactions referenced by the request inputs, at most _maxParallelLookups at once.
+             * The lookups are only performed by the first call for a given buddy, the result is then
+             * available in buddy->inputTransactions.
+             */
+            Future<Unit> resolveInputTransactions(const std::shared_ptr<Buddy>& buddy);
 
         private:
             void fillInput(const std::shared_ptr<Buddy>& buddy, const BitcoinLikeUtxo& utxo, const uint32_t sequence);
@@ -108,6 +126,7 @@ namespace ledger {
                                                                   const BitcoinLikeGetUtxoFunction& getUtxo);
         protected:
             api::Currency _currency;
+            int32_t _maxParallelLookups;
         };
     }
 }
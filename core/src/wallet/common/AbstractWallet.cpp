@@ -361,7 +361,9 @@ namespace ledger {
 
                 for (auto& account : accounts) {
                     if (account.get_indicator(0) != soci::i_null) {
-                        self->_accounts.erase(account.get<int32_t>(0));
+                        auto index = account.get<int32_t>(0);
+                        self->_accounts.erase(index);
+                        self->getPool()->getPushSynchronizer()->unsubscribe(AccountDatabaseHelper::createAccountUid(uid, index));
                     }
                 }
                 sql << "DELETE FROM accounts WHERE wallet_uid = :wallet_uid AND created_at >= :date", soci::use(uid), soci::use(date);
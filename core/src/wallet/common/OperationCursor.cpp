@@ -0,0 +1,81 @@
+/*
+ *
+ * OperationCursor
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "OperationCursor.h"
+
+namespace ledger {
+    namespace core {
+
+        OperationCursor::OperationCursor(const std::shared_ptr<OperationQuery> &query,
+                                         int32_t chunkSize,
+                                         bool descending)
+            : _query(query), _chunkSize(chunkSize), _descending(descending), _exhausted(false) {
+
+        }
+
+        std::shared_ptr<OperationCursor> OperationCursor::startAfter(const std::chrono::system_clock::time_point &date,
+                                                                     const std::string &uid) {
+            std::lock_guard<std::mutex> lock(_lock);
+            _lastKey = Option<OperationKey>(OperationKey{date, uid});
+            _exhausted = false;
+            return shared_from_this();
+        }
+
+        Future<std::vector<std::shared_ptr<api::Operation>>> OperationCursor::next() {
+            auto self = shared_from_this();
+            return _query->async<std::vector<std::shared_ptr<api::Operation>>>([self] () {
+                std::lock_guard<std::mutex> lock(self->_lock);
+                std::vector<std::shared_ptr<api::Operation>> operations;
+                if (self->_exhausted) {
+                    return operations;
+                }
+                self->_query->seek(self->_lastKey, self->_descending);
+                self->_query->_builder.offset(0).limit(self->_chunkSize);
+                self->_query->performExecute(operations);
+
+                self->_exhausted = operations.size() < static_cast<std::size_t>(self->_chunkSize);
+                if (!operations.empty()) {
+                    const auto& last = operations.back();
+                    self->_lastKey = Option<OperationKey>(OperationKey{last->getDate(), last->getUid()});
+                }
+                return operations;
+            });
+        }
+
+        bool OperationCursor::hasNext() const {
+            std::lock_guard<std::mutex> lock(_lock);
+            return !_exhausted;
+        }
+
+        Option<OperationKey> OperationCursor::getLastKey() const {
+            std::lock_guard<std::mutex> lock(_lock);
+            return _lastKey;
+        }
+
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ *
+ * OperationCursor
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_OPERATIONCURSOR_H
+#define LEDGER_CORE_OPERATIONCURSOR_H
+
+#include <api/Operation.hpp>
+#include <async/Future.hpp>
+#include <utils/Option.hpp>
+#include "OperationQuery.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+        /**
+         * Streams the result of an operation query by chunks, using keyset pagination: each chunk
+         * resumes right after the (date, uid) key of the last operation of the previous one.
+         * Chunks must be requested one after the other (wait for a chunk before asking the next one).
+         */
+        class OperationCursor : public std::enable_shared_from_this<OperationCursor> {
+        public:
+            OperationCursor(const std::shared_ptr<OperationQuery>& query, int32_t chunkSize, bool descending);
+
+            /**
+             * Resume the cursor after the given operation key (e.g. the last key of a previous cursor).
+             */
+            std::shared_ptr<OperationCursor> startAfter(const std::chrono::system_clock::time_point& date,
+                                                        const std::string& uid);
+
+            /**
+             * Fetch the next chunk of operations, an empty chunk means the cursor is exhausted.
+             */
+            Future<std::vector<std::shared_ptr<api::Operation>>> next();
+
+            bool hasNext() const;
+
+            /**
+             * Key of the last operation returned by the cursor, if any.
+             */
+            Option<OperationKey> getLastKey() const;
+
+        private:
+            std::shared_ptr<OperationQuery> _query;
+            const int32_t _chunkSize;
+            const bool _descending;
+            mutable std::mutex _lock;
+            Option<OperationKey> _lastKey;
+            bool _exhausted;
+        };
+    }
+}
+
+
+#endif //LEDGER_CORE_OPERATIONCURSOR_H
@@ -41,6 +41,9 @@
 #include <wallet/tezos/database/TezosLikeTransactionDatabaseHelper.h>
 #include <wallet/stellar/database/StellarLikeTransactionDatabaseHelper.hpp>
 #include <wallet/algorand/database/AlgorandTransactionDatabaseHelper.hpp>
+#include "OperationCursor.h"
+#include <database/soci-backend-utils.h>
+#include <algorithm>
 
 namespace ledger {
     namespace core {
@@ -57,12 +60,14 @@ namespace ledger {
         }
 
         std::shared_ptr<api::OperationQuery> OperationQuery::addOrder(api::OperationOrderKey key, bool descending) {
+            // Amounts, fees and dates are sorted on their typed columns (see migration 31), the
+            // original ones are strings which don't sort numerically
             switch (key) {
                 case api::OperationOrderKey::AMOUNT:
-                    _builder.order("amount", std::move(descending), "o");
+                    _builder.order("sortable_amount", std::move(descending), "o");
                     break;
                 case api::OperationOrderKey::DATE:
-                    _builder.order("date", std::move(descending), "o");
+                    _builder.order("date_epoch", std::move(descending), "o");
                     break;
                 case api::OperationOrderKey::SENDERS:
                     _builder.order("senders", std::move(descending), "o");
@@ -77,7 +82,7 @@ namespace ledger {
                     _builder.order("currency_name", std::move(descending), "o");
                     break;
                 case api::OperationOrderKey::FEES:
-                    _builder.order("fees", std::move(descending), "o");
+                    _builder.order("sortable_fees", std::move(descending), "o");
                     break;
                 case api::OperationOrderKey::BLOCK_HEIGHT:
                     _builder.order("height", std::move(descending), "b");
@@ -137,6 +142,7 @@ namespace ledger {
         void OperationQuery::performExecute(std::vector<std::shared_ptr<api::Operation>> &operations) {
             soci::session sql(_pool->getPool());
             soci::rowset<soci::row> rows = performExecute(sql);
+            std::vector<std::shared_ptr<OperationApi>> inflated;
 
             for (auto& row : rows) {
                 auto accountUid = row.get<std::string>(0);
@@ -181,10 +187,41 @@ namespace ledger {
                 }
 
                 // End of inflate
-                if (_fetchCompleteOperation) {
-                    inflateCompleteTransaction(sql, accountUid, *operationApi);
-                }
-                operations.push_back(operationApi);
+                inflated.push_back(operationApi);
+            }
+
+            if (_fetchCompleteOperation) {
+                inflateCompleteTransactions(sql, inflated);
+            }
+            operations.insert(operations.end(), inflated.begin(), inflated.end());
+        }
+
+        std::shared_ptr<OperationQuery> OperationQuery::after(const std::chrono::system_clock::time_point &date,
+                                                              const std::string &uid,
+                                                              bool descending) {
+            seek(Option<OperationKey>(OperationKey{date, uid}), descending);
+            return shared_from_this();
+        }
+
+        std::shared_ptr<OperationCursor> OperationQuery::cursor(int32_t chunkSize, bool descending) {
+            if (chunkSize <= 0) {
+                throw make_exception(api::ErrorCode::INVALID_ARGUMENT, "Cursor chunk size must be positive, got {}", chunkSize);
+            }
+            return std::make_shared<OperationCursor>(shared_from_this(), chunkSize, descending);
+        }
+
+        void OperationQuery::seek(const Option<OperationKey> &key, bool descending) {
+            _builder.clearOrder()
+                    .order("date_epoch", std::move(descending), "o")
+                    .order("uid", std::move(descending), "o");
+            if (key.nonEmpty()) {
+                // Keyed on the typed date column (see migration 31) so that the seek is served by the
+                // (account_uid, date_epoch) index, the epoch is an integer and is inlined in the query
+                auto epoch = static_cast<int64_t>(std::chrono::system_clock::to_time_t(key.getValue().date));
+                const auto& uid = key.getValue().uid;
+                auto symbol = descending ? "<" : ">";
+                _builder.condition(fmt::format("o.date_epoch {0} {1} OR (o.date_epoch = {1} AND o.uid {0} :key_uid)", symbol, epoch),
+                                   {uid});
             }
         }
 
@@ -194,25 +231,138 @@ namespace ledger {
             return shared_from_this();
         }
 
-        void OperationQuery::inflateCompleteTransaction(soci::session &sql, const std::string &accountUid, OperationApi &operation) {
-            switch (operation.getAccount()->getWalletType()) {
-                case (api::WalletType::BITCOIN): return inflateBitcoinLikeTransaction(sql, accountUid, operation);
-                case (api::WalletType::COSMOS): return inflateCosmosLikeTransaction(sql, accountUid, operation);
-                case (api::WalletType::ETHEREUM): return inflateEthereumLikeTransaction(sql, operation);
-                case (api::WalletType::RIPPLE): return inflateRippleLikeTransaction(sql, operation);
-                case (api::WalletType::TEZOS): return inflateTezosLikeTransaction(sql, operation);
-                case (api::WalletType::MONERO): return inflateMoneroLikeTransaction(sql, operation);
-                case (api::WalletType::STELLAR): return inflateStellarLikeTransaction(sql, operation);
-                case (api::WalletType::ALGORAND): return inflateAlgorandLikeTransaction(sql, dynamic_cast<algorand::Operation&>(operation));
+        namespace {
+            // Transaction hash of each operation (by uid) stored in a coin specific operations table
+            std::unordered_map<std::string, std::string> getTransactionHashes(
+                    soci::session &sql,
+                    const std::string &table,
+                    const std::vector<std::shared_ptr<OperationApi>> &operations) {
+                std::unordered_map<std::string, std::string> hashes;
+                if (operations.empty()) {
+                    return hashes;
+                }
+                std::vector<std::string> uids;
+                uids.reserve(operations.size());
+                for (const auto& operation : operations) {
+                    uids.push_back(operation->getBackend().uid);
+                }
+                soci::details::prepare_temp_type statement = (sql.prepare <<
+                        "SELECT uid, transaction_hash FROM " << table <<
+                        " WHERE uid IN (" << soci::in_placeholders(uids.size()) << ")");
+                soci::use_all(statement, uids);
+                soci::rowset<soci::row> rows(statement);
+                for (auto& row : rows) {
+                    hashes[row.get<std::string>(0)] = row.get<std::string>(1);
+                }
+                return hashes;
             }
         }
 
-        void OperationQuery::inflateBitcoinLikeTransaction(soci::session &sql, const std::string &accountUid, OperationApi &operation) {
-            BitcoinLikeBlockchainExplorerTransaction tx;
-            operation.getBackend().bitcoinTransaction = Option<BitcoinLikeBlockchainExplorerTransaction>(tx);
-            std::string transactionHash;
-            sql << "SELECT transaction_hash FROM bitcoin_operations WHERE uid = :uid", soci::use(operation.getBackend().uid), soci::into(transactionHash);
-            BitcoinLikeTransactionDatabaseHelper::getTransactionByHash(sql, transactionHash, accountUid, operation.getBackend().bitcoinTransaction.getValue());
+        void OperationQuery::inflateCompleteTransactions(soci::session &sql,
+                                                         const std::vector<std::shared_ptr<OperationApi>> &operations) {
+            // Inflate by slices. Bitcoin transactions are read with one query per table and slice, the
+            // other coins only batch the operation to transaction hash lookup (Ethereum, Ripple, Tezos,
+            // Algorand) and still read each transaction with their per operation helpers
+            for (std::size_t begin = 0; begin < operations.size(); begin += soci::MAX_IN_CLAUSE_SIZE) {
+                auto end = std::min(operations.size(), begin + soci::MAX_IN_CLAUSE_SIZE);
+                std::unordered_map<int, std::vector<std::shared_ptr<OperationApi>>> operationsByType;
+                for (auto index = begin; index < end; index++) {
+                    auto type = operations[index]->getAccount()->getWalletType();
+                    operationsByType[static_cast<int>(type)].push_back(operations[index]);
+                }
+
+                for (const auto& entry : operationsByType) {
+                    const auto& slice = entry.second;
+                    switch (static_cast<api::WalletType>(entry.first)) {
+                        case (api::WalletType::BITCOIN): {
+                            inflateBitcoinLikeTransactions(sql, slice);
+                            break;
+                        }
+                        case (api::WalletType::COSMOS): {
+                            for (const auto& operation : slice) {
+                                inflateCosmosLikeTransaction(sql, operation->getAccount()->getAccountUid(), *operation);
+                            }
+                            break;
+                        }
+                        case (api::WalletType::ETHEREUM): {
+                            auto hashes = getTransactionHashes(sql, "ethereum_operations", slice);
+                            for (const auto& operation : slice) {
+                                inflateEthereumLikeTransaction(sql, hashes[operation->getBackend().uid], *operation);
+                            }
+                            break;
+                        }
+                        case (api::WalletType::RIPPLE): {
+                            auto hashes = getTransactionHashes(sql, "ripple_operations", slice);
+                            for (const auto& operation : slice) {
+                                inflateRippleLikeTransaction(sql, hashes[operation->getBackend().uid], *operation);
+                            }
+                            break;
+                        }
+                        case (api::WalletType::TEZOS): {
+                            auto hashes = getTransactionHashes(sql, "tezos_operations", slice);
+                            for (const auto& operation : slice) {
+                                inflateTezosLikeTransaction(sql, hashes[operation->getBackend().uid], *operation);
+                            }
+                            break;
+                        }
+                        case (api::WalletType::MONERO): {
+                            for (const auto& operation : slice) {
+                                inflateMoneroLikeTransaction(sql, *operation);
+                            }
+                            break;
+                        }
+                        case (api::WalletType::STELLAR): {
+                            for (const auto& operation : slice) {
+                                inflateStellarLikeTransaction(sql, *operation);
+                            }
+                            break;
+                        }
+                        case (api::WalletType::ALGORAND): {
+                            auto hashes = getTransactionHashes(sql, "algorand_operations", slice);
+                            for (const auto& operation : slice) {
+                                inflateAlgorandLikeTransaction(sql, hashes[operation->getBackend().uid],
+                                                               dynamic_cast<algorand::Operation&>(*operation));
+                            }
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        void OperationQuery::inflateBitcoinLikeTransactions(soci::session &sql,
+                                                            const std::vector<std::shared_ptr<OperationApi>> &operations) {
+            auto hashes = getTransactionHashes(sql, "bitcoin_operations", operations);
+
+            std::vector<std::string> transactionUids;
+            std::unordered_map<std::string, std::string> transactionUidByOperation;
+            for (const auto& operation : operations) {
+                const auto& uid = operation->getBackend().uid;
+                auto hash = hashes.find(uid);
+                if (hash != hashes.end()) {
+                    auto transactionUid = BitcoinLikeTransactionDatabaseHelper::createBitcoinTransactionUid(
+                            operation->getAccount()->getAccountUid(), hash->second);
+                    transactionUids.push_back(transactionUid);
+                    transactionUidByOperation[uid] = std::move(transactionUid);
+                }
+            }
+            std::sort(transactionUids.begin(), transactionUids.end());
+            transactionUids.erase(std::unique(transactionUids.begin(), transactionUids.end()), transactionUids.end());
+
+            std::unordered_map<std::string, BitcoinLikeBlockchainExplorerTransaction> transactions;
+            BitcoinLikeTransactionDatabaseHelper::getTransactionsByUids(sql, transactionUids, transactions);
+
+            for (const auto& operation : operations) {
+                auto& backend = operation->getBackend();
+                backend.bitcoinTransaction = Option<BitcoinLikeBlockchainExplorerTransaction>(BitcoinLikeBlockchainExplorerTransaction());
+                auto transactionUid = transactionUidByOperation.find(backend.uid);
+                if (transactionUid != transactionUidByOperation.end()) {
+                    auto transaction = transactions.find(transactionUid->second);
+                    if (transaction != transactions.end()) {
+                        backend.bitcoinTransaction = Option<BitcoinLikeBlockchainExplorerTransaction>(transaction->second);
+                    }
+                }
+            }
         }
 
         void OperationQuery::inflateCosmosLikeTransaction(
@@ -241,27 +391,21 @@ namespace ledger {
                 sql, msgUid, operation.getBackend().cosmosTransaction.getValue().msg);
         }
 
-        void OperationQuery::inflateRippleLikeTransaction(soci::session &sql, OperationApi &operation) {
+        void OperationQuery::inflateRippleLikeTransaction(soci::session &sql, const std::string &transactionHash, OperationApi &operation) {
             RippleLikeBlockchainExplorerTransaction tx;
             operation.getBackend().rippleTransaction = Option<RippleLikeBlockchainExplorerTransaction>(tx);
-            std::string transactionHash;
-            sql << "SELECT transaction_hash FROM ripple_operations WHERE uid = :uid", soci::use(operation.getBackend().uid), soci::into(transactionHash);
             RippleLikeTransactionDatabaseHelper::getTransactionByHash(sql, transactionHash, operation.getBackend().rippleTransaction.getValue());
         }
 
-        void OperationQuery::inflateTezosLikeTransaction(soci::session &sql, OperationApi &operation) {
+        void OperationQuery::inflateTezosLikeTransaction(soci::session &sql, const std::string &transactionHash, OperationApi &operation) {
             TezosLikeBlockchainExplorerTransaction tx;
             operation.getBackend().tezosTransaction = Option<TezosLikeBlockchainExplorerTransaction>(tx);
-            std::string transactionHash;
-            sql << "SELECT transaction_hash FROM tezos_operations WHERE uid = :uid", soci::use(operation.getBackend().uid), soci::into(transactionHash);
             TezosLikeTransactionDatabaseHelper::getTransactionByHash(sql, transactionHash, operation.getBackend().uid, operation.getBackend().tezosTransaction.getValue());
         }
 
-        void OperationQuery::inflateEthereumLikeTransaction(soci::session &sql, OperationApi &operation) {
+        void OperationQuery::inflateEthereumLikeTransaction(soci::session &sql, const std::string &transactionHash, OperationApi &operation) {
             EthereumLikeBlockchainExplorerTransaction tx;
             operation.getBackend().ethereumTransaction = Option<EthereumLikeBlockchainExplorerTransaction>(tx);
-            std::string transactionHash;
-            sql << "SELECT transaction_hash FROM ethereum_operations WHERE uid = :uid", soci::use(operation.getBackend().uid), soci::into(transactionHash);
             EthereumLikeTransactionDatabaseHelper::getTransactionByHash(sql, transactionHash, operation.getBackend().ethereumTransaction.getValue());
         }
 
@@ -276,12 +420,7 @@ namespace ledger {
             operation.getBackend().stellarOperation = out;
         }
 
-        void OperationQuery::inflateAlgorandLikeTransaction(soci::session& sql, algorand::Operation &operation) {
-            std::string transactionHash;
-            sql << "SELECT transaction_hash FROM algorand_operations WHERE uid = :uid",
-                soci::use(operation.getBackend().uid),
-                soci::into(transactionHash);
-
+        void OperationQuery::inflateAlgorandLikeTransaction(soci::session& sql, const std::string& transactionHash, algorand::Operation &operation) {
             algorand::model::Transaction tx;
             algorand::TransactionDatabaseHelper::getTransactionByHash(sql, transactionHash, tx);
 
@@ -52,6 +52,14 @@ namespace ledger {
         }
 
         class AbstractAccount;
+        class OperationCursor;
+
+        // Position of an operation in a keyset paginated query
+        struct OperationKey {
+            std::chrono::system_clock::time_point date;
+            std::string uid;
+        };
+
         class OperationQuery : public api::OperationQuery, public std::enable_shared_from_this<OperationQuery>,
                                public DedicatedContext {
         public:
@@ -72,17 +80,35 @@ namespace ledger {
 
             std::shared_ptr<OperationQuery> registerAccount(const  std::shared_ptr<AbstractAccount>& account);
 
+            /**
+             * Keyset pagination: order the operations by date then uid and only select the ones
+             * following the operation identified by (date, uid). Unlike offset(), the cost of a
+             * page does not depend on its depth. Replaces any order previously added.
+             */
+            std::shared_ptr<OperationQuery> after(const std::chrono::system_clock::time_point& date,
+                                                  const std::string& uid,
+                                                  bool descending = false);
+
+            /**
+             * Stream the operations by chunks of at most chunkSize operations, ordered by date then
+             * uid. Replaces any order, offset and limit previously set on this query.
+             */
+            std::shared_ptr<OperationCursor> cursor(int32_t chunkSize, bool descending = false);
+
         private:
+            friend class OperationCursor;
+            void seek(const Option<OperationKey>& key, bool descending);
             void performExecute(std::vector<std::shared_ptr<api::Operation>>& operations);
-            void inflateCompleteTransaction(soci::session& sql, const std::string &accountUid, OperationApi& operation);
-            void inflateBitcoinLikeTransaction(soci::session& sql, const std::string &accountUid, OperationApi& operation);
+            // Bitcoin transactions are read with one IN query per table and slice, the other coins per operation
+            void inflateCompleteTransactions(soci::session& sql, const std::vector<std::shared_ptr<OperationApi>>& operations);
+            void inflateBitcoinLikeTransactions(soci::session& sql, const std::vector<std::shared_ptr<OperationApi>>& operations);
             void inflateCosmosLikeTransaction(soci::session& sql, const std::string &accountUid, OperationApi& operation);
-            void inflateRippleLikeTransaction(soci::session& sql, OperationApi& operation);
-            void inflateTezosLikeTransaction(soci::session& sql, OperationApi& operation);
-            void inflateEthereumLikeTransaction(soci::session& sql, OperationApi& operation);
+            void inflateRippleLikeTransaction(soci::session& sql, const std::string& transactionHash, OperationApi& operation);
+            void inflateTezosLikeTransaction(soci::session& sql, const std::string& transactionHash, OperationApi& operation);
+            void inflateEthereumLikeTransaction(soci::session& sql, const std::string& transactionHash, OperationApi& operation);
             void inflateMoneroLikeTransaction(soci::session& sql, OperationApi& operation);
             void inflateStellarLikeTransaction(soci::session& sql, OperationApi& operation);
-            void inflateAlgorandLikeTransaction(soci::session& sql, algorand::Operation &operation);
+            void inflateAlgorandLikeTransaction(soci::session& sql, const std::string& transactionHash, algorand::Operation &operation);
 
         protected:
             virtual soci::rowset<soci::row> performExecute(soci::session &sql);
@@ -0,0 +1,87 @@
+/*
+ *
+ * BalanceCheckpointDatabaseHelper
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#include "BalanceCheckpointDatabaseHelper.h"
+#include <utils/DateUtils.hpp>
+
+using namespace soci;
+
+namespace ledger {
+    namespace core {
+
+        std::string BalanceCheckpointDatabaseHelper::dayOf(const std::chrono::system_clock::time_point &date) {
+            return DateUtils::toJSON(date).substr(0, 10);
+        }
+
+        std::string BalanceCheckpointDatabaseHelper::endOfDay(const std::string &day) {
+            return day + "T23:59:59Z";
+        }
+
+        Option<BalanceCheckpoint>
+        BalanceCheckpointDatabaseHelper::getLastCheckpointBefore(soci::session &sql,
+                                                                 const std::string &accountUid,
+                                                                 const std::string &day) {
+            rowset<row> rows = (sql.prepare << "SELECT day, balance FROM balance_checkpoints "
+                                               "WHERE account_uid = :uid AND day < :day "
+                                               "ORDER BY day DESC LIMIT 1",
+                                               use(accountUid), use(day));
+            for (auto& row : rows) {
+                return Option<BalanceCheckpoint>(BalanceCheckpoint(row.get<std::string>(0),
+                                                                   BigInt::fromHex(row.get<std::string>(1))));
+            }
+            return Option<BalanceCheckpoint>::NONE;
+        }
+
+        Option<BalanceCheckpoint>
+        BalanceCheckpointDatabaseHelper::getLastCheckpoint(soci::session &sql, const std::string &accountUid) {
+            // Days are always formatted as 'YYYY-MM-DD' so any checkpoint is lower than this one
+            return getLastCheckpointBefore(sql, accountUid, "9999-99-99");
+        }
+
+        void BalanceCheckpointDatabaseHelper::putCheckpoints(soci::session &sql,
+                                                             const std::string &accountUid,
+                                                             const std::vector<BalanceCheckpoint> &checkpoints) {
+            if (checkpoints.empty()) {
+                return;
+            }
+            std::vector<std::string> uids(checkpoints.size(), accountUid);
+            std::vector<std::string> days;
+            std::vector<std::string> balances;
+            days.reserve(checkpoints.size());
+            balances.reserve(checkpoints.size());
+            for (const auto& checkpoint : checkpoints) {
+                days.push_back(checkpoint.day);
+                balances.push_back(checkpoint.balance.toHexString());
+            }
+            sql << "INSERT INTO balance_checkpoints VALUES(:uid, :day, :balance) "
+                   "ON CONFLICT(account_uid, day) DO UPDATE SET balance = excluded.balance",
+                   use(uids), use(days), use(balances);
+        }
+
+    }
+}
@@ -0,0 +1,86 @@
+/*
+ *
+ * BalanceCheckpointDatabaseHelper
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+#ifndef LEDGER_CORE_BALANCECHECKPOINTDATABASEHELPER_H
+#define LEDGER_CORE_BALANCECHECKPOINTDATABASEHELPER_H
+
+#include <math/BigInt.h>
+#include <utils/Option.hpp>
+#include <soci.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+        /**
+         * Balance of an account at the end of a day (UTC). Checkpoints are only valid as long as
+         * no operation of the same day or older changes: the triggers installed on the operations
+         * table remove the stale ones, so a checkpoint read from the database can always be trusted.
+         */
+        struct BalanceCheckpoint {
+            std::string day;
+            BigInt balance;
+
+            BalanceCheckpoint() = default;
+            BalanceCheckpoint(const std::string& day, const BigInt& balance) : day(day), balance(balance) {};
+        };
+
+        class BalanceCheckpointDatabaseHelper {
+        public:
+            /**
+             * Day (formatted as 'YYYY-MM-DD') of a date, as stored in the operations table.
+             */
+            static std::string dayOf(const std::chrono::system_clock::time_point& date);
+
+            /**
+             * Date of the last second of a day, operations strictly after it belong to the next days.
+             */
+            static std::string endOfDay(const std::string& day);
+
+            /**
+             * Get the most recent checkpoint of an account strictly before the given day.
+             */
+            static Option<BalanceCheckpoint> getLastCheckpointBefore(soci::session& sql,
+                                                                     const std::string& accountUid,
+                                                                     const std::string& day);
+
+            /**
+             * Get the most recent checkpoint of an account.
+             */
+            static Option<BalanceCheckpoint> getLastCheckpoint(soci::session& sql, const std::string& accountUid);
+
+            static void putCheckpoints(soci::session& sql,
+                                       const std::string& accountUid,
+                                       const std::vector<BalanceCheckpoint>& checkpoints);
+        };
+    }
+}
+
+
+#endif //LEDGER_CORE_BALANCECHECKPOINTDATABASEHELPER_H
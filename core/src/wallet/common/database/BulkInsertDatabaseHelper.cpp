@@ -35,6 +35,7 @@
 #include <wallet/common/database/BlockDatabaseHelper.h>
 #include <database/soci-date.h>
 #include <database/soci-option.h>
+#include <database/soci-number.h>
 
 namespace ledger {
     namespace core {
@@ -42,18 +43,22 @@ namespace ledger {
 
         const StatementDeclaration<OperationBinding> BulkInsertDatabaseHelper::UPSERT_OPERATION =
                 db::stmt<OperationBinding>(
-                        "INSERT INTO operations VALUES("
+                        "INSERT INTO operations(uid, account_uid, wallet_uid, type, date, senders, recipients,"
+                        " amount, fees, block_uid, currency_name, trust, date_epoch, sortable_amount, sortable_fees)"
+                        " VALUES("
                         ":uid, :account_uid, :wallet_uid, :type, :date, :senders, :recipients, :amount,"
-                        ":fees, :block_uid, :currency_name, :trust"
+                        ":fees, :block_uid, :currency_name, :trust, :date_epoch, :sortable_amount, :sortable_fees"
                         ") ON CONFLICT(uid) DO UPDATE SET block_uid = :block_uid, trust = :trust,"
-                        " amount = :amount", [] (auto& s, auto& b) {
+                        " amount = :amount, sortable_amount = :sortable_amount", [] (auto& s, auto& b) {
                             s, use(b.uid, "uid"), use(b.accountUid, "account_uid"),
                                     use(b.walletUid, "wallet_uid"), use(b.type, "type"),
                                     use(b.date, "date"), use(b.senders, "senders"),
                                     use(b.receivers, "recipients"), use(b.amount, "amount"),
                                     use(b.fees, "fees"), use(b.blockUid, "block_uid"),
                                     use(b.currencyName, "currency_name"),
-                                    use(b.serializedTrust, "trust");
+                                    use(b.serializedTrust, "trust"), use(b.dateEpoch, "date_epoch"),
+                                    use(b.sortableAmount, "sortable_amount"),
+                                    use(b.sortableFees, "sortable_fees");
                         });
         const StatementDeclaration<BlockBinding> BulkInsertDatabaseHelper::UPSERT_BLOCK =
                 db::stmt<BlockBinding>(
@@ -74,6 +79,7 @@ namespace ledger {
 
         void OperationBinding::update(const Operation &operation) {
             amount.push_back(operation.amount.toHexString());
+            sortableAmount.push_back(soci::to_sortable_hex(amount.back()));
             blockUid.push_back(operation.block.map<std::string>([] (const Block& block) {
                 return block.getUid();
             }));
@@ -88,11 +94,13 @@ namespace ledger {
             senders.push_back(sndrs.str());
             receivers.push_back(rcvrs.str());
             fees.push_back(operation.fees.getValueOr(BigInt::ZERO).toHexString());
+            sortableFees.push_back(soci::to_sortable_hex(fees.back()));
 
             uid.push_back(operation.uid);
             accountUid.push_back(operation.accountUid);
             walletUid.push_back(operation.walletUid);
             date.push_back(operation.date);
+            dateEpoch.push_back(std::chrono::system_clock::to_time_t(operation.date));
             currencyName.push_back(operation.currencyName);
             type.push_back(api::to_string(operation.type));
         }
@@ -103,12 +111,15 @@ namespace ledger {
             receivers.clear();
             amount.clear();
             fees.clear();
+            sortableAmount.clear();
+            sortableFees.clear();
             blockUid.clear();
             serializedTrust.clear();
             uid.clear();
             accountUid.clear();
             walletUid.clear();
             date.clear();
+            dateEpoch.clear();
             currencyName.clear();
         }
 
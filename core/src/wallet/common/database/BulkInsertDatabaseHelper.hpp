@@ -44,6 +44,8 @@ namespace ledger {
             std::vector <std::string> receivers;
             std::vector <std::string> amount;
             std::vector <std::string> fees;
+            std::vector <std::string> sortableAmount;
+            std::vector <std::string> sortableFees;
             std::vector <Option<std::string>> blockUid;
             std::vector <std::string> serializedTrust;
 
@@ -51,6 +53,7 @@ namespace ledger {
             std::vector <std::string> accountUid;
             std::vector <std::string> walletUid;
             std::vector <std::chrono::system_clock::time_point> date;
+            std::vector <long long> dateEpoch;
             std::vector <std::string> currencyName;
 
             void update(const Operation& operation);
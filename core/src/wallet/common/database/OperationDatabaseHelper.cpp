@@ -78,11 +78,20 @@ namespace ledger {
                                                  const std::string &accountUid,
                                                  std::vector<Operation> &operations,
                                                  std::function<bool(const std::string &address)> filter) {
+            return queryOperationsAfter(sql, accountUid, "", operations, filter);
+        }
+
+        std::size_t
+        OperationDatabaseHelper::queryOperationsAfter(soci::session &sql,
+                                                      const std::string &accountUid,
+                                                      const std::string &date,
+                                                      std::vector<Operation> &operations,
+                                                      std::function<bool(const std::string &address)> filter) {
             rowset<row> rows = (sql.prepare <<
                                             "SELECT op.amount, op.fees, op.type, op.date, op.senders, op.recipients"
                                                     " FROM operations AS op "
-                                                    " WHERE op.account_uid = :uid ORDER BY op.date",
-                                                    use(accountUid));
+                                                    " WHERE op.account_uid = :uid AND op.date > :date ORDER BY op.date",
+                                                    use(accountUid), use(date));
 
             auto filterList = [&] (const std::vector<std::string> &list) -> bool {
                 for (auto& elem : list) {
@@ -55,6 +55,16 @@ namespace ledger {
                                                std::vector<Operation>& out,
                                                std::function<bool (const std::string& address)> filter);
 
+            /**
+             * Same as queryOperations but only gets the operations strictly after the given date
+             * (formatted as stored in the operations table, see DateUtils::toJSON).
+             */
+            static std::size_t queryOperationsAfter(soci::session &sql,
+                                                    const std::string &accountUid,
+                                                    const std::string &date,
+                                                    std::vector<Operation>& out,
+                                                    std::function<bool (const std::string& address)> filter);
+
             /**
              * Checks if an operation is in a block or not
              *
@@ -91,7 +91,10 @@ namespace ledger {
 
             FuturePtr<Block>
             getLedgerApiCurrentBlock() const {
+                // Every account of the pool asks for it when it synchronizes: share the requests in flight
+                // but never serve a stale head
                 return _http->GET(fmt::format("/blockchain/{}/{}/blocks/current", getExplorerVersion(), getNetworkParameters().Identifier))
+                        .cached(std::chrono::seconds(0))
                         .template json<Block, Exception>(LedgerApiParser<Block, BlockParser>())
                         .template mapPtr<Block>(getExplorerContext(), [] (const Either<Exception, std::shared_ptr<Block>>& result) {
                             if (result.isLeft()) {
@@ -33,6 +33,7 @@
 #define LEDGER_CORE_ABSTRACTBLOCKCHAINEXPLORERACCOUNTSYNCHRONIZER_H
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <array>
@@ -56,7 +57,7 @@
 #include <wallet/common/database/OperationDatabaseHelper.h>
 #include <utils/Concurrency.hpp>
 
-#define NEW_BENCHMARK(x) std::make_shared<Benchmarker>(fmt::format(x"/{}", buddy->synchronizationTag), buddy->logger)
+#define NEW_BENCHMARK(x) std::make_shared<Benchmarker>(x, BENCHMARK_HISTOGRAM(x), buddy->logger, buddy->synchronizationTag)
 
 namespace ledger {
     namespace core {
@@ -96,6 +97,110 @@ namespace ledger {
             uint32_t newOperations = 0;
         };
 
+        // Recover from a failed batch synchronization.
+        //
+        // In case of block reorganization, operations above the last known block of the failed
+        // batch are removed and synchronization is relaunched from that batch with synchronizeBatches.
+        // Shared by the synchronizers whose buddies hold the savedState of their batches.
+        template<typename Buddy>
+        Future<Unit> recoverFromFailedBatch(uint32_t batchIndex,
+                                            const std::shared_ptr<Buddy>& buddy,
+                                            const Exception& exception,
+                                            const std::function<Future<Unit> (uint32_t)>& synchronizeBatches) {
+            buddy->logger->info("Recovering from failing synchronization : {}", exception.getMessage());
+            //A block reorganization happened
+            if (exception.getErrorCode() == api::ErrorCode::BLOCK_NOT_FOUND &&
+                buddy->savedState.nonEmpty()) {
+                buddy->logger->info("Recovering from reorganization");
+                auto startSession = Future<void*>::async(ImmediateExecutionContext::INSTANCE, [=]() {
+                    return Future<void*>::successful(nullptr);
+                });
+
+                return startSession.template flatMap<Unit>(ImmediateExecutionContext::INSTANCE, [=] (void * const session) {
+                    //Get its block/block height
+                    auto &failedBatch = buddy->savedState.getValue().batches[batchIndex];
+                    auto const failedBlockHeight = failedBatch.blockHeight;
+                    auto const failedBlockHash = failedBatch.blockHash;
+
+                    if (failedBlockHeight > 0) {
+
+                        //Delete data related to failedBlock (and all blocks above it)
+                        buddy->logger->info("Deleting blocks above block height: {}", failedBlockHeight);
+
+                        soci::session sql(buddy->wallet->getDatabase()->getPool());
+                        {
+                            soci::transaction tr(sql);
+                            try {
+
+                                soci::rowset<std::string> rows_block =  (sql.prepare << "SELECT uid FROM blocks where height >= :failedBlockHeight",
+                                                                            soci::use(failedBlockHeight));
+
+                                std::vector<std::string> blockToDelete(rows_block.begin(), rows_block.end());
+
+                                // Fetch all operations which are deleted during reorganization
+                                auto deletedOperationUIDs = OperationDatabaseHelper::fetchFromBlocks(sql, blockToDelete);
+
+                                // Remove failed blocks and associated operations/transactions
+                                AccountDatabaseHelper::removeBlockOperation(sql, buddy->account->getAccountUid(), blockToDelete);
+
+                                //Get last block not part from reorg
+                                auto lastBlock = BlockDatabaseHelper::getLastBlock(sql,
+                                                                                   buddy->wallet->getCurrency().name);
+
+                                //Resync from the "beginning" if no last block in DB
+                                int64_t lastBlockHeight = 0;
+                                std::string lastBlockHash;
+                                if (lastBlock.nonEmpty()) {
+                                    lastBlockHeight = lastBlock.getValue().height;
+                                    lastBlockHash = lastBlock.getValue().blockHash;
+                                }
+                                // update reorganization block height until found the valid one
+                                buddy->context.reorgBlockHeight = lastBlockHeight;
+
+                                //Update savedState's batches
+                                for (auto &batch : buddy->savedState.getValue().batches) {
+                                    if (batch.blockHeight > lastBlockHeight) {
+                                        batch.blockHeight = (uint32_t) lastBlockHeight;
+                                        batch.blockHash = lastBlockHash;
+                                    }
+                                }
+                                tr.commit();
+
+                                // We can emit safely deleted operation UIDs
+                                std::for_each(
+                                    deletedOperationUIDs.cbegin(),
+                                    deletedOperationUIDs.cend(),
+                                    [buddy](auto const &uid) {
+                                        buddy->account->emitDeletedOperationEvent(uid);
+                                    });
+                            } catch(...) {
+                                tr.rollback();
+                            }
+                        }
+
+                        //Save new savedState
+                        buddy->preferences->editor()->template putObject<BlockchainExplorerAccountSynchronizationSavedState>(
+                                "state", buddy->savedState.getValue())->commit();
+
+                        //Synchronize same batch now with an existing block (of hash lastBlockHash)
+                        //if failedBatch was not the deepest block part of that reorg, this recursive call
+                        //will ensure to get (and delete from DB) to the deepest failed block (part of reorg)
+                        buddy->logger->info("Relaunch synchronization after recovering from reorganization");
+
+                        return synchronizeBatches(batchIndex);
+                    }
+                    return Future<Unit>::successful(unit);
+                }).recover(ImmediateExecutionContext::INSTANCE, [buddy] (const Exception& ex) -> Unit {
+                    buddy->logger->warn(
+                            "Failed to recover from reorganisation for account#{} of wallet {}",
+                            buddy->account->getIndex(),
+                            buddy->account->getWallet()->getName());
+                    return unit;
+                });
+            }
+            return Future<Unit>::successful(unit);
+        }
+
         template<typename Account, typename AddressType, typename Keychain, typename Explorer>
         class AbstractBlockchainExplorerAccountSynchronizer {
         public:
@@ -131,6 +236,8 @@ namespace ledger {
                 std::shared_ptr<AbstractWallet> wallet;
                 std::shared_ptr<DynamicObject> configuration;
                 uint32_t halfBatchSize;
+                uint32_t maxParallelBatches;
+                std::mutex synchronizationLock;
                 std::shared_ptr<Keychain> keychain;
                 Option<BlockchainExplorerAccountSynchronizationSavedState> savedState;
                 std::shared_ptr<Account> account;
@@ -202,6 +309,9 @@ namespace ledger {
                 buddy->halfBatchSize = (uint32_t) buddy->configuration
                         ->getInt(api::Configuration::SYNCHRONIZATION_HALF_BATCH_SIZE)
                         .value_or(api::ConfigurationDefaults::KEYCHAIN_DEFAULT_OBSERVABLE_RANGE);
+                buddy->maxParallelBatches = (uint32_t) buddy->configuration
+                        ->getInt(api::Configuration::SYNCHRONIZATION_MAX_PARALLEL_BATCHES)
+                        .value_or(api::ConfigurationDefaults::DEFAULT_SYNCHRONIZATION_MAX_PARALLEL_BATCHES);
                 buddy->keychain = account->getKeychain();
                 buddy->savedState = buddy->preferences
                         ->template getObject<BlockchainExplorerAccountSynchronizationSavedState>("state");
@@ -295,129 +405,78 @@ namespace ledger {
             //
             // This function will synchronize all batches by iterating over batches and transactions
             // bulks. The input buddy can be used to customize the behavior of the synchronization.
+            // Batches are synchronized by windows of buddy->maxParallelBatches batches: explorer
+            // calls of a window are issued concurrently while the bulks are interpreted and inserted
+            // one batch after the other, in batch order. Interpretation stops at the first batch
+            // reaching the gap limit so the window ends where a sequential synchronization would.
             Future<Unit> synchronizeBatches(uint32_t currentBatchIndex,
                                             std::shared_ptr<SynchronizationBuddy> buddy) {
                 buddy->logger->info("SYNC BATCHES");
                 //For ETH and XRP like wallets, one account corresponds to one ETH address,
                 //so ne need to discover other batches
                 auto hasMultipleAddresses = buddy->wallet->getWalletType() == api::WalletType::BITCOIN;
-                auto done = currentBatchIndex >= buddy->savedState.getValue().batches.size() - 1;
-                if (currentBatchIndex >= buddy->savedState.getValue().batches.size()) {
-                    buddy->savedState.getValue().batches.push_back(BlockchainExplorerAccountSynchronizationBatchSavedState());
-                }
+                auto windowSize = hasMultipleAddresses ? std::max<uint32_t>(buddy->maxParallelBatches, 1) : 1;
 
                 auto self = getSharedFromThis();
-                auto& batchState = buddy->savedState.getValue().batches[currentBatchIndex];
+                std::vector<bool> done;
+                std::size_t batchCount;
+                {
+                    std::lock_guard<std::mutex> lock(buddy->synchronizationLock);
+                    // Every batch state of the window is created before launching any batch, the
+                    // batches vector must not be reallocated while the window is running
+                    auto& batches = buddy->savedState.getValue().batches;
+                    batchCount = batches.size();
+                    for (auto index = currentBatchIndex; index < currentBatchIndex + windowSize; index++) {
+                        done.push_back(index >= batches.size() - 1);
+                        if (index >= batches.size()) {
+                            batches.push_back(BlockchainExplorerAccountSynchronizationBatchSavedState());
+                        }
+                    }
+                }
 
                 auto benchmark = NEW_BENCHMARK("full_batch");
                 benchmark->start();
-                return synchronizeBatch(currentBatchIndex, buddy).template flatMap<Unit>(buddy->account->getContext(), [=] (const bool& hadTransactions) -> Future<Unit> {
-                    benchmark->stop();
-
-                    buddy->preferences->editor()->template putObject<BlockchainExplorerAccountSynchronizationSavedState>("state", buddy->savedState.getValue())->commit();
-
-                    //Sync stops if there are no more batches in savedState and last batch has no transactions
-                    //But we may want to force sync of accounts within KEYCHAIN_OBSERVABLE_RANGE
-                    auto discoveredAddresses = currentBatchIndex * buddy->halfBatchSize;
-                    auto lastDiscoverableAddress = buddy->configuration->getInt(api::Configuration::KEYCHAIN_OBSERVABLE_RANGE).value_or(buddy->halfBatchSize);
-                    if (hasMultipleAddresses && (!done || (done && hadTransactions) || lastDiscoverableAddress > discoveredAddresses)) {
-                        return self->synchronizeBatches(currentBatchIndex + 1, buddy);
-                    }
-
-                    return Future<Unit>::successful(unit);
-                }).recoverWith(ImmediateExecutionContext::INSTANCE, [=] (const Exception &exception) -> Future<Unit> {
-                    buddy->logger->info("Recovering from failing synchronization : {}", exception.getMessage());
-                    //A block reorganization happened
-                    if (exception.getErrorCode() == api::ErrorCode::BLOCK_NOT_FOUND &&
-                        buddy->savedState.nonEmpty()) {
-                        buddy->logger->info("Recovering from reorganization");
-                        auto startSession = Future<void*>::async(ImmediateExecutionContext::INSTANCE, [=]() {
-                            return Future<void*>::successful(nullptr);
-                        });
-
-                        return startSession.template flatMap<Unit>(ImmediateExecutionContext::INSTANCE, [=] (void * const session) {
-                            //Get its block/block height
-                            auto &failedBatch = buddy->savedState.getValue().batches[currentBatchIndex];
-                            auto const failedBlockHeight = failedBatch.blockHeight;
-                            auto const failedBlockHash = failedBatch.blockHash;
-
-                            if (failedBlockHeight > 0) {
-
-                                //Delete data related to failedBlock (and all blocks above it)
-                                buddy->logger->info("Deleting blocks above block height: {}", failedBlockHeight);
-
-                                soci::session sql(buddy->wallet->getDatabase()->getPool());
-                                {
-                                    soci::transaction tr(sql);
-                                    try {
-
-                                        soci::rowset<std::string> rows_block =  (sql.prepare << "SELECT uid FROM blocks where height >= :failedBlockHeight",
-                                                                                    soci::use(failedBlockHeight));
-
-                                        std::vector<std::string> blockToDelete(rows_block.begin(), rows_block.end());
-
-                                        // Fetch all operations which are deleted during reorganization
-                                        auto deletedOperationUIDs = OperationDatabaseHelper::fetchFromBlocks(sql, blockToDelete);
-
-                                        // Remove failed blocks and associated operations/transactions
-                                        AccountDatabaseHelper::removeBlockOperation(sql, buddy->account->getAccountUid(), blockToDelete);
-
-                                        //Get last block not part from reorg
-                                        auto lastBlock = BlockDatabaseHelper::getLastBlock(sql,
-                                                                                           buddy->wallet->getCurrency().name);
-
-                                        //Resync from the "beginning" if no last block in DB
-                                        int64_t lastBlockHeight = 0;
-                                        std::string lastBlockHash;
-                                        if (lastBlock.nonEmpty()) {
-                                            lastBlockHeight = lastBlock.getValue().height;
-                                            lastBlockHash = lastBlock.getValue().blockHash;
-                                        }
-                                        // update reorganization block height until found the valid one
-                                        buddy->context.reorgBlockHeight = lastBlockHeight;
-
-                                        //Update savedState's batches
-                                        for (auto &batch : buddy->savedState.getValue().batches) {
-                                            if (batch.blockHeight > lastBlockHeight) {
-                                                batch.blockHeight = (uint32_t) lastBlockHeight;
-                                                batch.blockHash = lastBlockHash;
-                                            }
-                                        }
-                                        tr.commit();
-
-                                        // We can emit safely deleted operation UIDs
-                                        std::for_each(
-                                            deletedOperationUIDs.cbegin(),
-                                            deletedOperationUIDs.cend(),
-                                            [buddy](auto const &uid) {
-                                                buddy->account->emitDeletedOperationEvent(uid);
-                                            });
-                                    } catch(...) {
-                                        tr.rollback();
-                                    }
-                                }
-
-                                //Save new savedState
-                                buddy->preferences->editor()->template putObject<BlockchainExplorerAccountSynchronizationSavedState>(
-                                        "state", buddy->savedState.getValue())->commit();
-
-                                //Synchronize same batch now with an existing block (of hash lastBlockHash)
-                                //if failedBatch was not the deepest block part of that reorg, this recursive call
-                                //will ensure to get (and delete from DB) to the deepest failed block (part of reorg)
-                                buddy->logger->info("Relaunch synchronization after recovering from reorganization");
-
-                                return self->synchronizeBatches(currentBatchIndex, buddy);
+                auto lastDiscoverableAddress = buddy->configuration->getInt(api::Configuration::KEYCHAIN_OBSERVABLE_RANGE).value_or(buddy->halfBatchSize);
+                auto lastBatchIndex = std::make_shared<uint32_t>(currentBatchIndex);
+                auto proceed = Future<bool>::successful(true);
+                for (uint32_t offset = 0; offset < windowSize; offset++) {
+                    auto batchIndex = currentBatchIndex + offset;
+                    auto batchDone = done[offset];
+                    auto bulk = getTransactionBulk(batchIndex, buddy);
+                    proceed = proceed.template flatMap<bool>(buddy->account->getContext(), [=] (const bool& previousProceeded) -> Future<bool> {
+                        if (!previousProceeded) {
+                            return Future<bool>::successful(false);
+                        }
+                        *lastBatchIndex = batchIndex;
+                        return self->interpretBatch(batchIndex, buddy, bulk, false).template map<bool>(ImmediateExecutionContext::INSTANCE, [=] (const bool& hadTransactions) {
+                            //Sync stops if there are no more batches in savedState and last batch has no transactions
+                            //But we may want to force sync of accounts within KEYCHAIN_OBSERVABLE_RANGE
+                            auto discoveredAddresses = batchIndex * buddy->halfBatchSize;
+                            if (hasMultipleAddresses && !(batchDone && !hadTransactions && lastDiscoverableAddress <= discoveredAddresses)) {
+                                return true;
                             }
-                            return Future<Unit>::successful(unit);
-                        }).recover(ImmediateExecutionContext::INSTANCE, [buddy] (const Exception& ex) -> Unit {
-                            buddy->logger->warn(
-                                    "Failed to recover from reorganisation for account#{} of wallet {}",
-                                    buddy->account->getIndex(),
-                                    buddy->account->getWallet()->getName());
-                            return unit;
+                            // Forget the batches of the window created past the gap limit
+                            std::lock_guard<std::mutex> lock(buddy->synchronizationLock);
+                            auto& batches = buddy->savedState.getValue().batches;
+                            batches.resize(std::max<std::size_t>(batchCount, batchIndex + 1));
+                            return false;
                         });
+                    });
+                }
+
+                return proceed.recoverWith(ImmediateExecutionContext::INSTANCE, [=] (const Exception &exception) -> Future<bool> {
+                    return recoverFromFailedBatch(*lastBatchIndex, buddy, exception, [self, buddy] (uint32_t batchIndex) {
+                        return self->synchronizeBatches(batchIndex, buddy);
+                    }).template map<bool>(ImmediateExecutionContext::INSTANCE, [] (const Unit&) {
+                        return false;
+                    });
+                }).template flatMap<Unit>(buddy->account->getContext(), [=] (const bool& proceeded) -> Future<Unit> {
+                    benchmark->stop();
+                    buddy->preferences->editor()->template putObject<BlockchainExplorerAccountSynchronizationSavedState>("state", buddy->savedState.getValue())->commit();
+                    if (!proceeded) {
+                        return Future<Unit>::successful(unit);
                     }
-                    return Future<Unit>::successful(unit);
+                    return self->synchronizeBatches(currentBatchIndex + windowSize, buddy);
                 });
             };
 
@@ -431,10 +490,14 @@ namespace ledger {
                     uint32_t currentBatchIndex,
                     std::shared_ptr<SynchronizationBuddy> buddy,
                     bool hadTransactions = false) {
-                buddy->logger->info("SYNC BATCH {}", currentBatchIndex);
+                return interpretBatch(currentBatchIndex, buddy, getTransactionBulk(currentBatchIndex, buddy), hadTransactions);
+            };
 
+            // Request the transactions of a batch from the last block synchronized by the batch.
+            Future<std::shared_ptr<typename Explorer::TransactionsBulk>> getTransactionBulk(
+                    uint32_t currentBatchIndex,
+                    const std::shared_ptr<SynchronizationBuddy>& buddy) {
                 Option<std::string> blockHash;
-                auto self = getSharedFromThis();
                 auto& batchState = buddy->savedState.getValue().batches[currentBatchIndex];
 
                 if (batchState.blockHeight > 0) {
@@ -458,8 +521,25 @@ namespace ledger {
                 auto benchmark = NEW_BENCHMARK("explorer_calls");
                 benchmark->start();
                 return _explorer->getTransactions(batch, blockHash, optional<void*>())
-                    .template flatMap<bool>(buddy->account->getContext(), [self, currentBatchIndex, buddy, hadTransactions, benchmark, blockHash] (const std::shared_ptr<typename Explorer::TransactionsBulk>& bulk) -> Future<bool> {
+                    .template map<std::shared_ptr<typename Explorer::TransactionsBulk>>(ImmediateExecutionContext::INSTANCE, [benchmark] (const std::shared_ptr<typename Explorer::TransactionsBulk>& bulk) {
                         benchmark->stop();
+                        return bulk;
+                    });
+            };
+
+            // Interpret and insert a transactions bulk of a batch, then synchronize the next bulk
+            // of the batch if any.
+            Future<bool> interpretBatch(
+                    uint32_t currentBatchIndex,
+                    std::shared_ptr<SynchronizationBuddy> buddy,
+                    Future<std::shared_ptr<typename Explorer::TransactionsBulk>> bulk,
+                    bool hadTransactions) {
+                buddy->logger->info("SYNC BATCH {}", currentBatchIndex);
+
+                auto self = getSharedFromThis();
+                return bulk
+                    .template flatMap<bool>(buddy->account->getContext(), [self, currentBatchIndex, buddy, hadTransactions] (const std::shared_ptr<typename Explorer::TransactionsBulk>& bulk) -> Future<bool> {
+                        std::unique_lock<std::mutex> lock(buddy->synchronizationLock);
 
                         auto interpretBenchmark = NEW_BENCHMARK("interpret_operations");
 
@@ -519,6 +599,8 @@ namespace ledger {
                             buddy->preferences->editor()->template putObject<BlockchainExplorerAccountSynchronizationSavedState>("state", buddy->savedState.getValue())->commit();
                         }
 
+                        lock.unlock();
+
                         auto hadTX = hadTransactions || bulk->transactions.size() > 0;
                         if (bulk->hasNext) {
                             return self->synchronizeBatch(currentBatchIndex, buddy, hadTX);
@@ -762,7 +762,7 @@ namespace ledger {
                 const std::vector<CosmosLikeOperation> &operations) {
             if (operations.empty())
                 return;
-            Benchmarker rawInsert("raw_db_insert_cosmos", nullptr);
+            Benchmarker rawInsert("raw_db_insert_cosmos", BENCHMARK_HISTOGRAM("raw_db_insert_cosmos"), nullptr);
             rawInsert.start();
 
             PreparedStatement<OperationBinding> operationStmt;
@@ -95,8 +95,51 @@ GaiaCosmosLikeBlockchainExplorer::getTransactionFilters() {
   return GAIA_FILTER;
 }
 
+// Maximum number of blocks (fetched or in flight) kept by the explorer
+static const size_t GAIA_BLOCK_CACHE_SIZE = 1000;
+
 FuturePtr<cosmos::Block>
 GaiaCosmosLikeBlockchainExplorer::getBlock(uint64_t &blockHeight) const {
+  // Blocks are final once produced, so a block fetched for a height can be
+  // shared by every transaction (and every concurrent request) at this height.
+  const auto height = blockHeight;
+  Promise<std::shared_ptr<cosmos::Block>> promise;
+  {
+    std::lock_guard<std::mutex> lock(_blocksLock);
+    auto it = _blocks.find(height);
+    if (it != _blocks.end()) {
+      _blocksOrder.splice(_blocksOrder.begin(), _blocksOrder,
+                          it->second.position);
+      return it->second.block;
+    }
+    _blocksOrder.push_front(height);
+    _blocks.emplace(height, CachedBlock{promise.getFuture(), _blocksOrder.begin()});
+    while (_blocksOrder.size() > GAIA_BLOCK_CACHE_SIZE) {
+      _blocks.erase(_blocksOrder.back());
+      _blocksOrder.pop_back();
+    }
+  }
+
+  auto self = shared_from_this();
+  fetchBlock(height).onComplete(
+      getContext(),
+      [self, height, promise](const Try<std::shared_ptr<cosmos::Block>> &result) mutable {
+        if (result.isFailure()) {
+          // Do not keep failures, the next call will retry
+          std::lock_guard<std::mutex> lock(self->_blocksLock);
+          auto it = self->_blocks.find(height);
+          if (it != self->_blocks.end()) {
+            self->_blocksOrder.erase(it->second.position);
+            self->_blocks.erase(it);
+          }
+        }
+        promise.complete(result);
+      });
+  return promise.getFuture();
+}
+
+FuturePtr<cosmos::Block>
+GaiaCosmosLikeBlockchainExplorer::fetchBlock(uint64_t blockHeight) const {
   return _http
       ->GET(fmt::format(kGaiaBlocksEndpoint, blockHeight), ACCEPT_HEADER)
       .json(true)
@@ -324,6 +367,7 @@ Future<String> GaiaCosmosLikeBlockchainExplorer::pushTransaction(
   }
 
   return _http->POST("/txs", transaction, headers)
+      .prioritized()
       .json()
       .template map<String>(
           _executionContext,
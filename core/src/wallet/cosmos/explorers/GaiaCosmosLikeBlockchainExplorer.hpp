@@ -33,6 +33,11 @@
 
 #include <boost/utility/string_view.hpp>
 
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include <async/DedicatedContext.hpp>
 #include <net/HttpClient.hpp>
 #include <wallet/common/Block.h>
@@ -46,7 +51,8 @@ static const std::unordered_map<std::string, std::string> ACCEPT_HEADER{
 
 class GaiaCosmosLikeBlockchainExplorer :
     public CosmosLikeBlockchainExplorer,
-    public DedicatedContext {
+    public DedicatedContext,
+    public std::enable_shared_from_this<GaiaCosmosLikeBlockchainExplorer> {
    public:
     GaiaCosmosLikeBlockchainExplorer(
         const std::shared_ptr<api::ExecutionContext> &context,
@@ -139,6 +145,9 @@ class GaiaCosmosLikeBlockchainExplorer :
     template <typename T>
     void parseTransactionWithPosttreatment(const T &node, cosmos::Transaction &transaction) const;
 
+    /// Query a block from the explorer, bypassing the block cache
+    FuturePtr<cosmos::Block> fetchBlock(uint64_t blockHeight) const;
+
     /// Inflate a transaction with all its block data (block hash and timestamp)
     /// The hash information is necessary to compute a block_uid and therefore not having
     /// it will prevent the OperationQuery from fetching the correct block to compute the
@@ -188,6 +197,17 @@ class GaiaCosmosLikeBlockchainExplorer :
    private:
     std::shared_ptr<HttpClient> _http;
     api::CosmosLikeNetworkParameters _parameters;
+
+    // Blocks by height, bounded in size and evicted least recently used
+    // first. In flight requests are stored too so that concurrent lookups of
+    // the same height share a single HTTP call.
+    struct CachedBlock {
+        FuturePtr<cosmos::Block> block;
+        std::list<uint64_t>::iterator position;
+    };
+    mutable std::mutex _blocksLock;
+    mutable std::unordered_map<uint64_t, CachedBlock> _blocks;
+    mutable std::list<uint64_t> _blocksOrder;
 };
 
 }  // namespace core
@@ -271,7 +271,7 @@ Future<Unit> CosmosLikeAccountSynchronizer::synchronizeBatches(
     auto &batchState = buddy->savedState.getValue().batches[currentBatchIndex];
 
     auto benchmark = std::make_shared<Benchmarker>(
-        fmt::format("Synchronize batch {}", currentBatchIndex), buddy->logger);
+        "full_batch", BENCHMARK_HISTOGRAM("full_batch"), buddy->logger, fmt::format("{}", currentBatchIndex));
     benchmark->start();
     return synchronizeBatch(currentBatchIndex, buddy)
         .template flatMap<Unit>(
@@ -382,7 +382,7 @@ Future<bool> CosmosLikeAccountSynchronizer::synchronizeBatch(
     auto self = shared_from_this();
     auto &batchState = buddy->savedState.getValue().batches[currentBatchIndex];
 
-    auto derivationBenchmark = std::make_shared<Benchmarker>("Batch derivation", buddy->logger);
+    auto derivationBenchmark = std::make_shared<Benchmarker>("Batch derivation", BENCHMARK_HISTOGRAM("Batch derivation"), buddy->logger);
     derivationBenchmark->start();
 
     auto batch = vector::map<std::string, std::shared_ptr<CosmosLikeAddress>>(
@@ -395,7 +395,7 @@ Future<bool> CosmosLikeAccountSynchronizer::synchronizeBatch(
 
     derivationBenchmark->stop();
 
-    auto benchmark = std::make_shared<Benchmarker>("Get batch", buddy->logger);
+    auto benchmark = std::make_shared<Benchmarker>("Get batch", BENCHMARK_HISTOGRAM("Get batch"), buddy->logger);
     benchmark->start();
     return _explorer->getTransactions(batch, batchState.blockHeight, buddy->token)
         .template flatMap<bool>(
@@ -405,7 +405,7 @@ Future<bool> CosmosLikeAccountSynchronizer::synchronizeBatch(
                 benchmark->stop();
 
                 auto insertionBenchmark =
-                    std::make_shared<Benchmarker>("Transaction computation", buddy->logger);
+                    std::make_shared<Benchmarker>("Transaction computation", BENCHMARK_HISTOGRAM("Transaction computation"), buddy->logger);
                 insertionBenchmark->start();
 
                 auto &batchState = buddy->savedState.getValue().batches[currentBatchIndex];
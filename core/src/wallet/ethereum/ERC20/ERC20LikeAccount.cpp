@@ -95,39 +95,58 @@ namespace ledger {
             const std::chrono::system_clock::time_point& endDate,
             api::TimePeriod precision
         ) {
-            auto operations = getOperations();
-            // manually sort by date
-            std::sort(
-                operations.begin(),
-                operations.end(),
-                [](
-                    const std::shared_ptr<api::ERC20LikeOperation>& a,
-                    const std::shared_ptr<api::ERC20LikeOperation>& b
-                ) {
-                    return a->getTime() < b->getTime();
+            auto localAccount = _account.lock();
+            if (!localAccount) {
+                throw make_exception(api::ErrorCode::NULL_POINTER, "Account was released.");
+            }
+
+            // The balance only depends on the date, the type and the value of the operations, no
+            // need to build full operations. Operations after the period holding endDate can't
+            // change the history, they are left in the database.
+            struct BalanceChange {
+                std::chrono::system_clock::time_point date;
+                api::OperationType type;
+                BigInt value;
+            };
+            auto upperDate = startDate;
+            while (upperDate < endDate) {
+                upperDate = DateUtils::incrementDate(upperDate, precision);
+            }
+            std::vector<BalanceChange> changes;
+            {
+                soci::session sql(localAccount->getWallet()->getDatabase()->getReadonlyPool());
+                // Dates are stored as fixed width ISO 8601 strings, their order is the date order
+                auto upperDateString = DateUtils::toJSON(upperDate);
+                soci::rowset<soci::row> rows = (sql.prepare << "SELECT date, type, value FROM erc20_operations"
+                        " WHERE account_uid = :account_uid AND date <= :upper_date"
+                        " ORDER BY date", soci::use(_accountUid), soci::use(upperDateString));
+                for (auto& row : rows) {
+                    changes.push_back(BalanceChange{
+                        DateUtils::fromJSON(row.get<std::string>(0)),
+                        api::from_string<api::OperationType>(row.get<std::string>(1)),
+                        BigInt::fromHex(row.get<std::string>(2))
+                    });
                 }
-            );
+            }
 
             // a small type used to pick implementations used by agnostic::getBalanceHistoryFor.
             struct OperationStrategy {
-                static inline std::chrono::system_clock::time_point date(std::shared_ptr<api::ERC20LikeOperation>& op) {
-                    return op->getTime();
+                static inline std::chrono::system_clock::time_point date(const BalanceChange& change) {
+                    return change.date;
                 }
 
                 static inline std::shared_ptr<api::BigInt> value_constructor(const BigInt& v) {
                     return std::make_shared<api::BigIntImpl>(v);
                 }
 
-                static inline void update_balance(std::shared_ptr<api::ERC20LikeOperation>& op, BigInt& sum) {
-                    auto value = BigInt(op->getValue()->toString(DECIMAL_NUM_BASE));
-
-                    switch (op->getOperationType()) {
+                static inline void update_balance(const BalanceChange& change, BigInt& sum) {
+                    switch (change.type) {
                         case api::OperationType::RECEIVE:
-                            sum = sum + value;
+                            sum = sum + change.value;
                             break;
 
                         case api::OperationType::SEND:
-                            sum = sum - value;
+                            sum = sum - change.value;
                             break;
                         default:
                             break;
@@ -139,8 +158,8 @@ namespace ledger {
                 startDate,
                 endDate,
                 precision,
-                operations.cbegin(),
-                operations.cend(),
+                changes.cbegin(),
+                changes.cend(),
                 BigInt()
             );
         }
@@ -51,6 +51,8 @@
 #include <math/Base58.hpp>
 #include <utils/Option.hpp>
 #include <utils/DateUtils.hpp>
+#include <api/Configuration.hpp>
+#include <api/ConfigurationDefaults.hpp>
 #include <wallet/ethereum/database/EthereumLikeOperationDatabaseHelper.hpp>
 
 #include <database/soci-number.h>
@@ -66,7 +68,10 @@ namespace ledger {
                                                  int32_t index,
                                                  const std::shared_ptr<EthereumLikeBlockchainExplorer>& explorer,
                                                  const std::shared_ptr<EthereumLikeAccountSynchronizer>& synchronizer,
-                                                 const std::shared_ptr<EthereumLikeKeychain>& keychain): AbstractAccount(wallet, index) {
+                                                 const std::shared_ptr<EthereumLikeKeychain>& keychain): AbstractAccount(wallet, index),
+                                                 _erc20BalanceCache(std::chrono::seconds(wallet->getConfiguration()->getInt(api::Configuration::TTL_CACHE)
+                                                                                                 .value_or(api::ConfigurationDefaults::DEFAULT_TTL_CACHE))),
+                                                 _erc20BalancesGeneration(0) {
             _explorer = explorer;
             _synchronizer = synchronizer;
             _keychain = keychain;
@@ -210,20 +215,19 @@ namespace ledger {
             auto erc20AccountUid = AccountDatabaseHelper::createERC20AccountUid(getAccountUid(), erc20ContractAddress);
 
             //Check if account already exists
-            auto needNewAccount = true;
-            for (auto& account : _erc20LikeAccounts) {
-                auto erc20Account = std::static_pointer_cast<ERC20LikeAccount>(account);
-                if (erc20Account->getToken().contractAddress == erc20ContractAddress &&
-                    erc20Account->getAddress() == _accountAddress) {
-                    //Update account
-                    erc20Account->putOperation(operation, erc20Operation);
-                    needNewAccount = false;
+            std::shared_ptr<ERC20LikeAccount> erc20Account;
+            {
+                std::lock_guard<std::mutex> lock(_erc20AccountsLock);
+                auto it = _erc20AccountsByContract.find(erc20ContractAddress);
+                if (it != _erc20AccountsByContract.end()) {
+                    erc20Account = it->second;
                 }
-
             }
-
-            //Create a new account
-            if (needNewAccount) {
+            if (erc20Account) {
+                //Update account
+                erc20Account->putOperation(operation, erc20Operation);
+            } else {
+                //Create a new account
                 // TODO replace this
                 auto erc20Token = api::ERC20Token("UNKNOWN_TOKEN", "UNKNOWN", erc20ContractAddress, 0);
 
@@ -233,9 +237,7 @@ namespace ledger {
                                                                      getWallet()->getCurrency(),
                                                                      std::dynamic_pointer_cast<EthereumLikeAccount>(shared_from_this()));
                 data->accounts.push_back(newAccount);
-                _erc20LikeAccounts.push_back(newAccount);
-                //Persist erc20 account
-                int erc20AccountCount = 0;
+                registerERC20Account(newAccount);
                 newAccount->putOperation(operation, erc20Operation);
             }
         }
@@ -493,6 +495,7 @@ namespace ledger {
 
                     auto const context = result.getValue();
                     self->getWallet()->invalidateBalanceCache(self->getIndex());
+                    self->invalidateERC20Balances();
                     payload->putInt(api::Account::EV_SYNC_LAST_BLOCK_HEIGHT, static_cast<int32_t>(context.lastBlockHeight));
                     payload->putInt(api::Account::EV_SYNC_NEW_OPERATIONS, static_cast<int32_t>(context.newOperations));
 
@@ -584,6 +587,7 @@ namespace ledger {
                     return operations.size();
                 });
                 self->getWallet()->invalidateBalanceCache(self->getIndex());
+                self->invalidateERC20Balances();
                 return txHash;
             }).callback(getMainExecutionContext(), callback);
         }
@@ -601,6 +605,7 @@ namespace ledger {
 
         std::vector<std::shared_ptr<api::ERC20LikeAccount>>
         EthereumLikeAccount::getERC20Accounts() {
+                std::lock_guard<std::mutex> lock(_erc20AccountsLock);
                 return _erc20LikeAccounts;
         }
 
@@ -623,6 +628,28 @@ namespace ledger {
         }
 
         FuturePtr<api::BigInt> EthereumLikeAccount::getERC20Balance(const std::string & erc20Address) {
+            auto cached = _erc20BalanceCache.get(erc20Address);
+            if (cached.nonEmpty()) {
+                return FuturePtr<api::BigInt>::successful(std::make_shared<api::BigIntImpl>(cached.getValue()));
+            }
+            bool isSubAccount;
+            {
+                std::lock_guard<std::mutex> lock(_erc20AccountsLock);
+                isSubAccount = _erc20AccountsByContract.find(erc20Address) != _erc20AccountsByContract.end();
+            }
+            if (isSubAccount) {
+                // Refresh all the tokens at once, the other sub accounts will likely ask for theirs
+                auto self = getSelf();
+                return getAllERC20Balances().flatMapPtr<api::BigInt>(getMainExecutionContext(), [self, erc20Address] (const std::shared_ptr<ERC20Balances> &balances) {
+                    auto it = balances->find(erc20Address);
+                    if (it == balances->end()) {
+                        return self->_explorer->getERC20Balance(self->_keychain->getAddress()->toEIP55(), erc20Address).mapPtr<api::BigInt>(self->getMainExecutionContext(), [] (const std::shared_ptr<BigInt> &erc20Balance) -> std::shared_ptr<api::BigInt> {
+                            return std::make_shared<api::BigIntImpl>(*erc20Balance);
+                        });
+                    }
+                    return FuturePtr<api::BigInt>::successful(std::make_shared<api::BigIntImpl>(it->second));
+                });
+            }
             return _explorer->getERC20Balance(_keychain->getAddress()->toEIP55(), erc20Address).mapPtr<api::BigInt>(getMainExecutionContext(), [] (const std::shared_ptr<BigInt> &erc20Balance) -> std::shared_ptr<api::BigInt> {
                 return std::make_shared<api::BigIntImpl>(*erc20Balance);
             });
@@ -648,6 +675,52 @@ namespace ledger {
             getERC20Balances(erc20Addresses).callback(getMainExecutionContext(), callback);
         }
 
+        FuturePtr<EthereumLikeAccount::ERC20Balances> EthereumLikeAccount::getAllERC20Balances() {
+            std::lock_guard<std::mutex> lock(_erc20AccountsLock);
+            if (_erc20BalancesRequest.nonEmpty()) {
+                return _erc20BalancesRequest.getValue();
+            }
+            std::vector<std::string> contracts;
+            contracts.reserve(_erc20AccountsByContract.size());
+            for (const auto& account : _erc20AccountsByContract) {
+                contracts.push_back(account.first);
+            }
+            auto self = getSelf();
+            auto generation = _erc20BalancesGeneration;
+            auto request = _explorer->getERC20Balances(_keychain->getAddress()->toEIP55(), contracts)
+                    .mapPtr<ERC20Balances>(getContext(), [self, contracts, generation] (const std::vector<BigInt> &balances) {
+                        if (balances.size() != contracts.size()) {
+                            throw make_exception(api::ErrorCode::API_ERROR, "Expected {} ERC20 balances, got {}", contracts.size(), balances.size());
+                        }
+                        auto result = std::make_shared<ERC20Balances>();
+                        for (std::size_t i = 0; i < contracts.size(); i++) {
+                            result->emplace(contracts[i], balances[i]);
+                        }
+                        std::lock_guard<std::mutex> lock(self->_erc20AccountsLock);
+                        if (generation == self->_erc20BalancesGeneration) {
+                            for (const auto& balance : *result) {
+                                self->_erc20BalanceCache.put(balance.first, balance.second);
+                            }
+                        }
+                        return result;
+                    });
+            _erc20BalancesRequest = request;
+            request.onComplete(getContext(), [self, generation] (const TryPtr<ERC20Balances> &) {
+                std::lock_guard<std::mutex> lock(self->_erc20AccountsLock);
+                if (generation == self->_erc20BalancesGeneration) {
+                    self->_erc20BalancesRequest = Option<FuturePtr<ERC20Balances>>();
+                }
+            });
+            return request;
+        }
+
+        void EthereumLikeAccount::invalidateERC20Balances() {
+            std::lock_guard<std::mutex> lock(_erc20AccountsLock);
+            _erc20BalancesGeneration += 1;
+            _erc20BalancesRequest = Option<FuturePtr<ERC20Balances>>();
+            _erc20BalanceCache.clear();
+        }
+
         void EthereumLikeAccount::addERC20Accounts(soci::session &sql,
                                                    const std::vector<ERC20LikeAccountDatabaseEntry> &erc20Entries) {
             auto self = std::dynamic_pointer_cast<EthereumLikeAccount>(shared_from_this());
@@ -658,10 +731,17 @@ namespace ledger {
                                                                           self->getKeychain()->getAddress()->toEIP55(),
                                                                           self->getWallet()->getCurrency(),
                                                                           self);
-                _erc20LikeAccounts.push_back(newERC20Account);
+                registerERC20Account(newERC20Account);
             }
         }
 
+        void EthereumLikeAccount::registerERC20Account(const std::shared_ptr<ERC20LikeAccount> &account) {
+            std::lock_guard<std::mutex> lock(_erc20AccountsLock);
+            // Sub accounts all share the address of this account, the contract identifies them
+            _erc20AccountsByContract[account->getToken().contractAddress] = account;
+            _erc20LikeAccounts.push_back(account);
+        }
+
         std::shared_ptr<api::EthereumLikeTransactionBuilder> EthereumLikeAccount::buildTransaction() {
                 auto self = std::dynamic_pointer_cast<EthereumLikeAccount>(shared_from_this());
                 auto buildFunction = [self] (const EthereumLikeTransactionBuildRequest& request, const std::shared_ptr<EthereumLikeBlockchainExplorer> &explorer) -> Future<std::shared_ptr<api::EthereumLikeTransaction>> {
@@ -49,9 +49,12 @@
 #include <wallet/ethereum/keychains/EthereumLikeKeychain.hpp>
 #include <wallet/ethereum/ERC20/ERC20LikeAccount.h>
 #include <wallet/ethereum/database/EthereumLikeAccountDatabaseEntry.h>
+#include <utils/TTLCache.h>
+#include <unordered_map>
 
 namespace ledger {
     namespace core {
+        class ERC20LikeAccount;
         class EthereumLikeAccount : public api::EthereumLikeAccount, public AbstractAccount {
         public:
 
@@ -130,6 +133,14 @@ namespace ledger {
                 const std::shared_ptr<api::StringCallback> & callback,
                 const std::string& correlationId);
 
+            using ERC20Balances = std::unordered_map<std::string, BigInt>;
+            // Fetches the balances of all the ERC20 sub accounts in a single request, concurrent
+            // callers share the request in flight
+            FuturePtr<ERC20Balances> getAllERC20Balances();
+            // Drops the cached balances and the request in flight, which may predate the change
+            void invalidateERC20Balances();
+            void registerERC20Account(const std::shared_ptr<ERC20LikeAccount> &account);
+
         private:
             std::shared_ptr<EthereumLikeAccount> getSelf();
             std::shared_ptr<EthereumLikeKeychain> _keychain;
@@ -143,6 +154,13 @@ namespace ledger {
             uint64_t _currentBlockHeight;
             std::vector<ERC20LikeAccountDatabaseEntry> erc20Entries;
             std::vector<std::shared_ptr<api::ERC20LikeAccount> >_erc20LikeAccounts;
+            // Same sub accounts, by token contract address
+            std::unordered_map<std::string, std::shared_ptr<ERC20LikeAccount>> _erc20AccountsByContract;
+            TTLCache<std::string, BigInt> _erc20BalanceCache;
+            Option<FuturePtr<ERC20Balances>> _erc20BalancesRequest;
+            // Bumped on each invalidation, results of older requests are not cached
+            uint64_t _erc20BalancesGeneration;
+            std::mutex _erc20AccountsLock;
             std::mutex _erc20EventLock;
             std::shared_ptr<api::Event> _batchedErc20Event;
         };
@@ -0,0 +1,426 @@
+/*
+ *
+ * PushSynchronizer
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include "PushSynchronizer.hpp"
+#include <utils/LambdaRunnable.hpp>
+#include <utils/ImmediateExecutionContext.hpp>
+#include <rapidjson/document.h>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+namespace ledger {
+    namespace core {
+
+        namespace {
+            // Bounds the memory used by the addresses nobody owns, on busy chains almost all of them
+            const std::size_t MAX_UNOWNED_ADDRESSES = 100000;
+
+            // Keys holding the addresses involved in a notified transaction (bitcoin inputs and
+            // outputs, account based transactions)
+            bool isAddressKey(const rapidjson::Value& key) {
+                static const char* const KEYS[] = {"address", "from", "to", "sender", "recipient"};
+                for (auto k : KEYS) {
+                    if (std::strcmp(key.GetString(), k) == 0) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void collectAddresses(const rapidjson::Value& value, std::unordered_set<std::string>& out) {
+                if (value.IsObject()) {
+                    for (auto it = value.MemberBegin(); it != value.MemberEnd(); it++) {
+                        if (it->value.IsString() && isAddressKey(it->name)) {
+                            out.emplace(it->value.GetString(), it->value.GetStringLength());
+                        } else {
+                            collectAddresses(it->value, out);
+                        }
+                    }
+                } else if (value.IsArray()) {
+                    for (const auto& item : value.GetArray()) {
+                        collectAddresses(item, out);
+                    }
+                }
+            }
+        }
+
+        PushSynchronizer::Parameters::Parameters() :
+            debounce(2000), pollingInterval(60000), maxBatchSize(16), confirmationBlocks(3) {
+        }
+
+        PushSynchronizer::PushSynchronizer(const std::shared_ptr<WebSocketClient> &client,
+                                           const std::shared_ptr<api::ExecutionContext> &context,
+                                           const Parameters &parameters) :
+            _client(client), _context(context), _parameters(parameters) {
+            _parameters.maxBatchSize = std::max(_parameters.maxBatchSize, 1);
+        }
+
+        void PushSynchronizer::subscribe(const std::string &endpoint, const Subscriber &subscriber) {
+            bool shouldConnect = false;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto& state = _endpoints[endpoint];
+                state.subscribers[subscriber.uid] = subscriber;
+                // The newcomer may own addresses already indexed (e.g. the same xpub in two wallets)
+                state.owners.clear();
+                state.ownersGeneration += 1;
+                forgetUnownedAddresses(state);
+                if (!state.connection && !state.connecting && !state.polling) {
+                    state.connecting = true;
+                    shouldConnect = true;
+                }
+            }
+            if (shouldConnect) {
+                connect(endpoint);
+            }
+        }
+
+        void PushSynchronizer::unsubscribe(const std::string &uid) {
+            std::vector<std::shared_ptr<WebSocketConnection>> connections;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                for (auto& endpoint : _endpoints) {
+                    auto& state = endpoint.second;
+                    if (state.subscribers.erase(uid) == 0) {
+                        continue;
+                    }
+                    state.dirty.erase(uid);
+                    state.unconfirmed.erase(uid);
+                    for (auto owner = state.owners.begin(); owner != state.owners.end();) {
+                        owner = owner->second == uid ? state.owners.erase(owner) : std::next(owner);
+                    }
+                    if (state.subscribers.empty() && state.connection) {
+                        // Closing the connection doesn't notify us anymore (see onEvent)
+                        connections.push_back(state.connection);
+                        state.connection = nullptr;
+                    }
+                }
+            }
+            for (const auto& connection : connections) {
+                connection->close();
+            }
+        }
+
+        void PushSynchronizer::unsubscribeAll() {
+            std::vector<std::shared_ptr<WebSocketConnection>> connections;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                for (auto& endpoint : _endpoints) {
+                    auto& state = endpoint.second;
+                    state.subscribers.clear();
+                    state.dirty.clear();
+                    state.unconfirmed.clear();
+                    state.owners.clear();
+                    forgetUnownedAddresses(state);
+                    if (state.connection) {
+                        connections.push_back(state.connection);
+                        state.connection = nullptr;
+                    }
+                }
+            }
+            for (const auto& connection : connections) {
+                connection->close();
+            }
+        }
+
+        bool PushSynchronizer::isConnected(const std::string &endpoint) {
+            std::lock_guard<std::mutex> lock(_lock);
+            auto it = _endpoints.find(endpoint);
+            return it != _endpoints.end() && it->second.connection != nullptr;
+        }
+
+        void PushSynchronizer::connect(const std::string &endpoint) {
+            // The websocket client may call the handler synchronously, it must be called unlocked
+            std::weak_ptr<PushSynchronizer> weakSelf = shared_from_this();
+            _client->connect(endpoint, [weakSelf, endpoint] (WebSocketEventType type,
+                                                             const std::shared_ptr<WebSocketConnection>& connection,
+                                                             const Option<std::string>& message,
+                                                             Option<api::ErrorCode> error) {
+                if (auto self = weakSelf.lock()) {
+                    self->onEvent(endpoint, type, connection, message);
+                }
+            });
+        }
+
+        void PushSynchronizer::onEvent(const std::string &endpoint, WebSocketEventType type,
+                                       const std::shared_ptr<WebSocketConnection> &connection,
+                                       const Option<std::string> &message) {
+            if (type == WebSocketEventType::RECEIVE) {
+                if (message.nonEmpty()) {
+                    onNotification(endpoint, message.getValue());
+                }
+                return;
+            }
+            std::shared_ptr<WebSocketConnection> unused;
+            bool startPolling = false;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto& state = _endpoints[endpoint];
+                state.connecting = false;
+                if (type == WebSocketEventType::CONNECT) {
+                    if (state.subscribers.empty()) {
+                        // Everybody left while we were connecting
+                        unused = connection;
+                    } else {
+                        state.connection = connection;
+                        if (state.polling) {
+                            // Back from a disconnection, catch up with the missed notifications
+                            state.polling = false;
+                            for (const auto& subscriber : state.subscribers) {
+                                state.dirty.insert(subscriber.first);
+                            }
+                            scheduleFlush(endpoint, state, std::chrono::milliseconds(0));
+                        }
+                    }
+                } else if (state.connection == connection || !state.connection) {
+                    state.connection = nullptr;
+                    if (!state.polling && !state.subscribers.empty()) {
+                        state.polling = true;
+                        startPolling = true;
+                    }
+                }
+            }
+            if (unused) {
+                unused->close();
+            }
+            if (startPolling) {
+                auto self = shared_from_this();
+                _context->delay(make_runnable([self, endpoint] () {
+                    self->poll(endpoint);
+                }), _parameters.pollingInterval.count());
+            }
+        }
+
+        void PushSynchronizer::onNotification(const std::string &endpoint, const std::string &message) {
+            rapidjson::Document document;
+            document.Parse(message.c_str(), message.size());
+            if (document.HasParseError() || !document.IsObject() || !document.HasMember("payload") ||
+                !document["payload"].IsObject()) {
+                return;
+            }
+            const auto& payload = document["payload"];
+            if (!payload.HasMember("type") || !payload["type"].IsString()) {
+                return;
+            }
+            const std::string notificationType = payload["type"].GetString();
+            std::unordered_set<std::string> addresses;
+            if (notificationType == "new-transaction" && payload.HasMember("transaction")) {
+                collectAddresses(payload["transaction"], addresses);
+            } else if (notificationType != "new-block") {
+                return;
+            }
+
+            if (notificationType == "new-block") {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto it = _endpoints.find(endpoint);
+                if (it == _endpoints.end()) {
+                    return;
+                }
+                auto& state = it->second;
+                for (auto unconfirmed = state.unconfirmed.begin(); unconfirmed != state.unconfirmed.end();) {
+                    state.dirty.insert(unconfirmed->first);
+                    if (--unconfirmed->second <= 0) {
+                        unconfirmed = state.unconfirmed.erase(unconfirmed);
+                    } else {
+                        unconfirmed++;
+                    }
+                }
+                scheduleFlush(endpoint, state, _parameters.debounce);
+                return;
+            }
+
+            // Addresses are resolved from the index, the other ones are looked up by the subscribers
+            // (keychains which may hit the database) with the lock released
+            std::unordered_set<std::string> concerned;
+            std::vector<std::string> unknown;
+            std::vector<Subscriber> subscribers;
+            uint64_t ownersGeneration;
+            uint64_t generation;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto it = _endpoints.find(endpoint);
+                if (it == _endpoints.end()) {
+                    return;
+                }
+                auto& state = it->second;
+                for (const auto& address : addresses) {
+                    auto owners = state.owners.equal_range(address);
+                    if (owners.first != owners.second) {
+                        for (auto owner = owners.first; owner != owners.second; owner++) {
+                            concerned.insert(owner->second);
+                        }
+                    } else if (state.unowned.find(address) == state.unowned.end()) {
+                        unknown.push_back(address);
+                    }
+                }
+                if (!unknown.empty()) {
+                    subscribers.reserve(state.subscribers.size());
+                    for (const auto& subscriber : state.subscribers) {
+                        subscribers.push_back(subscriber.second);
+                    }
+                }
+                ownersGeneration = state.ownersGeneration;
+                generation = state.unownedGeneration;
+            }
+
+            std::vector<std::pair<std::string, std::string>> resolved;
+            std::vector<std::string> unowned;
+            for (const auto& address : unknown) {
+                auto owned = false;
+                for (const auto& subscriber : subscribers) {
+                    if (subscriber.ownsAddress(address)) {
+                        resolved.emplace_back(address, subscriber.uid);
+                        owned = true;
+                    }
+                }
+                if (!owned) {
+                    unowned.push_back(address);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(_lock);
+            auto it = _endpoints.find(endpoint);
+            if (it == _endpoints.end()) {
+                return;
+            }
+            auto& state = it->second;
+            for (const auto& owner : resolved) {
+                // Skip the accounts which left during the lookup, and don't index owners looked up
+                // without the accounts which joined meanwhile
+                if (state.subscribers.find(owner.second) != state.subscribers.end()) {
+                    if (ownersGeneration == state.ownersGeneration) {
+                        state.owners.emplace(owner.first, owner.second);
+                    }
+                    concerned.insert(owner.second);
+                }
+            }
+            // Misses seen before the last forget may be outdated already
+            if (generation == state.unownedGeneration) {
+                for (auto& address : unowned) {
+                    if (state.unowned.size() >= MAX_UNOWNED_ADDRESSES) {
+                        forgetUnownedAddresses(state);
+                    }
+                    state.unowned.insert(std::move(address));
+                }
+            }
+            for (const auto& uid : concerned) {
+                if (state.subscribers.find(uid) != state.subscribers.end()) {
+                    state.dirty.insert(uid);
+                    state.unconfirmed[uid] = _parameters.confirmationBlocks;
+                }
+            }
+            scheduleFlush(endpoint, state, _parameters.debounce);
+        }
+
+        void PushSynchronizer::forgetUnownedAddresses(Endpoint &state) {
+            // Called locked
+            state.unowned.clear();
+            state.unownedGeneration += 1;
+        }
+
+        void PushSynchronizer::poll(const std::string &endpoint) {
+            bool reconnect = false;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto& state = _endpoints[endpoint];
+                if (!state.polling) {
+                    return;
+                }
+                if (state.subscribers.empty()) {
+                    state.polling = false;
+                    return;
+                }
+                for (const auto& subscriber : state.subscribers) {
+                    state.dirty.insert(subscriber.first);
+                }
+                scheduleFlush(endpoint, state, std::chrono::milliseconds(0));
+                if (!state.connecting) {
+                    state.connecting = true;
+                    reconnect = true;
+                }
+            }
+            if (reconnect) {
+                connect(endpoint);
+            }
+            // Still disconnected after the attempt (a failed connection closes synchronously or later,
+            // in both cases polling goes on until a CONNECT event)
+            auto self = shared_from_this();
+            _context->delay(make_runnable([self, endpoint] () {
+                self->poll(endpoint);
+            }), _parameters.pollingInterval.count());
+        }
+
+        void PushSynchronizer::scheduleFlush(const std::string &endpoint, Endpoint &state,
+                                             std::chrono::milliseconds delay) {
+            // Called locked. A flush already scheduled (or syncs in flight) will pick the new accounts.
+            if (state.dirty.empty() || state.flushScheduled || state.inFlight > 0) {
+                return;
+            }
+            state.flushScheduled = true;
+            auto self = shared_from_this();
+            _context->delay(make_runnable([self, endpoint] () {
+                self->flush(endpoint);
+            }), delay.count());
+        }
+
+        void PushSynchronizer::flush(const std::string &endpoint) {
+            std::vector<std::function<Future<Unit> ()>> batch;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto& state = _endpoints[endpoint];
+                state.flushScheduled = false;
+                for (auto it = state.dirty.begin(); it != state.dirty.end() && batch.size() < static_cast<std::size_t>(_parameters.maxBatchSize);) {
+                    auto subscriber = state.subscribers.find(*it);
+                    if (subscriber != state.subscribers.end()) {
+                        batch.push_back(subscriber->second.synchronize);
+                    }
+                    it = state.dirty.erase(it);
+                }
+                state.inFlight += batch.size();
+            }
+            auto self = shared_from_this();
+            for (const auto& synchronize : batch) {
+                auto future = Future<Unit>::async(ImmediateExecutionContext::INSTANCE, synchronize);
+                future.onComplete(_context, [self, endpoint] (const Try<Unit>&) {
+                    std::lock_guard<std::mutex> lock(self->_lock);
+                    auto& state = self->_endpoints[endpoint];
+                    state.inFlight -= 1;
+                    // The synchronization may have derived new addresses
+                    self->forgetUnownedAddresses(state);
+                    // Next batch, accounts notified during the syncs included
+                    if (state.inFlight == 0) {
+                        self->scheduleFlush(endpoint, state, std::chrono::milliseconds(0));
+                    }
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ *
+ * PushSynchronizer
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#ifndef LEDGER_CORE_PUSHSYNCHRONIZER_HPP
+#define LEDGER_CORE_PUSHSYNCHRONIZER_HPP
+
+#include <api/ExecutionContext.hpp>
+#include <async/Future.hpp>
+#include <net/WebSocketClient.h>
+#include <net/WebSocketConnection.h>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ledger {
+    namespace core {
+
+        /**
+         * Synchronizes accounts when the explorer notifies activity on them, instead of having every
+         * account poll a full synchronization.
+         *
+         * Accounts subscribe to the websocket endpoint of their explorer. A "new-transaction"
+         * notification marks the accounts owning one of its addresses, a "new-block" one marks the
+         * accounts having seen unconfirmed activity during the last blocks. Marked accounts are
+         * synchronized after a debounce delay, at most maxBatchSize at a time, so a burst of
+         * notifications ends up in a single synchronization per account.
+         *
+         * While an endpoint is disconnected, all its accounts are synchronized every pollingInterval
+         * and the connection is retried. Once it is back, the accounts are synchronized one last
+         * time to catch up with the notifications missed meanwhile.
+         */
+        class PushSynchronizer : public std::enable_shared_from_this<PushSynchronizer> {
+        public:
+            struct Parameters {
+                std::chrono::milliseconds debounce;
+                std::chrono::milliseconds pollingInterval;
+                int32_t maxBatchSize;
+                // Number of blocks after which an account with unconfirmed activity isn't
+                // synchronized on new blocks anymore
+                int32_t confirmationBlocks;
+
+                Parameters();
+            };
+
+            struct Subscriber {
+                std::string uid;
+                std::function<bool (const std::string& address)> ownsAddress;
+                // Completes when the synchronization ends, successfully or not
+                std::function<Future<Unit> ()> synchronize;
+            };
+
+            PushSynchronizer(const std::shared_ptr<WebSocketClient>& client,
+                             const std::shared_ptr<api::ExecutionContext>& context,
+                             const Parameters& parameters = Parameters());
+
+            void subscribe(const std::string& endpoint, const Subscriber& subscriber);
+            // Removes the account from the endpoint it subscribed to
+            void unsubscribe(const std::string& uid);
+            // Removes every account and closes the connections
+            void unsubscribeAll();
+            bool isConnected(const std::string& endpoint);
+
+        private:
+            struct Endpoint {
+                std::unordered_map<std::string, Subscriber> subscribers;
+                std::shared_ptr<WebSocketConnection> connection;
+                bool connecting = false;
+                bool polling = false;
+                // Accounts waiting for a synchronization, and number of syncs in flight
+                std::unordered_set<std::string> dirty;
+                bool flushScheduled = false;
+                int32_t inFlight = 0;
+                // Accounts with unconfirmed activity and the number of blocks left to watch them
+                std::unordered_map<std::string, int32_t> unconfirmed;
+                // Accounts owning the addresses already looked up, so that subscribers are asked
+                // once per address until the next subscription. Addresses owned by nobody are only
+                // remembered until the next subscription or synchronization, either may bring new
+                // addresses.
+                std::unordered_multimap<std::string, std::string> owners;
+                uint64_t ownersGeneration = 0;
+                std::unordered_set<std::string> unowned;
+                uint64_t unownedGeneration = 0;
+            };
+
+            void connect(const std::string& endpoint);
+            void onEvent(const std::string& endpoint, WebSocketEventType type,
+                         const std::shared_ptr<WebSocketConnection>& connection,
+                         const Option<std::string>& message);
+            void onNotification(const std::string& endpoint, const std::string& message);
+            void forgetUnownedAddresses(Endpoint& state);
+            void poll(const std::string& endpoint);
+            void scheduleFlush(const std::string& endpoint, Endpoint& state, std::chrono::milliseconds delay);
+            void flush(const std::string& endpoint);
+
+            std::shared_ptr<WebSocketClient> _client;
+            std::shared_ptr<api::ExecutionContext> _context;
+            Parameters _parameters;
+            std::mutex _lock;
+            std::unordered_map<std::string, Endpoint> _endpoints;
+        };
+    }
+}
+
+#endif //LEDGER_CORE_PUSHSYNCHRONIZER_HPP
@@ -74,6 +74,7 @@ namespace ledger {
 
             // WS management
             _wsClient = std::make_shared<WebSocketClient>(webSocketClient);
+            _pushSynchronizer = std::make_shared<PushSynchronizer>(_wsClient, getContext());
 
             // Preferences management
             if (!_externalPreferencesBackend) {
@@ -121,6 +122,11 @@ namespace ledger {
             _threadPoolExecutionContext = _threadDispatcher->getThreadPoolExecutionContext(fmt::format("pool_{}_thread_pool", name));
         }
 
+        WalletPool::~WalletPool() {
+            // The synchronizer may outlive the pool in its pending tasks, don't let it sync accounts anymore
+            _pushSynchronizer->unsubscribeAll();
+        }
+
         std::shared_ptr<WalletPool>
         WalletPool::newInstance(
             const std::string &name,
@@ -471,6 +477,12 @@ namespace ledger {
             auto self = shared_from_this();
             return async<Unit>([=]() {
                 soci::session sql(self->getDatabaseSessionPool()->getPool());
+                auto walletUid = WalletDatabaseEntry::createWalletUid(self->getName(), name);
+                soci::rowset<std::string> accounts = (sql.prepare << "SELECT uid FROM accounts WHERE wallet_uid = :wallet_uid",
+                                                      soci::use(walletUid));
+                for (const auto& accountUid : accounts) {
+                    self->_pushSynchronizer->unsubscribe(accountUid);
+                }
                 soci::transaction tr(sql);
                 PoolDatabaseHelper::removeWalletByName(sql, name);
                 tr.commit();
@@ -494,6 +506,10 @@ namespace ledger {
             return _wsClient;
         }
 
+        std::shared_ptr<PushSynchronizer> WalletPool::getPushSynchronizer() const {
+            return _pushSynchronizer;
+        }
+
         Future<api::Block> WalletPool::getLastBlock(const std::string &currencyName) {
             auto optBlock = _blockCache.get(currencyName);
             if (optBlock.hasValue()) {
@@ -578,7 +594,8 @@ namespace ledger {
             auto self = shared_from_this();
 
             return Future<api::ErrorCode>::async(_threadDispatcher->getMainExecutionContext(), [=]() {
-                // drop the main database first
+                // drop the main database first, no account is left to synchronize
+                self->_pushSynchronizer->unsubscribeAll();
                 self->getDatabaseSessionPool()->performDatabaseRollback();
 
                 // then reset preferences
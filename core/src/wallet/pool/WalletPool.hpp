@@ -55,6 +55,7 @@
 #include <wallet/common/AbstractWalletFactory.hpp>
 #include <events/EventPublisher.hpp>
 #include <net/WebSocketClient.h>
+#include <wallet/pool/PushSynchronizer.hpp>
 #include <utils/TTLCache.h>
 namespace ledger {
     namespace core {
@@ -64,6 +65,7 @@ namespace ledger {
         public:
             std::shared_ptr<HttpClient> getHttpClient(const std::string& baseUrl);
             std::shared_ptr<WebSocketClient> getWebSocketClient() const;
+            std::shared_ptr<PushSynchronizer> getPushSynchronizer() const;
             std::shared_ptr<Preferences> getExternalPreferences() const;
             std::shared_ptr<Preferences> getInternalPreferences() const;
             std::shared_ptr<api::PathResolver> getPathResolver() const;
@@ -124,7 +126,7 @@ namespace ledger {
                 const std::shared_ptr<api::PreferencesBackend> &internalPreferencesBackend
             );
 
-            ~WalletPool() = default;
+            ~WalletPool();
 
             /// Reset wallet pool.
             ///
@@ -184,6 +186,7 @@ namespace ledger {
 
             // WS management
             std::shared_ptr<WebSocketClient> _wsClient;
+            std::shared_ptr<PushSynchronizer> _pushSynchronizer;
 
             // Preferences management
             std::shared_ptr<api::PreferencesBackend> _externalPreferencesBackend;
@@ -131,6 +131,7 @@ namespace ledger {
             auto requestBody = bodyRequest.getString();
             std::unordered_map<std::string, std::string> headers{{"Content-Type", "application/json"}};
             return _http->POST("", std::vector<uint8_t>(requestBody.begin(), requestBody.end()), headers)
+                    .prioritized()
                     .json().template map<String>(getExplorerContext(), [correlationId](const HttpRequest::JsonResult &result) -> String {
                         auto &json = *std::get<1>(result);
                         if (!json.IsObject() || !json.HasMember("result") ||
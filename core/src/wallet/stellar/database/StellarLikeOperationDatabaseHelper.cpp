@@ -240,7 +240,7 @@ namespace ledger {
                 const std::vector<Operation> &operations) {
             if (operations.empty())
                 return;
-            Benchmarker rawInsert("raw_db_insert_stellar", nullptr);
+            Benchmarker rawInsert("raw_db_insert_stellar", BENCHMARK_HISTOGRAM("raw_db_insert_stellar"), nullptr);
             rawInsert.start();
             PreparedStatement<OperationBinding> operationStmt;
             PreparedStatement<BlockBinding> blockStmt;
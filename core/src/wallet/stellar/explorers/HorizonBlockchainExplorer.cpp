@@ -88,6 +88,7 @@ namespace ledger {
 
         FuturePtr<stellar::FeeStats> HorizonBlockchainExplorer::getRecommendedFees() {
             return http->GET("/fee_stats")
+                    .cached(std::chrono::seconds(30))
                     .template json<FeeStatsParser::Result, Exception>(FeeStatsParser())
                     .map<std::shared_ptr<stellar::FeeStats>>(getContext(), [] (const FeeStatsParser::Response& result) -> std::shared_ptr<stellar::FeeStats> {
                         if (result.isLeft()) {
@@ -152,6 +153,7 @@ namespace ledger {
                 headers["X-Correlation-ID"] = correlationId;
             }
             return http->POST("/transactions", std::vector<uint8_t>(bodyString.begin(), bodyString.end()), headers)
+            .prioritized()
             .json().template map<std::string>(getContext(), [] (const HttpRequest::JsonResult& result) -> std::string {
                 auto& json = *std::get<1>(result);
                 return json["hash"].GetString();
@@ -38,6 +38,8 @@
 #include <api/TezosLikeAddress.hpp>
 #include <api/TezosOperationTag.hpp>
 #include <async/Future.hpp>
+#include <api/Configuration.hpp>
+#include <api/ConfigurationDefaults.hpp>
 #include <wallet/common/database/OperationDatabaseHelper.h>
 #include <wallet/common/database/BlockDatabaseHelper.h>
 #include <wallet/pool/database/CurrenciesDatabaseHelper.hpp>
@@ -62,12 +64,21 @@ using namespace soci;
 namespace ledger {
     namespace core {
 
+        static std::chrono::seconds getCacheTTL(const std::shared_ptr<AbstractWallet> &wallet) {
+            return std::chrono::seconds(wallet->getConfiguration()->getInt(api::Configuration::TTL_CACHE)
+                                                .value_or(api::ConfigurationDefaults::DEFAULT_TTL_CACHE));
+        }
+
         TezosLikeAccount::TezosLikeAccount(const std::shared_ptr<AbstractWallet> &wallet,
                                            int32_t index,
                                            const std::shared_ptr<TezosLikeBlockchainExplorer> &explorer,
                                            const std::shared_ptr<TezosLikeAccountSynchronizer> &synchronizer,
                                            const std::shared_ptr<TezosLikeKeychain> &keychain) : AbstractAccount(wallet, index),
-                                           _currentBlockHeight(0) {
+                                           _currentBlockHeight(0),
+                                           _managerKeyCache(getCacheTTL(wallet)),
+                                           _counterCache(getCacheTTL(wallet)),
+                                           _blockCache(getCacheTTL(wallet)),
+                                           _buildCachesGeneration(0) {
             _explorer = explorer;
             _synchronizer = synchronizer;
             _keychain = keychain;
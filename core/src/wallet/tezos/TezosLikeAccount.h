@@ -46,6 +46,7 @@
 #include <wallet/tezos/synchronizers/TezosLikeAccountSynchronizer.hpp>
 #include <wallet/tezos/keychains/TezosLikeKeychain.h>
 #include <wallet/tezos/database/TezosLikeAccountDatabaseEntry.h>
+#include <utils/TTLCache.h>
 
 namespace ledger {
     namespace core {
@@ -176,6 +177,16 @@ namespace ledger {
                                          const std::shared_ptr<api::StringCallback> &callback,
                                          const std::string& correlationId);
 
+            // Short-lived network values needed to build a transaction, cached for TTL_CACHE seconds.
+            // The manager key and the counter change when the account sends a transaction.
+            Future<std::string> getCachedManagerKey(const std::shared_ptr<TezosLikeBlockchainExplorer> &explorer,
+                                                    const std::string &address);
+            FuturePtr<BigInt> getCachedCounter(const std::shared_ptr<TezosLikeBlockchainExplorer> &explorer,
+                                               const std::string &address);
+            FuturePtr<TezosLikeBlockchainExplorer::Block> getCachedCurrentBlock(const std::shared_ptr<TezosLikeBlockchainExplorer> &explorer);
+            void invalidateBuildCaches();
+            uint64_t getBuildCachesGeneration();
+
             std::pair<api::OperationType, std::string> getOperationTypeAndUidAdditional(const std::string& sender, const std::string& receiver, const std::string& originatedAccountId, const std::string& originatedAccountAddress) const;
 
             std::shared_ptr<TezosLikeKeychain> _keychain;
@@ -186,6 +197,12 @@ namespace ledger {
             std::mutex _synchronizationLock;
             std::vector<std::shared_ptr<api::TezosLikeOriginatedAccount>> _originatedAccounts;
             uint64_t _currentBlockHeight;
+            TTLCache<std::string, std::string> _managerKeyCache;
+            TTLCache<std::string, BigInt> _counterCache;
+            TTLCache<std::string, TezosLikeBlockchainExplorer::Block> _blockCache;
+            // Bumped by invalidateBuildCaches, fetches started before it don't fill the caches
+            std::mutex _buildCachesLock;
+            uint64_t _buildCachesGeneration;
         };
     }
 }
@@ -75,7 +75,7 @@ namespace ledger {
             auto log = logger();
 
             auto eraseDataBenchmarker = std::make_shared<Benchmarker>(
-                fmt::format("erase_data_since/{}", tracePrefix()), log);
+                "erase_data_since", log, tracePrefix());
             eraseDataBenchmarker->start();
             log->debug("[{}] Start erasing data of account : {}", tracePrefix(), getAccountUid());
 
@@ -201,6 +201,10 @@ namespace ledger {
 
                     self->getWallet()->invalidateBalanceCache(self->getIndex());
                     auto const context = result.getValue();
+                    if (context.newOperations > 0) {
+                        // Operations may have been sent from elsewhere
+                        self->invalidateBuildCaches();
+                    }
 
                     payload->putInt(api::Account::EV_SYNC_LAST_BLOCK_HEIGHT, static_cast<int32_t>(context.lastBlockHeight));
                     payload->putInt(api::Account::EV_SYNC_NEW_OPERATIONS, static_cast<int32_t>(context.newOperations));
@@ -244,6 +248,8 @@ namespace ledger {
             _explorer->pushTransaction(transaction, correlationId)
                     .map<std::string>(getContext(),
                                       [self, counter](const String &seq) -> std::string {
+                                            // The counter and the reveal status of the sender have changed
+                                            self->invalidateBuildCaches();
                                             auto txHash = seq.str();
                                             std::cout << "txHash=" << txHash << std::endl;
                                             const std::string optimisticStrategy = self->getWallet()->getConfiguration()->getString(
@@ -307,27 +313,44 @@ namespace ledger {
                     throw make_exception(api::ErrorCode::INVALID_SELF_TX, "Cannot send funds to sending address!");
                 }
                 
-                // Check if balance is sufficient
                 auto currency = self->getWallet()->getCurrency();
                 auto accountAddress = TezosLikeAddress::fromBase58(senderAddress, currency);
+                auto managerAddress = self->getKeychain()->getAddress()->toString();
+                auto protocolUpdate = self->getWallet()
+                        ->getConfiguration()
+                        ->getString(api::TezosConfiguration::TEZOS_PROTOCOL_UPDATE)
+                        .value_or("");
+                const auto counterAddress = protocolUpdate == api::TezosConfigurationDefaults::TEZOS_PROTOCOL_UPDATE_BABYLON ?
+                                            managerAddress : senderAddress;
+
+                // Check if all needed values are set
+                if (!request.transactionGasLimit || !request.storageLimit || !request.transactionFees
+                    || (request.type != api::TezosOperationTag::OPERATION_TAG_DELEGATION && !request.value && !request.wipe)) {
+                    throw make_exception(api::ErrorCode::INVALID_ARGUMENT,
+                                         "Missing mandatory informations (e.g. gasLimit, gasPrice or value).");
+                }
+
+                // None of the network values depends on another one: they are all requested right
+                // away, the chain below only waits for them
+                auto fundedFuture = request.type == api::TezosOperationTag::OPERATION_TAG_TRANSACTION ?
+                                    explorer->isFunded(request.toAddress) : Future<bool>::successful(true);
+                auto managerKeyFuture = self->getCachedManagerKey(explorer, senderAddress.find("KT1") == 0 ? managerAddress : senderAddress);
+                auto counterFuture = self->getCachedCounter(explorer, counterAddress);
+                auto blockFuture = self->getCachedCurrentBlock(explorer);
+
+                // Check if balance is sufficient
                 return explorer->getBalance(std::vector<std::shared_ptr<TezosLikeAddress>>{accountAddress}).flatMapPtr<api::TezosLikeTransaction>(
                         self->getMainExecutionContext(),
-                        [self, request, explorer, accountAddress, currency, senderAddress](const std::shared_ptr<BigInt> &balance) {
-
-                            // Check if all needed values are set
-                            if (!request.transactionGasLimit || !request.storageLimit || !request.transactionFees
-                                || (request.type != api::TezosOperationTag::OPERATION_TAG_DELEGATION && !request.value && !request.wipe)) {
-                                throw make_exception(api::ErrorCode::INVALID_ARGUMENT,
-                                                     "Missing mandatory informations (e.g. gasLimit, gasPrice or value).");
-                            }
+                        [=](const std::shared_ptr<BigInt> &balance) {
+
                             // Check if recepient is allocated or not
                             // because if not we have to add additional fees equal to storage_limit (in mXTZ)
-                            auto getAllocationFee = [self, explorer, request]() -> Future<BigInt> {
+                            auto getAllocationFee = [self, fundedFuture, request]() mutable -> Future<BigInt> {
                                if (request.type != api::TezosOperationTag::OPERATION_TAG_TRANSACTION) {
                                    return Future<BigInt>::successful(BigInt::ZERO);
                                }
                                 // So here we are looking for unallocated / unfunded accounts
-                                return explorer->isFunded(request.toAddress).map<BigInt>(self->getMainExecutionContext(), [request](bool funded) {
+                                return fundedFuture.map<BigInt>(self->getMainExecutionContext(), [request](bool funded) {
                                     // Base unit is uXTZ
                                     return funded ? BigInt::ZERO : *request.storageLimit * BigInt("1000");
                                 });
@@ -337,11 +360,6 @@ namespace ledger {
                                     .flatMapPtr<api::TezosLikeTransaction>(self->getMainExecutionContext(), [=]
                                             (const BigInt &burned) {
 
-                                        auto managerAddress = self->getKeychain()->getAddress()->toString();
-                                        auto protocolUpdate = self->getWallet()
-                                                ->getConfiguration()
-                                                ->getString(api::TezosConfiguration::TEZOS_PROTOCOL_UPDATE)
-                                                .value_or("");
                                         auto tx = std::make_shared<TezosLikeTransactionApi>(currency, protocolUpdate);
                                         // Balance is used only for origination which is always performed from implicit accounts
                                         // In that case senderAddress == self->_keychain->getAddress() so safe to do so
@@ -351,9 +369,9 @@ namespace ledger {
                                         // Note: we can't rely on DB + sent transactions, because
                                         // it is possible to have deleted accounts that hit 0 balance
                                         // during Babylon update (arf ...)
-                                        auto setRevealStatus = [self, explorer, tx, senderAddress, managerAddress, request]() {
+                                        auto setRevealStatus = [self, managerKeyFuture, tx, request]() mutable {
                                             // So here we are looking for unallocated accounts
-                                            return explorer->getManagerKey(senderAddress.find("KT1") == 0 ? managerAddress : senderAddress).map<Unit>(self->getMainExecutionContext(), [tx, request] (const std::string &managerKey) -> Unit {
+                                            return managerKeyFuture.map<Unit>(self->getMainExecutionContext(), [tx, request] (const std::string &managerKey) -> Unit {
                                                 tx->reveal(managerKey.empty());
                                                 std::cout << "Set Reveal:"<< tx->toReveal() << std::endl;
                                                 if (tx->toReveal() && (!request.revealGasLimit || !request.revealFees)) {
@@ -364,7 +382,7 @@ namespace ledger {
                                             });
                                         };
 
-                                        return setRevealStatus().flatMapPtr<api::TezosLikeTransaction>(self->getMainExecutionContext(), [=] (const Unit &result) {
+                                        return setRevealStatus().flatMapPtr<api::TezosLikeTransaction>(self->getMainExecutionContext(), [=] (const Unit &result) mutable {
 
                                             //initialize the value
                                             //note that the value will be recalculated for the wipe mode after calculating fees
@@ -418,10 +436,7 @@ namespace ledger {
                                                                           ->getString(api::TezosConfiguration::TEZOS_XPUB_CURVE)
                                                                           .value_or(api::TezosConfigurationDefaults::TEZOS_XPUB_CURVE_ED25519)));
                                             tx->setType(request.type);
-                                            const auto counterAddress = protocolUpdate == api::TezosConfigurationDefaults::TEZOS_PROTOCOL_UPDATE_BABYLON ?
-                                                                        managerAddress : senderAddress;
-                                            return explorer->getCounter(counterAddress
-                                            ).flatMapPtr<Block>(self->getMainExecutionContext(), [self, tx, explorer, request] (const std::shared_ptr<BigInt> &explorerCounter) {
+                                            return counterFuture.flatMapPtr<Block>(self->getMainExecutionContext(), [self, tx, blockFuture, request] (const std::shared_ptr<BigInt> &explorerCounter) {
                                                     if (!explorerCounter) {
                                                     throw make_exception(api::ErrorCode::RUNTIME_ERROR, "Failed to retrieve counter from network.");
                                                 }
@@ -434,7 +449,7 @@ namespace ledger {
                                                     else {
                                                         tx->setCounter(std::make_shared<BigInt>(++(*explorerCounter)));
                                                     }
-                                                return explorer->getCurrentBlock();
+                                                return blockFuture;
                                                 }).flatMapPtr<TezosLikeTransactionApi>(self->getMainExecutionContext(), [self, explorer, tx, senderAddress] (const std::shared_ptr<Block> &block) {
                                                 tx->setBlockHash(block->hash);
                                                 if (senderAddress.find("KT1") == 0) {
@@ -529,6 +544,67 @@ namespace ledger {
             );
         }
 
+        Future<std::string> TezosLikeAccount::getCachedManagerKey(const std::shared_ptr<TezosLikeBlockchainExplorer> &explorer,
+                                                                  const std::string &address) {
+            auto cached = _managerKeyCache.get(address);
+            if (cached.nonEmpty()) {
+                return Future<std::string>::successful(cached.getValue());
+            }
+            auto self = getSelf();
+            auto generation = getBuildCachesGeneration();
+            return explorer->getManagerKey(address).map<std::string>(getContext(), [self, address, generation] (const std::string &managerKey) {
+                std::lock_guard<std::mutex> lock(self->_buildCachesLock);
+                if (generation == self->_buildCachesGeneration) {
+                    self->_managerKeyCache.put(address, managerKey);
+                }
+                return managerKey;
+            });
+        }
+
+        FuturePtr<BigInt> TezosLikeAccount::getCachedCounter(const std::shared_ptr<TezosLikeBlockchainExplorer> &explorer,
+                                                             const std::string &address) {
+            // Callers increment the counter they get, always hand them a copy
+            auto cached = _counterCache.get(address);
+            if (cached.nonEmpty()) {
+                return FuturePtr<BigInt>::successful(std::make_shared<BigInt>(cached.getValue()));
+            }
+            auto self = getSelf();
+            auto generation = getBuildCachesGeneration();
+            return explorer->getCounter(address).mapPtr<BigInt>(getContext(), [self, address, generation] (const std::shared_ptr<BigInt> &counter) {
+                std::lock_guard<std::mutex> lock(self->_buildCachesLock);
+                if (counter && generation == self->_buildCachesGeneration) {
+                    self->_counterCache.put(address, *counter);
+                }
+                return counter;
+            });
+        }
+
+        FuturePtr<TezosLikeBlockchainExplorer::Block> TezosLikeAccount::getCachedCurrentBlock(const std::shared_ptr<TezosLikeBlockchainExplorer> &explorer) {
+            // Any recent block is a valid branch for an operation, no need to invalidate it on broadcast
+            const auto& currencyName = getWallet()->getCurrency().name;
+            auto cached = _blockCache.get(currencyName);
+            if (cached.nonEmpty()) {
+                return FuturePtr<TezosLikeBlockchainExplorer::Block>::successful(std::make_shared<TezosLikeBlockchainExplorer::Block>(cached.getValue()));
+            }
+            auto self = getSelf();
+            return explorer->getCurrentBlock().mapPtr<TezosLikeBlockchainExplorer::Block>(getContext(), [self, currencyName] (const std::shared_ptr<TezosLikeBlockchainExplorer::Block> &block) {
+                self->_blockCache.put(currencyName, *block);
+                return block;
+            });
+        }
+
+        void TezosLikeAccount::invalidateBuildCaches() {
+            std::lock_guard<std::mutex> lock(_buildCachesLock);
+            _buildCachesGeneration += 1;
+            _managerKeyCache.clear();
+            _counterCache.clear();
+        }
+
+        uint64_t TezosLikeAccount::getBuildCachesGeneration() {
+            std::lock_guard<std::mutex> lock(_buildCachesLock);
+            return _buildCachesGeneration;
+        }
+
         std::string TezosLikeAccount::computeOperationUid(const std::shared_ptr<api::TezosLikeTransaction> & transaction) const {
              
             // The provided transaction has not necessarily been forged already, so we have to 
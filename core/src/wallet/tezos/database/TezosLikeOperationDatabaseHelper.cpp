@@ -254,7 +254,7 @@ namespace ledger {
                 const std::vector<Operation> &operations) {
             if (operations.empty())
                 return;
-            Benchmarker rawInsert("raw_db_insert_tezos", nullptr);
+            Benchmarker rawInsert("raw_db_insert_tezos", BENCHMARK_HISTOGRAM("raw_db_insert_tezos"), nullptr);
             rawInsert.start();
             PreparedStatement<OperationBinding> operationStmt;
             PreparedStatement<BlockBinding> blockStmt;
@@ -83,6 +83,7 @@ namespace ledger {
             // afterwards
             const bool parseNumbersAsString = true;
             return _http->GET("block/head")
+                    .cached(std::chrono::seconds(0))
                     .json(parseNumbersAsString).mapPtr<BigInt>(getContext(), [=](const HttpRequest::JsonResult &result) {
                         auto &json = *std::get<1>(result);
 
@@ -157,6 +158,7 @@ namespace ledger {
                                std::vector<uint8_t>(bodyString.begin(), bodyString.end()),
                                std::unordered_map<std::string, std::string>{{"Content-Type", "application/json"}},
                                getRPCNodeEndpoint())
+                    .prioritized()
                     .json().template map<String>(getExplorerContext(),
                                                  [](const HttpRequest::JsonResult &result) -> String {
                                                      auto &json = *std::get<1>(result);
@@ -235,6 +237,7 @@ namespace ledger {
 
         FuturePtr<Block> ExternalTezosLikeBlockchainExplorer::getCurrentBlock() const {
             return _http->GET("block/head")
+                    .cached(std::chrono::seconds(0))
                     .template json<Block, Exception>(LedgerApiParser<Block, TezosLikeBlockParser>())
                     .template mapPtr<Block>(getExplorerContext(),
                                             [](const Either<Exception, std::shared_ptr<Block>> &result) {
@@ -145,8 +145,7 @@ TezosLikeAccountSynchronizer::performSynchronization(const std::shared_ptr<Tezos
         account->getWallet()->getName(), DateUtils::toJSON(buddy->startDate));
 
     auto fullSyncBenchmarker = std::make_shared<Benchmarker>(
-        fmt::format("full_synchronization/{}", buddy->synchronizationTag),
-        buddy->logger);
+        "full_synchronization", BENCHMARK_HISTOGRAM("full_synchronization"), buddy->logger, buddy->synchronizationTag);
 
     fullSyncBenchmarker->start();
     //Check if reorganization happened
@@ -265,8 +264,7 @@ Future<Unit> TezosLikeAccountSynchronizer::synchronizeBatches(
     auto& batchState = buddy->savedState.getValue().batches[currentBatchIndex];
 
     auto benchmark = std::make_shared<Benchmarker>(
-        fmt::format("full_batch/{}", buddy->synchronizationTag),
-        buddy->logger);
+        "full_batch", BENCHMARK_HISTOGRAM("full_batch"), buddy->logger, buddy->synchronizationTag);
     benchmark->start();
     return synchronizeBatch(currentBatchIndex, buddy)
         .flatMap<Unit>(
@@ -416,8 +414,7 @@ Future<bool> TezosLikeAccountSynchronizer::synchronizeBatch(
 
 
     auto derivationBenchmark = std::make_shared<Benchmarker>(
-        fmt::format("derivations/{}", buddy->synchronizationTag),
-        buddy->logger);
+        "derivations", BENCHMARK_HISTOGRAM("derivations"), buddy->logger, buddy->synchronizationTag);
     derivationBenchmark->start();
 
     auto batch = vector::map<std::string, std::shared_ptr<TezosLikeAddress>>(
@@ -431,8 +428,7 @@ Future<bool> TezosLikeAccountSynchronizer::synchronizeBatch(
     derivationBenchmark->stop();
 
     auto benchmark = std::make_shared<Benchmarker>(
-        fmt::format("explorer_calls/{}", buddy->synchronizationTag),
-        buddy->logger);
+        "explorer_calls", BENCHMARK_HISTOGRAM("explorer_calls"), buddy->logger, buddy->synchronizationTag);
     benchmark->start();
     return _explorer->getTransactions(batch, blockHash, buddy->token)
         .flatMap<bool>(
@@ -442,8 +438,7 @@ Future<bool> TezosLikeAccountSynchronizer::synchronizeBatch(
                 benchmark->stop();
 
                 auto interpretBenchmark = std::make_shared<Benchmarker>(
-                    fmt::format("interpret_operations/{}", buddy->synchronizationTag),
-                    buddy->logger);
+                    "interpret_operations", BENCHMARK_HISTOGRAM("interpret_operations"), buddy->logger, buddy->synchronizationTag);
 
                 auto& batchState = buddy->savedState.getValue().batches[currentBatchIndex];
                 //self->transactions.insert(self->transactions.end(), bulk->transactions.begin(), bulk->transactions.end());
@@ -490,8 +485,7 @@ Future<bool> TezosLikeAccountSynchronizer::synchronizeBatch(
                 }
                 interpretBenchmark->stop();
                 auto insertionBenchmark = std::make_shared<Benchmarker>(
-                    fmt::format("insert_operations/{}", buddy->synchronizationTag),
-                    buddy->logger);
+                    "insert_operations", BENCHMARK_HISTOGRAM("insert_operations"), buddy->logger, buddy->synchronizationTag);
                 insertionBenchmark->start();
                 Try<int> tryPutTx = buddy->account->bulkInsert(operations);
                 insertionBenchmark->stop();
@@ -0,0 +1,105 @@
+/*
+ *
+ * future_allocations_test
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <src/async/Future.hpp>
+#include <src/async/Promise.hpp>
+#include <src/async/algorithm.h>
+#include <AllocationCounter.hpp>
+
+#undef foreach
+
+using namespace ledger::core;
+
+namespace {
+    const int STEPS = 1000;
+
+    template <typename Chain>
+    double allocationsPerStep(Chain chain) {
+        AllocationCounter counter;
+        chain();
+        return counter.allocations() / static_cast<double>(STEPS);
+    }
+}
+
+TEST(FutureAllocations, MapOnCompletedFuture) {
+    auto allocations = allocationsPerStep([] () {
+        auto future = Future<int>::successful(0);
+        for (auto i = 0; i < STEPS; i++) {
+            future = future.map<int>(ImmediateExecutionContext::INSTANCE, [] (const int& v) {
+                return v + 1;
+            });
+        }
+        EXPECT_EQ(future.getValue().getValue().getValue(), STEPS);
+    });
+    // One shared state and one continuation per step
+    EXPECT_LE(allocations, 2.1);
+}
+
+TEST(FutureAllocations, MapBeforeCompletion) {
+    auto allocations = allocationsPerStep([] () {
+        Promise<int> promise;
+        auto future = promise.getFuture();
+        for (auto i = 0; i < STEPS; i++) {
+            future = future.map<int>(ImmediateExecutionContext::INSTANCE, [] (const int& v) {
+                return v + 1;
+            });
+        }
+        promise.success(0);
+        EXPECT_EQ(future.getValue().getValue().getValue(), STEPS);
+    });
+    EXPECT_LE(allocations, 2.1);
+}
+
+TEST(FutureAllocations, FlatMapOnCompletedFuture) {
+    auto allocations = allocationsPerStep([] () {
+        auto future = Future<int>::successful(0);
+        for (auto i = 0; i < STEPS; i++) {
+            future = future.flatMap<int>(ImmediateExecutionContext::INSTANCE, [] (const int& v) {
+                return Future<int>::successful(v + 1);
+            });
+        }
+        EXPECT_EQ(future.getValue().getValue().getValue(), STEPS);
+    });
+    // Shared states of the resulting and the inner futures, plus the two continuations
+    EXPECT_LE(allocations, 4.1);
+}
+
+TEST(FutureAllocations, Sequence) {
+    std::vector<Future<int>> futures;
+    for (auto i = 0; i < STEPS; i++) {
+        futures.push_back(Future<int>::successful(i));
+    }
+    auto allocations = allocationsPerStep([&] () {
+        auto sequence = async::sequence(ImmediateExecutionContext::INSTANCE, futures);
+        EXPECT_EQ(sequence.getValue().getValue().getValue().size(), STEPS);
+    });
+    EXPECT_LE(allocations, 0.1);
+}
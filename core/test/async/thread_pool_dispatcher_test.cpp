@@ -0,0 +1,177 @@
+/*
+ *
+ * thread_pool_dispatcher_test
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <src/async/ThreadPoolDispatcher.hpp>
+#include <src/async/Future.hpp>
+#include <src/utils/LambdaRunnable.hpp>
+#include <atomic>
+#include <future>
+#include <vector>
+
+#undef foreach
+
+using namespace ledger::core;
+
+TEST(ThreadPoolDispatcher, SerialContextRunsTasksInOrder) {
+    ThreadPoolDispatcher dispatcher(4);
+    auto context = dispatcher.getSerialExecutionContext("serial");
+    EXPECT_EQ(context, dispatcher.getSerialExecutionContext("serial"));
+    EXPECT_NE(context, dispatcher.getSerialExecutionContext("other"));
+
+    const int count = 10000;
+    std::vector<int> order;
+    std::atomic<int> running(0);
+    std::atomic<bool> overlapped(false);
+    std::promise<void> done;
+    for (auto i = 0; i < count; i++) {
+        context->execute(make_runnable([&, i] () {
+            if (running.fetch_add(1) != 0) {
+                overlapped = true;
+            }
+            order.push_back(i);
+            running.fetch_sub(1);
+            if (i == count - 1) {
+                done.set_value();
+            }
+        }));
+    }
+    done.get_future().wait();
+    EXPECT_FALSE(overlapped);
+    ASSERT_EQ(order.size(), count);
+    for (auto i = 0; i < count; i++) {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+TEST(ThreadPoolDispatcher, BusySerialContextsInterleave) {
+    ThreadPoolDispatcher dispatcher(1);
+    auto pool = dispatcher.getThreadPoolExecutionContext("pool");
+    auto first = dispatcher.getSerialExecutionContext("first");
+    auto second = dispatcher.getSerialExecutionContext("second");
+
+    // Hold the only worker until both strands are filled
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+    pool->execute(make_runnable([opened] () {
+        opened.wait();
+    }));
+
+    const int count = 4 * 64;
+    std::vector<int> order;
+    std::promise<void> done;
+    std::atomic<int> remaining(2 * count);
+    for (auto i = 0; i < count; i++) {
+        for (auto strand : {0, 1}) {
+            (strand == 0 ? first : second)->execute(make_runnable([&, strand] () {
+                order.push_back(strand);
+                if (remaining.fetch_sub(1) == 1) {
+                    done.set_value();
+                }
+            }));
+        }
+    }
+    gate.set_value();
+    done.get_future().wait();
+
+    // A strand gives the worker back after a drain instead of running all its tasks at once
+    ASSERT_EQ(order.size(), 2 * count);
+    auto switches = 0;
+    for (size_t i = 1; i < order.size(); i++) {
+        if (order[i] != order[i - 1]) {
+            switches += 1;
+        }
+    }
+    EXPECT_GE(switches, 4);
+    EXPECT_EQ(order.front(), 0);
+    EXPECT_EQ(order[64], 1);
+}
+
+TEST(ThreadPoolDispatcher, ThreadPoolStealsWork) {
+    ThreadPoolDispatcher dispatcher(4);
+    auto pool = dispatcher.getThreadPoolExecutionContext("pool");
+    const int fanOut = 2000;
+    std::atomic<int> executed(0);
+    std::promise<void> done;
+    // Every sub task is queued on the deque of the worker running the root task, the others have to steal them
+    pool->execute(make_runnable([&] () {
+        for (auto i = 0; i < fanOut; i++) {
+            pool->execute(make_runnable([&] () {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                if (executed.fetch_add(1) == fanOut - 1) {
+                    done.set_value();
+                }
+            }));
+        }
+    }));
+    done.get_future().wait();
+    auto stats = dispatcher.getStats();
+    EXPECT_EQ(stats.workers, 4);
+    EXPECT_GE(stats.executedTasks, fanOut);
+    EXPECT_GT(stats.steals, 0);
+    EXPECT_EQ(stats.queuedTasks, 0);
+}
+
+TEST(ThreadPoolDispatcher, DelayedTasks) {
+    ThreadPoolDispatcher dispatcher(2);
+    auto context = dispatcher.getSerialExecutionContext("timers");
+    auto start = std::chrono::steady_clock::now();
+    std::promise<std::chrono::steady_clock::duration> first, second;
+    context->delay(make_runnable([&] () {
+        second.set_value(std::chrono::steady_clock::now() - start);
+    }), 120);
+    context->delay(make_runnable([&] () {
+        first.set_value(std::chrono::steady_clock::now() - start);
+    }), 30);
+    EXPECT_EQ(dispatcher.getStats().pendingTimers, 2);
+    auto firstElapsed = first.get_future().get();
+    auto secondElapsed = second.get_future().get();
+    EXPECT_GE(firstElapsed, std::chrono::milliseconds(30));
+    EXPECT_GE(secondElapsed, std::chrono::milliseconds(120));
+    EXPECT_LT(firstElapsed, secondElapsed);
+    EXPECT_EQ(dispatcher.getStats().pendingTimers, 0);
+}
+
+TEST(ThreadPoolDispatcher, FuturesAcrossContexts) {
+    ThreadPoolDispatcher dispatcher;
+    auto pool = dispatcher.getThreadPoolExecutionContext("pool");
+    auto serial = dispatcher.getSerialExecutionContext("serial");
+    std::promise<int> result;
+    Future<int>::async(pool, [] () {
+        return 20;
+    }).flatMap<int>(serial, [pool] (const int& v) {
+        return Future<int>::async(pool, [v] () {
+            return v * 2;
+        });
+    }).onComplete(dispatcher.getMainExecutionContext(), [&] (const Try<int>& r) {
+        result.set_value(r.getValue() + 2);
+    });
+    EXPECT_EQ(result.get_future().get(), 42);
+}
@@ -7,6 +7,7 @@
 #include <wallet/common/Amount.h>
 #include <wallet/bitcoin/transaction_builders/BitcoinLikeStrategyUtxoPicker.h>
 #include <spdlog/sinks/null_sink.h>
+#include <async/Promise.hpp>
 
 
 using namespace ledger::core;
@@ -186,3 +187,56 @@ TEST(OptimizeSize, ApproximationShouldTookEnough) {
     if (buddy->changeAmount.toInt64() != 0)
         EXPECT_GE(buddy->changeAmount.toInt64(), inputSizeInBytes * feesPerByte);
 }
+
+class LookupUtxoPicker : public BitcoinLikeStrategyUtxoPicker {
+public:
+    using BitcoinLikeStrategyUtxoPicker::BitcoinLikeStrategyUtxoPicker;
+
+    Future<Unit> resolve(const std::shared_ptr<Buddy>& buddy) {
+        return resolveInputTransactions(buddy);
+    }
+};
+
+TEST(UtxoPicker, ResolveInputTransactionsConcurrentlyAndOnce) {
+    const api::Currency currency = currencies::BITCOIN;
+    auto picker = std::make_shared<LookupUtxoPicker>(ImmediateExecutionContext::INSTANCE, currency, 2);
+
+    std::vector<std::pair<std::string, Promise<std::shared_ptr<BitcoinLikeBlockchainExplorerTransaction>>>> pending;
+    std::vector<std::string> lookups;
+    size_t maxPending = 0;
+    BitcoinLikeGetTxFunction getTransaction = [&] (const std::string& hash) {
+        Promise<std::shared_ptr<BitcoinLikeBlockchainExplorerTransaction>> promise;
+        pending.emplace_back(hash, promise);
+        lookups.push_back(hash);
+        maxPending = std::max(maxPending, pending.size());
+        return promise.getFuture();
+    };
+
+    BitcoinLikeTransactionBuildRequest r(std::make_shared<BigInt>(0));
+    for (auto const& hash : {"a", "b", "a", "c", "d"}) {
+        r.inputs.push_back(BitcoinLikeTransactionInputDescriptor{hash, 0, 0xFFFFFFFF});
+    }
+    auto buddy = std::make_shared<BitcoinLikeUtxoPicker::Buddy>(r, BitcoinLikeGetUtxoFunction(), getTransaction,
+            nullptr, nullptr, spdlog::null_logger_mt("lookup_null_sink"), nullptr, false);
+
+    auto resolution = picker->resolve(buddy);
+    EXPECT_EQ(pending.size(), 2);
+    while (!pending.empty()) {
+        auto next = pending.front();
+        pending.erase(pending.begin());
+        auto tx = std::make_shared<BitcoinLikeBlockchainExplorerTransaction>();
+        tx->hash = next.first;
+        tx->outputs.emplace_back();
+        next.second.success(tx);
+    }
+
+    EXPECT_TRUE(resolution.isCompleted());
+    EXPECT_EQ(lookups, std::vector<std::string>({"a", "b", "c", "d"}));
+    EXPECT_EQ(maxPending, 2);
+    EXPECT_EQ(buddy->inputTransactions.size(), 4);
+    EXPECT_EQ(buddy->inputTransactions["c"]->hash, "c");
+
+    // The second phase reuses the lookups of the first one
+    EXPECT_TRUE(picker->resolve(buddy).isCompleted());
+    EXPECT_EQ(lookups.size(), 4);
+}
@@ -204,3 +204,35 @@ TEST(BalanceHistory, CorrectBalancesPerDay2) {
         EXPECT_EQ(*balances[i], 14);
     }
 }
+
+TEST(BalanceHistory, IgnoresOperationsAfterLastPeriod) {
+    // Operations can be filtered out past the end of the period holding the end date
+    std::vector<DummyOperation> operations = {
+        DummyOperation(10, api::OperationType::RECEIVE, DateUtils::fromJSON("2019-01-01T06:00:00Z")),
+        DummyOperation(4, api::OperationType::SEND,     DateUtils::fromJSON("2019-01-02T18:00:00Z")),
+        DummyOperation(7, api::OperationType::RECEIVE,  DateUtils::fromJSON("2019-01-03T06:00:00Z"))
+    };
+
+    auto start = DateUtils::fromJSON("2019-01-01T00:00:00Z");
+    auto end =   DateUtils::fromJSON("2019-01-02T12:00:00Z");
+    auto upper = start;
+    while (upper < end) {
+        upper = DateUtils::incrementDate(upper, api::TimePeriod::DAY);
+    }
+    auto filtered = operations;
+    filtered.erase(std::remove_if(filtered.begin(), filtered.end(), [&](const DummyOperation& op) {
+        return op.date > upper;
+    }), filtered.end());
+    EXPECT_EQ(filtered.size(), 2);
+
+    auto balances = agnostic::getBalanceHistoryFor<DummyOperationStrategy, int32_t, int32_t>(
+        start, end, api::TimePeriod::DAY, operations.cbegin(), operations.cend(), 0);
+    auto filteredBalances = agnostic::getBalanceHistoryFor<DummyOperationStrategy, int32_t, int32_t>(
+        start, end, api::TimePeriod::DAY, filtered.cbegin(), filtered.cend(), 0);
+
+    ASSERT_EQ(balances.size(), filteredBalances.size());
+    for (auto i = 0; i < balances.size(); i++) {
+        EXPECT_EQ(*balances[i], *filteredBalances[i]);
+    }
+    EXPECT_EQ(*balances.back(), 6);
+}
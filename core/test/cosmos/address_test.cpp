@@ -46,6 +46,12 @@
 #include <cosmos/CosmosLikeExtendedPublicKey.hpp>
 #include <cosmos/CosmosLikeAddress.hpp>
 #include <api/CosmosCurve.hpp>
+#include <api/HttpClient.hpp>
+#include <api/HttpRequest.hpp>
+#include <net/HttpClient.hpp>
+#include <utils/ImmediateExecutionContext.hpp>
+#include <wallet/cosmos/CosmosNetworks.hpp>
+#include <proxy-http-client/FakeUrlConnection.hpp>
 
 using namespace ledger::core::api;
 using namespace ledger::core;
@@ -74,6 +80,63 @@ TEST(CosmosLikeBlockchainExplorer, FilterBuilder) {
     ASSERT_STREQ(filter.c_str(), "transfer.recipient=cosmosvalopertestaddress");
 }
 
+namespace {
+    // Keeps the requests pending until the test completes them
+    class PendingHttpClient : public api::HttpClient {
+    public:
+        void execute(const std::shared_ptr<api::HttpRequest>& request) override {
+            requests.push_back(request);
+        }
+
+        std::vector<std::shared_ptr<api::HttpRequest>> requests;
+    };
+
+    std::shared_ptr<test::FakeUrlConnection> blockResponse(uint64_t height) {
+        return test::FakeUrlConnection::fromString(fmt::format(
+            "{{\"block_meta\":{{\"block_id\":{{\"hash\":\"hash{}\"}},"
+            "\"header\":{{\"height\":\"{}\",\"time\":\"2020-01-01T00:00:00Z\"}}}}}}", height, height));
+    }
+}
+
+TEST(CosmosLikeBlockchainExplorer, CachedAndCoalescedBlocks) {
+    auto context = ImmediateExecutionContext::INSTANCE;
+    auto client = std::make_shared<PendingHttpClient>();
+    auto http = std::make_shared<ledger::core::HttpClient>("http://test.test", client, context, context);
+    auto explorer = std::make_shared<GaiaCosmosLikeBlockchainExplorer>(
+        context, http, networks::getCosmosLikeNetworkParameters("atom"), api::DynamicObject::newInstance());
+
+    uint64_t height = 42;
+    uint64_t otherHeight = 43;
+    auto first = explorer->getBlock(height);
+    auto second = explorer->getBlock(height);
+    auto other = explorer->getBlock(otherHeight);
+    // Lookups of the same height share the in flight request
+    ASSERT_EQ(client->requests.size(), 2);
+    EXPECT_FALSE(first.isCompleted());
+
+    client->requests[0]->complete(blockResponse(height), std::experimental::nullopt);
+    client->requests[1]->complete(blockResponse(otherHeight), std::experimental::nullopt);
+    ASSERT_TRUE(first.isCompleted() && second.isCompleted() && other.isCompleted());
+    EXPECT_EQ(first.getValue().getValue().getValue()->hash, "hash42");
+    EXPECT_EQ(second.getValue().getValue().getValue()->hash, "hash42");
+    EXPECT_EQ(other.getValue().getValue().getValue()->height, 43);
+
+    // Fetched blocks are served from the cache
+    auto cached = explorer->getBlock(height);
+    EXPECT_EQ(client->requests.size(), 2);
+    ASSERT_TRUE(cached.isCompleted());
+    EXPECT_EQ(cached.getValue().getValue().getValue()->hash, "hash42");
+
+    // Failures are not cached
+    uint64_t failingHeight = 44;
+    auto failing = explorer->getBlock(failingHeight);
+    client->requests[2]->complete(nullptr, api::Error(api::ErrorCode::HTTP_ERROR, "Unreachable"));
+    ASSERT_TRUE(failing.isCompleted());
+    EXPECT_TRUE(failing.getValue().getValue().isFailure());
+    explorer->getBlock(failingHeight);
+    EXPECT_EQ(client->requests.size(), 4);
+}
+
 TEST(CosmosAddress, AddressFromPubKey) {
     {
         // Results returned by device
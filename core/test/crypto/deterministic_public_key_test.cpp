@@ -37,6 +37,7 @@
 #include <ledger/core/bytes/BytesReader.h>
 #include <ledger/core/utils/hex.h>
 #include <ledger/core/collections/DynamicObject.hpp>
+#include <ledger/core/utils/Exception.hpp>
 using namespace ledger::core;
 
 static const std::string XPUB_1 = "xpub6EedcbfDs3pkzgqvoRxTW6P8NcCSaVbMQsb6xwCdEBzqZBronwY3Nte1Vjunza8f6eSMrYvbM5CMihGo6SbzpHxn4R5pvcr2ZbZ6wkDmgpy";
@@ -67,6 +68,20 @@ TEST(Derivation, DeriveChildren_1) {
     EXPECT_EQ(k.derive(5).getPublicKey(), hex::toByteArray("03e185d94291ae80671c59ac522347a500d673b1302edd0c4eb6634cc850003034"));
 }
 
+TEST(Derivation, DeriveRange) {
+    auto k = createKeyFromXpub(XPUB_1);
+    auto children = k.deriveRange(0, 5);
+    ASSERT_EQ(children.size(), 6);
+    for (uint32_t index = 0; index < children.size(); index++) {
+        auto child = k.derive(index);
+        EXPECT_EQ(children[index].getPublicKey(), child.getPublicKey());
+        EXPECT_EQ(children[index].toByteArray(), child.toByteArray());
+    }
+    EXPECT_EQ(k.deriveRange(3, 3).front().getPublicKey(), hex::toByteArray("02998d8749dd8ed56dc4a2c746865020d45fa1b2f75766a73da4cb9334adcd4cb9"));
+    EXPECT_TRUE(k.deriveRange(5, 4).empty());
+    EXPECT_THROW(k.deriveRange(0, 0x80000000), Exception);
+}
+
 static const std::string XPUB_2 = "xpub6DrvMc6me5H6sV3Wrva6thZyhxMZ7WMyB8nMWLe3T5xr79bBsDJn2zgSQiVWEbU5XfoLMEz7oZT9G49AoCcxYNrz2dVBrySzUw4k9GTNyoW";
 
 TEST(Derivation, UncompressedPublicKey) {
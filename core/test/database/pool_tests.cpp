@@ -86,6 +86,46 @@ TEST(DatabaseSessionPool, OpenAndMigrateForTheFirstTime) {
     resolver->clean();
 }
 
+TEST(DatabaseSessionPool, OpenWithWalAndReadonlyPool) {
+    auto dispatcher = std::make_shared<uv::UvThreadDispatcher>();
+    auto resolver = std::make_shared<NativePathResolver>();
+    auto backend = std::static_pointer_cast<DatabaseBackend>(
+        DatabaseBackend::getSqlite3BackendWithOptions(4, true, "normal", -8000, 0)
+    );
+    EXPECT_EQ(backend->getConnectionPoolSize(), 1);
+    EXPECT_EQ(backend->getReadonlyConnectionPoolSize(), 4);
+    DatabaseSessionPool::getSessionPool(dispatcher->getSerialExecutionContext("worker"), backend, resolver, nullptr, "test_wal")
+    .onComplete(dispatcher->getMainExecutionContext(), [&] (const TryPtr<DatabaseSessionPool>& result) {
+        EXPECT_TRUE(result.isSuccess());
+        if (result.isFailure()) {
+            std::cerr << result.getFailure().getMessage() << std::endl;
+        } else {
+            soci::session writer(result.getValue()->getPool());
+            for (size_t i = 0; i < 4; i++) {
+                auto& reader = result.getValue()->getReadonlyPool().at(i);
+                std::string journalMode;
+                int synchronous;
+                int32_t poolCount;
+                reader << "PRAGMA journal_mode", soci::into(journalMode);
+                reader << "PRAGMA synchronous", soci::into(synchronous);
+                reader << "SELECT COUNT(*) FROM pools", soci::into(poolCount);
+                EXPECT_EQ(journalMode, "wal");
+                EXPECT_EQ(synchronous, 1);
+                EXPECT_EQ(poolCount, 0);
+            }
+        }
+        dispatcher->stop();
+    });
+    dispatcher->waitUntilStopped();
+    resolver->clean();
+}
+
+TEST(DatabaseSessionPool, RejectInvalidSqlite3Options) {
+    EXPECT_THROW(DatabaseBackend::getSqlite3BackendWithOptions(0, false, "", 0, 0), Exception);
+    EXPECT_THROW(DatabaseBackend::getSqlite3BackendWithOptions(2, false, "FULL; DROP TABLE pools", 0, 0), Exception);
+    EXPECT_THROW(DatabaseBackend::getSqlite3BackendWithOptions(2, false, "", 0, -1), Exception);
+}
+
 TEST(DatabaseSessionPool, InitializeCurrencies) {
     auto dispatcher = std::make_shared<uv::UvThreadDispatcher>();
     auto resolver = std::make_shared<NativePathResolver>();
@@ -0,0 +1,111 @@
+/*
+ *
+ * durations_map_test
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <ledger/core/metrics/DurationsMap.hpp>
+#include <ledger/core/api/DurationMetrics.hpp>
+#include <ledger/core/debug/Benchmarker.h>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace ledger::core;
+
+TEST(DurationsMapTest, BucketBounds) {
+    for (uint64_t value : {0ULL, 1ULL, 7ULL, 8ULL, 15ULL, 16ULL, 17ULL, 1000ULL, 123456789ULL}) {
+        auto bucket = DurationHistogram::bucketOf(value);
+        EXPECT_GE(DurationHistogram::upperBoundOf(bucket), value);
+        if (bucket > 0) {
+            EXPECT_LT(DurationHistogram::upperBoundOf(bucket - 1), value);
+        }
+    }
+    EXPECT_EQ(DurationHistogram::bucketOf(UINT64_MAX), DurationHistogram::BUCKETS - 1);
+}
+
+TEST(DurationsMapTest, Percentiles) {
+    DurationHistogram histogram;
+    for (auto i = 1; i <= 1000; i++) {
+        histogram.record(std::chrono::microseconds(i));
+    }
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 1000);
+    EXPECT_EQ(snapshot.total_us, 500500);
+    EXPECT_EQ(snapshot.max_us, 1000);
+    // Percentiles are reported as bucket upper bounds, at most 12.5% above the exact value
+    EXPECT_GE(snapshot.p50_us, 500);
+    EXPECT_LE(snapshot.p50_us, 500 * 1.125);
+    EXPECT_GE(snapshot.p95_us, 950);
+    EXPECT_LE(snapshot.p95_us, 1000);
+    EXPECT_GE(snapshot.p99_us, 990);
+    EXPECT_LE(snapshot.p99_us, 1000);
+
+    histogram.reset();
+    snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 0);
+    EXPECT_EQ(snapshot.p99_us, 0);
+}
+
+TEST(DurationsMapTest, ConcurrentRecords) {
+    DurationHistogram histogram;
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 16; t++) {
+        threads.emplace_back([&histogram] () {
+            for (auto i = 0; i < 1000; i++) {
+                histogram.record(std::chrono::milliseconds(2));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 16000);
+    EXPECT_EQ(snapshot.total_us, 16000 * 2000);
+    EXPECT_EQ(snapshot.p50_us, 2000);
+}
+
+TEST(DurationsMapTest, TagsAreNotPartOfMetricNames) {
+    api::DurationMetrics::resetDurationMetrics();
+    Benchmarker("durations_map_test", nullptr, "account_1").start().stop();
+    Benchmarker("durations_map_test", nullptr, "account_2").start().stop();
+    auto histograms = api::DurationMetrics::getHistogramMetrics();
+    ASSERT_NE(histograms.find("durations_map_test"), histograms.end());
+    EXPECT_EQ(histograms["durations_map_test"].count, 2);
+    EXPECT_EQ(histograms.find("durations_map_test/account_1"), histograms.end());
+    EXPECT_EQ(api::DurationMetrics::getAllDurationMetrics()["durations_map_test"].count, 2);
+}
+
+TEST(DurationsMapTest, CallSiteHistogram) {
+    api::DurationMetrics::resetDurationMetrics();
+    for (auto i = 0; i < 3; i++) {
+        auto& histogram = BENCHMARK_HISTOGRAM("durations_map_test_call_site");
+        EXPECT_EQ(histogram, DurationsMap::getInstance().getHistogram("durations_map_test_call_site"));
+        Benchmarker("durations_map_test_call_site", histogram, nullptr, "account_1").start().stop();
+    }
+    EXPECT_EQ(api::DurationMetrics::getHistogramMetrics()["durations_map_test_call_site"].count, 3);
+}
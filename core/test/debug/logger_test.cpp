@@ -35,6 +35,7 @@
 #include <NativePathResolver.hpp>
 #include <CoutLogPrinter.hpp>
 #include <ledger/core/debug/logger.hpp>
+#include <ledger/core/debug/RotatingEncryptableSink.hpp>
 #include <ledger/core/utils/optional.hpp>
 #include <spdlog/details/os.h>
 #include <gtest/gtest.h>
@@ -58,6 +59,7 @@ TEST(LoggerTest, LogAndOverflow) {
         for (auto i = 0; i < 200; i++) {
             logger->debug("This is a log {0:03d}", i);
         }
+        logger->flush();
 
         dispatcher->getSerialExecutionContext("logger")->delay(make_runnable([=] () {
             dispatcher->stop();
@@ -89,6 +91,7 @@ TEST(LoggerTest, LogNoOverflow) {
         for (auto i = 0; i < 200; i++) {
             logger->debug("This is a log {0:03d}", i);
         }
+        logger->flush();
 
         dispatcher->getSerialExecutionContext("logger")->delay(make_runnable([=] () {
             dispatcher->stop();
@@ -104,3 +107,39 @@ TEST(LoggerTest, LogNoOverflow) {
     EXPECT_TRUE(str.find("This is a log 0") != std::string::npos);
     resolver->clean();
 }
+
+TEST(LoggerTest, DropLinesWhenBufferIsFull) {
+    auto dispatcher = std::make_shared<NativeThreadDispatcher>();
+    auto resolver = std::make_shared<NativePathResolver>();
+    auto context = dispatcher->getSerialExecutionContext("logger");
+    auto logLineExample = std::string("2017-03-02T10:07:06Z+01:00 D: This is a log XXX") + spdlog::details::os::default_eol;
+    // Nothing is drained before the explicit flush: the batch size is never reached and the timer is far away
+    auto sink = std::make_shared<ledger::core::RotatingEncryptableSink>(
+            context, resolver, "test_logs_2", 1024 * 1024, 3,
+            logLineExample.size() * 100, logLineExample.size() * 100, 60 * 60 * 1000
+    );
+    auto logger = std::make_shared<spdlog::logger>("test_logs_2", sink);
+    logger->set_level(spdlog::level::trace);
+    logger->set_pattern("%Y-%m-%dT%XZ%z %L: %v");
+
+    for (auto i = 0; i < 150; i++) {
+        logger->debug("This is a log {0:03d}", i);
+    }
+    EXPECT_EQ(sink->getQueuedBytes(), logLineExample.size() * 100);
+    EXPECT_EQ(sink->getDroppedLines(), 50);
+    EXPECT_EQ(sink->getDroppedBytes(), logLineExample.size() * 50);
+
+    logger->flush();
+    context->delay(make_runnable([=] () {
+        dispatcher->stop();
+    }), 0);
+    dispatcher->waitUntilStopped();
+    EXPECT_EQ(sink->getQueuedBytes(), 0);
+    std::ifstream t(resolver->resolveLogFilePath("test_logs_2.log"));
+    std::string str((std::istreambuf_iterator<char>(t)),
+                    std::istreambuf_iterator<char>());
+    EXPECT_TRUE(str.find("This is a log 099") != std::string::npos);
+    EXPECT_FALSE(str.find("This is a log 100") != std::string::npos);
+    EXPECT_TRUE(str.find("50 log lines dropped by the sink") != std::string::npos);
+    resolver->clean();
+}
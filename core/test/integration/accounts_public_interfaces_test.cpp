@@ -33,9 +33,11 @@
 #include "../fixtures/medium_xpub_fixtures.h"
 #include "../fixtures/testnet_xpub_fixtures.h"
 #include <wallet/common/OperationQuery.h>
+#include <wallet/common/OperationCursor.h>
 #include <api/KeychainEngines.hpp>
 #include <utils/DateUtils.hpp>
 #include <iostream>
+#include <unordered_set>
 using namespace std;
 class AccountsPublicInterfaceTest : public BaseFixture {
 public:
@@ -94,6 +96,40 @@ TEST_F(AccountsPublicInterfaceTest, GetBalanceHistoryOnAccountWithSomeTxs) {
     EXPECT_EQ(balanceHistory[balanceHistory.size() - 1]->toLong(), balance->toLong());
 }
 
+TEST_F(AccountsPublicInterfaceTest, GetBalanceHistoryFromCheckpoints) {
+    auto account = ledger::testing::medium_xpub::inflate(pool, wallet);
+    auto fromDate = "2017-12-01T00:00:00Z";
+    auto toDate = "2018-03-01T00:00:00Z";
+    auto history = uv::wait(account->getBalanceHistory(fromDate, toDate, api::TimePeriod::DAY));
+
+    const auto uid = account->getAccountUid();
+    int count = 0;
+    {
+        soci::session sql(pool->getDatabaseSessionPool()->getPool());
+        sql << "SELECT COUNT(*) FROM balance_checkpoints WHERE account_uid = :uid", soci::use(uid), soci::into(count);
+        EXPECT_GT(count, 0);
+        // Replaying every operations must give the same history
+        sql << "DELETE FROM balance_checkpoints";
+    }
+    auto replayed = uv::wait(account->getBalanceHistory(fromDate, toDate, api::TimePeriod::DAY));
+    ASSERT_EQ(history.size(), replayed.size());
+    for (auto i = 0; i < history.size(); i++) {
+        EXPECT_EQ(history[i]->toLong(), replayed[i]->toLong());
+    }
+
+    // Inserting operations rebuilds the checkpoints and erasing some of them invalidates the following days
+    account->bulkInsert({});
+    std::string date = "2018-01-01T00:00:00Z";
+    {
+        soci::session sql(pool->getDatabaseSessionPool()->getPool());
+        sql << "SELECT COUNT(*) FROM balance_checkpoints WHERE account_uid = :uid", soci::use(uid), soci::into(count);
+        EXPECT_GT(count, 0);
+        sql << "DELETE FROM operations WHERE account_uid = :uid AND date >= :date", soci::use(uid), soci::use(date);
+        sql << "SELECT COUNT(*) FROM balance_checkpoints WHERE account_uid = :uid AND day >= '2018-01-01'", soci::use(uid), soci::into(count);
+        EXPECT_EQ(count, 0);
+    }
+}
+
 TEST_F(AccountsPublicInterfaceTest, QueryOperations) {
     auto account = ledger::testing::medium_xpub::inflate(pool, wallet);
     auto query = std::dynamic_pointer_cast<ledger::core::OperationQuery>(account->queryOperations()->limit(100)->partial());
@@ -101,6 +137,50 @@ TEST_F(AccountsPublicInterfaceTest, QueryOperations) {
     EXPECT_EQ(operations.size(), 100);
 }
 
+TEST_F(AccountsPublicInterfaceTest, QueryOperationsWithCursor) {
+    auto account = ledger::testing::medium_xpub::inflate(pool, wallet);
+    auto all = uv::wait(std::dynamic_pointer_cast<ledger::core::OperationQuery>(account->queryOperations()->partial())->execute());
+
+    auto query = std::dynamic_pointer_cast<ledger::core::OperationQuery>(account->queryOperations()->complete());
+    auto cursor = query->cursor(7);
+    std::vector<std::shared_ptr<api::Operation>> streamed;
+    std::vector<std::shared_ptr<api::Operation>> secondChunk;
+    Option<OperationKey> firstChunkKey;
+    while (cursor->hasNext()) {
+        auto chunk = uv::wait(cursor->next());
+        EXPECT_LE(chunk.size(), 7);
+        if (firstChunkKey.isEmpty()) {
+            firstChunkKey = cursor->getLastKey();
+        } else if (secondChunk.empty()) {
+            secondChunk = chunk;
+        }
+        streamed.insert(streamed.end(), chunk.begin(), chunk.end());
+    }
+    ASSERT_EQ(streamed.size(), all.size());
+
+    std::unordered_set<std::string> uids;
+    for (auto i = 0; i < streamed.size(); i++) {
+        uids.insert(streamed[i]->getUid());
+        if (i > 0) {
+            EXPECT_LE(streamed[i - 1]->getDate(), streamed[i]->getDate());
+        }
+        // Complete operations are inflated with their transactions
+        auto tx = streamed[i]->asBitcoinLikeOperation()->getTransaction();
+        EXPECT_FALSE(tx->getHash().empty());
+        EXPECT_FALSE(tx->getOutputs().empty());
+    }
+    EXPECT_EQ(uids.size(), all.size());
+
+    // A new cursor resumes where the first chunk ended
+    ASSERT_TRUE(firstChunkKey.nonEmpty());
+    auto resumed = query->cursor(7)->startAfter(firstChunkKey.getValue().date, firstChunkKey.getValue().uid);
+    auto chunk = uv::wait(resumed->next());
+    ASSERT_EQ(chunk.size(), secondChunk.size());
+    for (auto i = 0; i < chunk.size(); i++) {
+        EXPECT_EQ(chunk[i]->getUid(), secondChunk[i]->getUid());
+    }
+}
+
 TEST_F(AccountsPublicInterfaceTest, QueryOperationsOnEmptyAccount) {
     auto account = createBitcoinLikeAccount(wallet, 0, P2PKH_MEDIUM_XPUB_INFO);
     auto query = std::dynamic_pointer_cast<ledger::core::OperationQuery>(account->queryOperations()->limit(100)->partial());
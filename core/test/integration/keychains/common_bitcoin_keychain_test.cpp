@@ -152,3 +152,30 @@ TEST_F(CommonBitcoinKeychains, CorrectStateUsedAtMarkPathAsUsed) {
     });
 }
 
+
+TEST_F(CommonBitcoinKeychains, AddressIndexLoadedFromPreferences) {
+
+    testKeychain(BTC_TESTNET_DATA, [] (ConcreteCommonBitcoinLikeKeychains& keychain) {
+
+        auto addresses = keychain.getAllObservableAddresses(0, 10);
+        EXPECT_FALSE(keychain.contains("2MvuUMAG1NFQmmM69Writ6zTsYCnQHFG9BF"));
+
+        // A keychain sharing the same preferences rebuilds its index from the derivation cache
+        ConcreteCommonBitcoinLikeKeychains reloaded(
+            keychain.getConfiguration(),
+            keychain.getCurrency(),
+            keychain.getAccountIndex(),
+            keychain.getExtendedPublicKey(),
+            keychain.getPreferences()
+        );
+        for (auto& address : addresses) {
+            EXPECT_TRUE(keychain.contains(address->toString()));
+            EXPECT_TRUE(reloaded.contains(address->toString()));
+            EXPECT_EQ(keychain.getAddressDerivationPath(address->toString()).getValue(),
+                      reloaded.getAddressDerivationPath(address->toString()).getValue());
+            EXPECT_EQ(keychain.getAddressPurpose(address->toString()).getValue(),
+                      reloaded.getAddressPurpose(address->toString()).getValue());
+        }
+        EXPECT_FALSE(reloaded.contains("2MvuUMAG1NFQmmM69Writ6zTsYCnQHFG9BF"));
+    });
+}
@@ -719,3 +719,31 @@ TEST_F(BitcoinLikeWalletSynchronization, SynchronizeWithMultiThreading) {
         auto b = synchronize();
     }
 }
+
+TEST_F(BitcoinLikeWalletSynchronization, SynchronizeWithParallelBatches) {
+    const auto walletName = randomWalletName();
+    auto pool = newDefaultPool();
+    {
+        auto configuration = DynamicObject::newInstance();
+        configuration->putInt(api::Configuration::SYNCHRONIZATION_MAX_PARALLEL_BATCHES, 4);
+        auto wallet = uv::wait(pool->createWallet(walletName, "bitcoin", configuration));
+        auto account = createBitcoinLikeAccount(wallet, 0, P2PKH_MEDIUM_XPUB_INFO);
+        auto synchronize = [account, this]() {
+            auto bus = account->synchronize();
+            auto receiver = make_receiver([=](const std::shared_ptr<api::Event>& event) {
+                fmt::print("Received event {}\n", api::to_string(event->getCode()));
+                if (event->getCode() == api::EventCode::SYNCHRONIZATION_STARTED)
+                    return;
+                EXPECT_NE(event->getCode(), api::EventCode::SYNCHRONIZATION_FAILED);
+                dispatcher->stop();
+            });
+
+            bus->subscribe(getTestExecutionContext(), receiver);
+            dispatcher->waitUntilStopped();
+            EXPECT_EQ(uv::wait(account->getBalance())->toString(), "166505122");
+        };
+        // The second synchronization resumes from the saved state written by parallel batches
+        synchronize();
+        synchronize();
+    }
+}
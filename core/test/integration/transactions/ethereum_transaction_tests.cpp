@@ -36,10 +36,93 @@
 #include <utils/DateUtils.hpp>
 #include <wallet/ethereum/database/EthereumLikeAccountDatabaseHelper.h>
 #include <wallet/ethereum/api_impl/EthereumLikeTransactionApi.h>
+#include <wallet/ethereum/synchronizers/EthereumLikeAccountSynchronizer.h>
+#include <wallet/ethereum/ERC20/ERC20LikeAccount.h>
+#include <wallet/common/BalanceHistory.hpp>
+#include <wallet/common/database/AccountDatabaseHelper.h>
 #include <wallet/currencies.hpp>
+#include <events/ProgressNotifier.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
 #include <iostream>
 using namespace std;
 
+// Explorer answering the ERC20 balance requests, counting them. The batched requests stay
+// pending until answerBalances is called.
+class CountingEthereumExplorer : public EthereumLikeBlockchainExplorer {
+public:
+    CountingEthereumExplorer() : EthereumLikeBlockchainExplorer(api::DynamicObject::newInstance(), {}),
+                                 balancesCalls(0), balanceCalls(0) {}
+
+    Future<std::vector<BigInt>> getERC20Balances(const std::string &address,
+                                                 const std::vector<std::string> &erc20Addresses) override {
+        balancesCalls += 1;
+        requestedContracts = erc20Addresses;
+        balancesRequests.push_back(std::make_pair(erc20Addresses, Promise<std::vector<BigInt>>()));
+        return balancesRequests.back().second.getFuture();
+    }
+    Future<std::shared_ptr<BigInt>> getERC20Balance(const std::string &address,
+                                                    const std::string &erc20Address) override {
+        balanceCalls += 1;
+        return Future<std::shared_ptr<BigInt>>::successful(std::make_shared<BigInt>(balances.at(erc20Address)));
+    }
+    Future<String> pushTransaction(const std::vector<uint8_t> &transaction, const std::string &correlationId) override {
+        return Future<String>::successful(String("71df2bc7d800a05a97b742aa5313e5040003ba3ddb84546ceb2a026e5a97fca5"));
+    }
+
+    // Answers the given getERC20Balances request (the last one by default), in the order of its contracts
+    void answerBalances(int request = -1) {
+        auto &pending = balancesRequests.at(request < 0 ? balancesRequests.size() - 1 : request);
+        std::vector<BigInt> result;
+        for (const auto &contract : pending.first) {
+            result.push_back(balances.at(contract));
+        }
+        pending.second.success(result);
+    }
+
+    Future<void *> startSession() override { return fail<void *>(); }
+    Future<Unit> killSession(void *session) override { return fail<Unit>(); }
+    FuturePtr<TransactionsBulk> getTransactions(const std::vector<std::string> &addresses,
+                                                Option<std::string> fromBlockHash,
+                                                Option<void *> session) override { return fail<std::shared_ptr<TransactionsBulk>>(); }
+    FuturePtr<Block> getCurrentBlock() const override { return fail<std::shared_ptr<Block>>(); }
+    Future<Bytes> getRawTransaction(const String &transactionHash) override { return fail<Bytes>(); }
+    FuturePtr<Transaction> getTransactionByHash(const String &transactionHash) const override { return fail<std::shared_ptr<Transaction>>(); }
+    Future<int64_t> getTimestamp() const override { return fail<int64_t>(); }
+    Future<std::shared_ptr<BigInt>> getNonce(const std::string &address) override { return fail<std::shared_ptr<BigInt>>(); }
+    Future<std::shared_ptr<BigInt>> getBalance(const std::vector<EthereumLikeKeychain::Address> &addresses) override { return fail<std::shared_ptr<BigInt>>(); }
+    Future<std::shared_ptr<BigInt>> getGasPrice() override { return fail<std::shared_ptr<BigInt>>(); }
+    Future<std::shared_ptr<BigInt>> getEstimatedGasLimit(const std::string &address) override { return fail<std::shared_ptr<BigInt>>(); }
+    Future<std::shared_ptr<BigInt>> getDryRunGasLimit(const std::string &address,
+                                                      const api::EthereumGasLimitRequest &request) override { return fail<std::shared_ptr<BigInt>>(); }
+
+    std::map<std::string, BigInt> balances;
+    std::vector<std::string> requestedContracts;
+    std::atomic<int> balancesCalls;
+    std::atomic<int> balanceCalls;
+
+private:
+    template <typename T>
+    static Future<T> fail() {
+        return Future<T>::failure(make_exception(api::ErrorCode::IMPLEMENTATION_IS_MISSING, "Not used by the tests"));
+    }
+
+    std::vector<std::pair<std::vector<std::string>, Promise<std::vector<BigInt>>>> balancesRequests;
+};
+
+// Synchronizer reporting a successful synchronization right away
+class ImmediateEthereumSynchronizer : public EthereumLikeAccountSynchronizer {
+public:
+    void reset(const std::shared_ptr<EthereumLikeAccount> &account, const std::chrono::system_clock::time_point &toDate) override {}
+    std::shared_ptr<ProgressNotifier<BlockchainExplorerAccountSynchronizationResult>> synchronize(const std::shared_ptr<EthereumLikeAccount> &account) override {
+        auto notifier = std::make_shared<ProgressNotifier<BlockchainExplorerAccountSynchronizationResult>>();
+        notifier->success(BlockchainExplorerAccountSynchronizationResult());
+        return notifier;
+    }
+    bool isSynchronizing() const override { return false; }
+};
+
 struct EthereumMakeTransaction : public EthereumMakeBaseTransaction {
     void SetUpConfig() override {
         auto configuration = DynamicObject::newInstance();
@@ -153,3 +236,186 @@ TEST_F(EthereumMakeTransaction, ParseSignedRawERC20TransactionAndBuildETHBlockch
     EXPECT_EQ(ethLikeBCTx.erc20Transactions[0].contractAddress, contractAddress);
     EXPECT_EQ(ethLikeBCTx.erc20Transactions[0].type, api::OperationType::SEND);
 }
+
+TEST_F(EthereumMakeTransaction, CachesERC20Balances) {
+    auto explorer = std::make_shared<CountingEthereumExplorer>();
+    auto synchronizer = std::make_shared<ImmediateEthereumSynchronizer>();
+    auto cachedAccount = std::make_shared<EthereumLikeAccount>(wallet, account->getIndex(), explorer, synchronizer, account->getKeychain());
+    const std::string usdt = "0xdAC17F958D2ee523a2206206994597C13D831ec7";
+    const std::string dai = "0x6B175474E89094C44Da98b954EedeAC495271d0F";
+    const std::string other = "0xDFb287530FD4c1e59456DE82a84e4aae7C250Ec1";
+    explorer->balances.emplace(usdt, BigInt(1000));
+    explorer->balances.emplace(dai, BigInt(2000));
+    explorer->balances.emplace(other, BigInt(3000));
+    {
+        soci::session sql(pool->getDatabaseSessionPool()->getPool());
+        std::vector<ERC20LikeAccountDatabaseEntry> entries;
+        for (const auto &contract : {usdt, dai}) {
+            ERC20LikeAccountDatabaseEntry entry;
+            entry.contractAddress = contract;
+            entry.uid = AccountDatabaseHelper::createERC20AccountUid(cachedAccount->getAccountUid(), contract);
+            entries.push_back(entry);
+        }
+        cachedAccount->addERC20Accounts(sql, entries);
+    }
+    EXPECT_EQ(cachedAccount->getERC20Accounts().size(), 2);
+
+    // Sub accounts asking together share one request, each gets the balance of its contract
+    auto usdtBalance = cachedAccount->getERC20Balance(usdt);
+    auto daiBalance = cachedAccount->getERC20Balance(dai);
+    EXPECT_EQ(explorer->balancesCalls, 1);
+    EXPECT_EQ(explorer->requestedContracts.size(), 2);
+    explorer->answerBalances();
+    EXPECT_EQ(uv::wait(usdtBalance)->toString(10), "1000");
+    EXPECT_EQ(uv::wait(daiBalance)->toString(10), "2000");
+
+    // The answer is cached, tokens without a sub account are asked one by one
+    EXPECT_EQ(uv::wait(cachedAccount->getERC20Balance(dai))->toString(10), "2000");
+    EXPECT_EQ(uv::wait(cachedAccount->getERC20Balance(other))->toString(10), "3000");
+    EXPECT_EQ(explorer->balancesCalls, 1);
+    EXPECT_EQ(explorer->balanceCalls, 1);
+
+    // A synchronization may have moved tokens, the next lookup fetches the balances again
+    explorer->balances[usdt] = BigInt(1500);
+    cachedAccount->synchronize()->subscribe(dispatcher->getMainExecutionContext(), make_receiver([=] (const std::shared_ptr<api::Event> &event) {
+        if (event->getCode() == api::EventCode::SYNCHRONIZATION_STARTED)
+            return;
+        EXPECT_EQ(event->getCode(), api::EventCode::SYNCHRONIZATION_SUCCEED);
+        dispatcher->stop();
+    }));
+    dispatcher->waitUntilStopped();
+    auto syncedBalance = cachedAccount->getERC20Balance(usdt);
+    EXPECT_EQ(explorer->balancesCalls, 2);
+    explorer->answerBalances();
+    EXPECT_EQ(uv::wait(syncedBalance)->toString(10), "1500");
+    EXPECT_EQ(uv::wait(cachedAccount->getERC20Balance(dai))->toString(10), "2000");
+    EXPECT_EQ(explorer->balancesCalls, 2);
+
+    // So may a broadcast
+    explorer->balances[dai] = BigInt(500);
+    auto rawTx = "f8678183843b9aca0083030d4094ac6603e97e774cd34603293b69bbbb1980aceeaa8201008029a0c4cbbdbdecb855505cd344dd1b800e1cce731ebc0f9a1559f0bc9da5ab20daa6a01adbe3788efac90885117f23bd8cfaa859e4f1afbd1416087b4172aca3a0423f";
+    auto callback = std::make_shared<PromiseStringCallback>();
+    cachedAccount->broadcastRawTransaction(hex::toByteArray(rawTx), callback);
+    uv::wait(callback->promise.getFuture());
+    auto broadcastBalance = cachedAccount->getERC20Balance(dai);
+    EXPECT_EQ(explorer->balancesCalls, 3);
+    explorer->answerBalances();
+    EXPECT_EQ(uv::wait(broadcastBalance)->toString(10), "500");
+
+    // A request in flight during a broadcast is neither shared with later callers nor cached
+    callback = std::make_shared<PromiseStringCallback>();
+    cachedAccount->broadcastRawTransaction(hex::toByteArray(rawTx), callback);
+    uv::wait(callback->promise.getFuture());
+    auto staleBalance = cachedAccount->getERC20Balance(usdt);
+    callback = std::make_shared<PromiseStringCallback>();
+    cachedAccount->broadcastRawTransaction(hex::toByteArray(rawTx), callback);
+    uv::wait(callback->promise.getFuture());
+    auto freshBalance = cachedAccount->getERC20Balance(usdt);
+    EXPECT_EQ(explorer->balancesCalls, 5);
+    explorer->balances[usdt] = BigInt(2500);
+    explorer->answerBalances(4);
+    EXPECT_EQ(uv::wait(freshBalance)->toString(10), "2500");
+    explorer->balances[usdt] = BigInt(1500);
+    explorer->answerBalances(3);
+    EXPECT_EQ(uv::wait(staleBalance)->toString(10), "1500");
+    EXPECT_EQ(uv::wait(cachedAccount->getERC20Balance(usdt))->toString(10), "2500");
+    EXPECT_EQ(explorer->balancesCalls, 5);
+}
+
+// ERC20 balance history as computed before it was read from a date ordered query: every
+// operation loaded in full then sorted in memory
+static std::vector<std::shared_ptr<api::BigInt>> getFullLoadBalanceHistory(const std::shared_ptr<ERC20LikeAccount> &erc20Account,
+                                                                           const std::chrono::system_clock::time_point &startDate,
+                                                                           const std::chrono::system_clock::time_point &endDate,
+                                                                           api::TimePeriod precision) {
+    auto operations = erc20Account->getOperations();
+    std::sort(operations.begin(), operations.end(), [] (const std::shared_ptr<api::ERC20LikeOperation> &a,
+                                                        const std::shared_ptr<api::ERC20LikeOperation> &b) {
+        return a->getTime() < b->getTime();
+    });
+
+    struct OperationStrategy {
+        static inline std::chrono::system_clock::time_point date(std::shared_ptr<api::ERC20LikeOperation> &op) {
+            return op->getTime();
+        }
+
+        static inline std::shared_ptr<api::BigInt> value_constructor(const BigInt &v) {
+            return std::make_shared<api::BigIntImpl>(v);
+        }
+
+        static inline void update_balance(std::shared_ptr<api::ERC20LikeOperation> &op, BigInt &sum) {
+            auto value = BigInt(op->getValue()->toString(10));
+            switch (op->getOperationType()) {
+                case api::OperationType::RECEIVE:
+                    sum = sum + value;
+                    break;
+                case api::OperationType::SEND:
+                    sum = sum - value;
+                    break;
+                default:
+                    break;
+            }
+        }
+    };
+
+    return agnostic::getBalanceHistoryFor<OperationStrategy, BigInt, api::BigInt>(
+            startDate, endDate, precision, operations.cbegin(), operations.cend(), BigInt());
+}
+
+TEST_F(EthereumMakeTransaction, ERC20BalanceHistoryMatchesFullLoad) {
+    struct Transfer {
+        std::string date;
+        api::OperationType type;
+        int value;
+    };
+    const std::vector<Transfer> transfers = {
+            {"2018-01-10T08:00:00Z", api::OperationType::RECEIVE, 1000},
+            {"2018-02-15T12:30:00Z", api::OperationType::SEND, 300},
+            // Exactly on the end of the last period of a monthly history ending in February
+            {"2018-03-01T00:00:00Z", api::OperationType::RECEIVE, 50},
+            {"2018-03-20T18:00:00Z", api::OperationType::RECEIVE, 7},
+            {"2018-06-05T10:00:00Z", api::OperationType::SEND, 20}
+    };
+    auto accountAddress = account->getKeychain()->getAddress()->toString();
+    auto peerAddress = "0x456b8e57f5e096b9fff45bdbd58b8ce90d830ff9";
+    auto contractAddress = "0xDFb287530FD4c1e59456DE82a84e4aae7C250Ec1";
+    std::vector<Operation> operations;
+    auto nonce = 0;
+    for (const auto &transfer : transfers) {
+        auto tx = *JSONUtils::parse<EthereumLikeTransactionParser>(ledger::testing::eth_xpub::TX_1);
+        tx.hash = fmt::format("0x{:064x}", ++nonce);
+        tx.receivedAt = DateUtils::fromJSON(transfer.date);
+        ERC20Transaction erc20Tx;
+        erc20Tx.from = transfer.type == api::OperationType::SEND ? accountAddress : peerAddress;
+        erc20Tx.to = transfer.type == api::OperationType::SEND ? peerAddress : accountAddress;
+        erc20Tx.contractAddress = contractAddress;
+        erc20Tx.value = BigInt(transfer.value);
+        tx.erc20Transactions.push_back(erc20Tx);
+        account->interpretTransaction(tx, operations);
+    }
+    account->bulkInsert(operations);
+
+    auto erc20Accounts = account->getERC20Accounts();
+    ASSERT_EQ(erc20Accounts.size(), 1);
+    auto erc20Account = std::dynamic_pointer_cast<ERC20LikeAccount>(erc20Accounts[0]);
+    ASSERT_EQ(erc20Account->getOperations().size(), transfers.size());
+
+    auto startDate = DateUtils::fromJSON("2018-01-01T00:00:00Z");
+    for (auto precision : {api::TimePeriod::DAY, api::TimePeriod::WEEK, api::TimePeriod::MONTH}) {
+        for (auto end : {"2018-02-20T00:00:00Z", "2018-03-01T00:00:00Z", "2018-04-01T00:00:00Z", "2018-12-31T00:00:00Z"}) {
+            auto endDate = DateUtils::fromJSON(end);
+            auto history = erc20Account->getBalanceHistoryFor(startDate, endDate, precision);
+            auto expected = getFullLoadBalanceHistory(erc20Account, startDate, endDate, precision);
+            ASSERT_EQ(history.size(), expected.size()) << api::to_string(precision) << " until " << end;
+            for (std::size_t i = 0; i < history.size(); i++) {
+                EXPECT_EQ(history[i]->toString(10), expected[i]->toString(10)) << api::to_string(precision) << " until " << end << " at " << i;
+            }
+        }
+    }
+
+    // The period ending in March holds the operation on its upper bound
+    auto monthly = erc20Account->getBalanceHistoryFor(startDate, DateUtils::fromJSON("2018-02-20T00:00:00Z"), api::TimePeriod::MONTH);
+    ASSERT_EQ(monthly.size(), 2);
+    EXPECT_EQ(monthly[0]->toString(10), "1000");
+    EXPECT_EQ(monthly[1]->toString(10), "750");
+}
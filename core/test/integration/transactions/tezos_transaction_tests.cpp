@@ -41,9 +41,77 @@
 #include <wallet/tezos/database/TezosLikeAccountDatabaseHelper.h>
 #include <wallet/tezos/api_impl/TezosLikeTransactionApi.h>
 #include <wallet/currencies.hpp>
+#include <atomic>
 #include <iostream>
 using namespace std;
 
+// Explorer answering the requests a transaction build needs, counting them
+class CountingTezosExplorer : public TezosLikeBlockchainExplorer {
+public:
+    CountingTezosExplorer() : TezosLikeBlockchainExplorer(api::DynamicObject::newInstance(), {}),
+                              managerKeyCalls(0), counterCalls(0), blockCalls(0), pushCalls(0) {}
+
+    FuturePtr<BigInt> getBalance(const std::vector<TezosLikeKeychain::Address> &addresses) override {
+        return FuturePtr<BigInt>::successful(std::make_shared<BigInt>(100000000));
+    }
+    Future<bool> isFunded(const std::string &address) override { return Future<bool>::successful(true); }
+    Future<std::string> getManagerKey(const std::string &address) override {
+        managerKeyCalls += 1;
+        return Future<std::string>::successful("edpkuySiX9Qi89G5aRaynPxLMqtrrjsMGZAGCUn7u2kBgYH5uxCwEy");
+    }
+    FuturePtr<BigInt> getCounter(const std::string &address) override {
+        counterCalls += 1;
+        if (pendingCounter) {
+            return pendingCounter->getFuture();
+        }
+        return FuturePtr<BigInt>::successful(std::make_shared<BigInt>(1294305));
+    }
+    FuturePtr<Block> getCurrentBlock() const override {
+        blockCalls += 1;
+        auto block = std::make_shared<Block>();
+        block->hash = "BMZZ7wBDd86iw5c5nkru6TRMVofsK8z2FUQzCRm1ik3qRHsG11Q";
+        block->height = 441019;
+        return FuturePtr<Block>::successful(block);
+    }
+    Future<String> pushTransaction(const std::vector<uint8_t> &transaction, const std::string &correlationId) override {
+        pushCalls += 1;
+        return Future<String>::successful(String("ooxSmgcPiGfg25QGEjaDRKbphDwifETGfZKZjwBGgB2MAcHs8WV"));
+    }
+
+    Future<void *> startSession() override { return fail<void *>(); }
+    Future<Unit> killSession(void *session) override { return fail<Unit>(); }
+    FuturePtr<TransactionsBulk> getTransactions(const std::vector<std::string> &addresses,
+                                                Option<std::string> fromBlockHash,
+                                                Option<void *> session) override { return fail<std::shared_ptr<TransactionsBulk>>(); }
+    Future<Bytes> getRawTransaction(const String &transactionHash) override { return fail<Bytes>(); }
+    FuturePtr<Transaction> getTransactionByHash(const String &transactionHash) const override { return fail<std::shared_ptr<Transaction>>(); }
+    Future<int64_t> getTimestamp() const override { return fail<int64_t>(); }
+    FuturePtr<BigInt> getFees() override { return fail<std::shared_ptr<BigInt>>(); }
+    FuturePtr<BigInt> getGasPrice() override { return fail<std::shared_ptr<BigInt>>(); }
+    FuturePtr<BigInt> getEstimatedGasLimit(const std::string &address) override { return fail<std::shared_ptr<BigInt>>(); }
+    FuturePtr<GasLimit> getEstimatedGasLimit(const std::shared_ptr<TezosLikeTransactionApi> &tx) override { return fail<std::shared_ptr<GasLimit>>(); }
+    FuturePtr<BigInt> getStorage(const std::string &address) override { return fail<std::shared_ptr<BigInt>>(); }
+    Future<std::vector<uint8_t>> forgeKTOperation(const std::shared_ptr<TezosLikeTransactionApi> &tx) override { return fail<std::vector<uint8_t>>(); }
+    Future<bool> isAllocated(const std::string &address) override { return fail<bool>(); }
+    Future<std::string> getCurrentDelegate(const std::string &address) override { return fail<std::string>(); }
+    Future<bool> isDelegate(const std::string &address) override { return fail<bool>(); }
+    FuturePtr<BigInt> getTokenBalance(const std::string &accountAddress,
+                                      const std::string &tokenAddress) const override { return fail<std::shared_ptr<BigInt>>(); }
+
+    std::atomic<int> managerKeyCalls;
+    std::atomic<int> counterCalls;
+    mutable std::atomic<int> blockCalls;
+    std::atomic<int> pushCalls;
+    // When set, getCounter answers only once the test completes this promise
+    std::shared_ptr<Promise<std::shared_ptr<BigInt>>> pendingCounter;
+
+private:
+    template <typename T>
+    static Future<T> fail() {
+        return Future<T>::failure(make_exception(api::ErrorCode::IMPLEMENTATION_IS_MISSING, "Not used by the tests"));
+    }
+};
+
 struct TezosMakeTransaction : public TezosMakeBaseTransaction {
     void SetUpConfig() override {
         auto configuration = DynamicObject::newInstance();
@@ -223,3 +291,72 @@ TEST_F(TezosMakeTransaction, ParseSignedRawDelegationTransaction) {
     EXPECT_EQ(tx->getStorageLimit()->toString(10), "300");
     EXPECT_EQ(tx->getCounter()->toString(10), "1294302");
 }
+
+TEST_F(TezosMakeTransaction, CachesTransactionPrerequisites) {
+    auto explorer = std::make_shared<CountingTezosExplorer>();
+    auto cachedAccount = std::make_shared<TezosLikeAccount>(wallet, account->getIndex(), explorer, nullptr, account->getKeychain());
+    auto build = [&] () {
+        auto builder = std::dynamic_pointer_cast<TezosLikeTransactionBuilder>(cachedAccount->buildTransaction());
+        builder->setFees(api::Amount::fromLong(currency, 250));
+        builder->setGasLimit(api::Amount::fromLong(currency, 10000));
+        builder->setStorageLimit(std::make_shared<api::BigIntImpl>(BigInt::fromString("1000")));
+        builder->sendToAddress(api::Amount::fromLong(currency, 220000), "tz1TRspM5SeZpaQUhzByXbEvqKF1vnCM2YTK");
+        return uv::wait(builder->build());
+    };
+
+    // Two builds within the TTL hit the network once
+    auto first = build();
+    auto second = build();
+    EXPECT_EQ(explorer->managerKeyCalls, 1);
+    EXPECT_EQ(explorer->counterCalls, 1);
+    EXPECT_EQ(explorer->blockCalls, 1);
+    // Each build got its own copy of the cached counter
+    EXPECT_EQ(first->getCounter()->toString(10), "1294306");
+    EXPECT_EQ(second->getCounter()->toString(10), "1294306");
+
+    // A broadcast changes the counter and the reveal status, the next build fetches them again
+    auto callback = std::make_shared<PromiseStringCallback>();
+    cachedAccount->broadcastRawTransaction(second->serialize(), callback);
+    uv::wait(callback->promise.getFuture());
+    EXPECT_EQ(explorer->pushCalls, 1);
+    build();
+    EXPECT_EQ(explorer->managerKeyCalls, 2);
+    EXPECT_EQ(explorer->counterCalls, 2);
+    // Any recent block is a valid branch, it isn't refetched
+    EXPECT_EQ(explorer->blockCalls, 1);
+
+    // A counter fetched across a broadcast is used by its own build but isn't cached
+    auto clearCallback = std::make_shared<PromiseStringCallback>();
+    cachedAccount->broadcastRawTransaction(second->serialize(), clearCallback);
+    uv::wait(clearCallback->promise.getFuture());
+    explorer->pendingCounter = std::make_shared<Promise<std::shared_ptr<BigInt>>>();
+    auto builder = std::dynamic_pointer_cast<TezosLikeTransactionBuilder>(cachedAccount->buildTransaction());
+    builder->setFees(api::Amount::fromLong(currency, 250));
+    builder->setGasLimit(api::Amount::fromLong(currency, 10000));
+    builder->setStorageLimit(std::make_shared<api::BigIntImpl>(BigInt::fromString("1000")));
+    builder->sendToAddress(api::Amount::fromLong(currency, 220000), "tz1TRspM5SeZpaQUhzByXbEvqKF1vnCM2YTK");
+    auto inFlight = builder->build();
+    EXPECT_EQ(explorer->counterCalls, 3);
+    auto staleCallback = std::make_shared<PromiseStringCallback>();
+    cachedAccount->broadcastRawTransaction(second->serialize(), staleCallback);
+    uv::wait(staleCallback->promise.getFuture());
+    auto pendingCounter = explorer->pendingCounter;
+    explorer->pendingCounter = nullptr;
+    pendingCounter->success(std::make_shared<BigInt>(1294305));
+    EXPECT_EQ(uv::wait(inFlight)->getCounter()->toString(10), "1294306");
+    build();
+    EXPECT_EQ(explorer->counterCalls, 4);
+}
+
+TEST_F(TezosMakeTransaction, ChecksArgumentsBeforeRequests) {
+    auto explorer = std::make_shared<CountingTezosExplorer>();
+    auto countingAccount = std::make_shared<TezosLikeAccount>(wallet, account->getIndex(), explorer, nullptr, account->getKeychain());
+    auto builder = std::dynamic_pointer_cast<TezosLikeTransactionBuilder>(countingAccount->buildTransaction());
+    builder->setFees(api::Amount::fromLong(currency, 250));
+    builder->sendToAddress(api::Amount::fromLong(currency, 220000), "tz1TRspM5SeZpaQUhzByXbEvqKF1vnCM2YTK");
+    // No gas limit nor storage limit: the build fails without reaching the network
+    EXPECT_THROW(uv::wait(builder->build()), Exception);
+    EXPECT_EQ(explorer->managerKeyCalls, 0);
+    EXPECT_EQ(explorer->counterCalls, 0);
+    EXPECT_EQ(explorer->blockCalls, 0);
+}
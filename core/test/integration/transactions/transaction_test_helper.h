@@ -46,6 +46,8 @@
 #include <wallet/tezos/TezosLikeWallet.h>
 #include <wallet/tezos/TezosLikeAccount.h>
 #include <wallet/tezos/transaction_builders/TezosLikeTransactionBuilder.h>
+#include <api/StringCallback.hpp>
+#include <async/Promise.hpp>
 #include "../BaseFixture.h"
 
 using namespace ledger::core;
@@ -66,6 +68,18 @@ struct TransactionTestData {
                                                      const std::shared_ptr<AbstractWallet>& )> inflate_xtz;
 };
 
+// Completes a promise with the result of a broadcast
+struct PromiseStringCallback : public api::StringCallback {
+    void onCallback(const std::experimental::optional<std::string> &result, const std::experimental::optional<api::Error> &error) override {
+        if (result) {
+            promise.success(result.value());
+        } else {
+            promise.failure(Exception(error.value().code, error.value().message));
+        }
+    }
+    Promise<std::string> promise;
+};
+
 struct BitcoinMakeBaseTransaction : public BaseFixture {
 
     struct InputDescr {
@@ -30,6 +30,9 @@
  */
 
 #include "BaseFixture.h"
+#include <wallet/bitcoin/database/BitcoinLikeRawTransactionDatabaseHelper.h>
+#include <wallet/bitcoin/BitcoinLikeRawTransactionStore.hpp>
+#include <atomic>
 
 static const std::string XPUB_1 = "xpub6EedcbfDs3pkzgqvoRxTW6P8NcCSaVbMQsb6xwCdEBzqZBronwY3Nte1Vjunza8f6eSMrYvbM5CMihGo6SbzpHxn4R5pvcr2ZbZ6wkDmgpy";
 
@@ -38,6 +41,40 @@ static const std::string SAMPLE_TRANSACTION_2 = "{\"hash\":\"9585deb93fd3f769ad9
 static const std::string SAMPLE_TRANSACTION_3 = "{\"hash\":\"5d0fcab290dac66ee9da149a948d1e30d16d2f8f852eccaf4394021deeaa7b61\",\"received_at\":\"2017-06-07T16:05:33Z\",\"lock_time\":0,\"block\":null,\"inputs\":[{\"input_index\":0,\"output_hash\":\"bd8eabb80b020c5b05b0d2a69b64a81380049c6102477698ea7b73d13776458c\",\"output_index\":0,\"value\":5449257,\"address\":\"1DiKs1fV7HjcDdZNJTG7GFVyXbVe834uax\",\"script_signature\":\"4730440221009b37fa67b7320f597e0f4b2c1aaab705927e888e4c1b0fff45a3f7e394041b1c021f600cbea1955e6d57b38c737d52ca68a58eeb69d870f06c8cbbcaf2c0eefcc5012103fcc5efc0c3a0dd30b9f64d99ee372a43d9985791c49ed92b66e74a3315767c28\"}],\"outputs\":[{\"output_index\":0,\"value\":20000,\"address\":\"1TipsnxGEhPwNxhAwKouhHgTUnmmuYg9P\",\"script_hex\":\"76a914050dbaa82baeaa15ab5e31385fd880a8f25ef42288ac\"},{\"output_index\":1,\"value\":5350185,\"address\":\"1NkDgmWnuMYXrqXyFgQcAfaxJt93Sm5fHd\",\"script_hex\":\"76a914ee871e04c6f17f2e4bc73d73233c761544f3eefb88ac\"}],\"fees\":79072,\"amount\":5370185,\"confirmations\":0}";
 
 
+// Explorer serving a raw transaction made of its hash characters, counting the requests
+class CountingRawTransactionExplorer : public BitcoinLikeBlockchainExplorer {
+public:
+    CountingRawTransactionExplorer() : BitcoinLikeBlockchainExplorer(api::DynamicObject::newInstance(), {}), rawTransactionCalls(0) {}
+
+    Future<Bytes> getRawTransaction(const String& transactionHash) override {
+        rawTransactionCalls += 1;
+        return Future<Bytes>::successful(Bytes(rawTransaction(transactionHash.str())));
+    }
+
+    static std::vector<uint8_t> rawTransaction(const std::string& hash) {
+        return std::vector<uint8_t>(hash.begin(), hash.end());
+    }
+
+    Future<void *> startSession() override { return fail<void *>(); }
+    Future<Unit> killSession(void *session) override { return fail<Unit>(); }
+    FuturePtr<TransactionsBulk> getTransactions(const std::vector<std::string>& addresses,
+                                                Option<std::string> fromBlockHash,
+                                                Option<void*> session) override { return fail<std::shared_ptr<TransactionsBulk>>(); }
+    FuturePtr<Block> getCurrentBlock() const override { return fail<std::shared_ptr<Block>>(); }
+    FuturePtr<Transaction> getTransactionByHash(const String& transactionHash) const override { return fail<std::shared_ptr<Transaction>>(); }
+    Future<String> pushTransaction(const std::vector<uint8_t>& transaction, const std::string& correlationId) override { return fail<String>(); }
+    Future<int64_t> getTimestamp() const override { return fail<int64_t>(); }
+    Future<std::vector<std::shared_ptr<api::BigInt>>> getFees() override { return fail<std::vector<std::shared_ptr<api::BigInt>>>(); }
+
+    std::atomic<int> rawTransactionCalls;
+
+private:
+    template <typename T>
+    static Future<T> fail() {
+        return Future<T>::failure(make_exception(api::ErrorCode::IMPLEMENTATION_IS_MISSING, "Not used by the tests"));
+    }
+};
+
 class BitcoinWalletDatabaseTests : public BaseFixture {
     public:
     std::shared_ptr<WalletPool> pool;
@@ -191,4 +228,77 @@ TEST_F(BitcoinWalletDatabaseTests, PutOperations) {
     ASSERT_EXPECTATION(2);
     ASSERT_EXPECTATION(3);
     ASSERT_EXPECTATION(4);
+
+    auto byAmount = uv::wait(std::static_pointer_cast<OperationQuery>(
+            account->queryOperations()->addOrder(api::OperationOrderKey::AMOUNT, true))->execute());
+    ASSERT_EQ(byAmount.size(), 5);
+    EXPECT_EQ(byAmount[0]->getAmount()->toBigInt()->intValue(), 182593500);
+    EXPECT_EQ(byAmount[4]->getAmount()->toBigInt()->intValue(), 100000);
+
+    auto threshold = std::make_shared<Amount>(wallet->getCurrency(), 0, BigInt(100000));
+    auto filteredQuery = account->queryOperations();
+    filteredQuery->filter()->op_and(api::QueryFilter::amountGt(threshold));
+    auto aboveThreshold = uv::wait(std::static_pointer_cast<OperationQuery>(filteredQuery)->execute());
+    ASSERT_EQ(aboveThreshold.size(), 1);
+    EXPECT_EQ(aboveThreshold[0]->getAmount()->toBigInt()->intValue(), 182593500);
+
+    // The spent flag of the outputs follows the inputs spending them
+    soci::session sql(pool->getDatabaseSessionPool()->getPool());
+    const auto spentByInputs = "SELECT COUNT(*) FROM bitcoin_outputs AS o WHERE EXISTS ("
+                               "SELECT 1 FROM bitcoin_inputs AS i WHERE i.previous_tx_uid = o.transaction_uid "
+                               "AND i.previous_output_idx = o.idx)";
+    int flagged = 0, spent = 0;
+    sql << "SELECT COUNT(*) FROM bitcoin_outputs WHERE spent = 1", soci::into(flagged);
+    sql << spentByInputs, soci::into(spent);
+    EXPECT_GT(spent, 0);
+    EXPECT_EQ(flagged, spent);
+
+    sql << "DELETE FROM bitcoin_inputs";
+    sql << "SELECT COUNT(*) FROM bitcoin_outputs WHERE spent = 1", soci::into(flagged);
+    EXPECT_EQ(flagged, 0);
+}
+
+TEST_F(BitcoinWalletDatabaseTests, RawTransactionsEviction) {
+    soci::session sql(pool->getDatabaseSessionPool()->getPool());
+    const std::vector<std::string> hashes = {"a1", "b2", "c3"};
+    for (std::size_t i = 0; i < hashes.size(); i++) {
+        BitcoinLikeRawTransactionDatabaseHelper::putRawTransaction(sql, "bitcoin", hashes[i], std::vector<uint8_t>(100, (uint8_t)i), i);
+    }
+    EXPECT_EQ(BitcoinLikeRawTransactionDatabaseHelper::getRawTransactionsSize(sql, "bitcoin"), 300);
+
+    // Reading "a1" makes "b2" the least recently used transaction
+    std::unordered_map<std::string, std::vector<uint8_t>> found;
+    BitcoinLikeRawTransactionDatabaseHelper::getRawTransactions(sql, "bitcoin", {"a1", "unknown"}, 10, found);
+    ASSERT_EQ(found.size(), 1);
+    EXPECT_EQ(found["a1"], std::vector<uint8_t>(100, 0));
+
+    EXPECT_EQ(BitcoinLikeRawTransactionDatabaseHelper::evictRawTransactions(sql, "bitcoin", 250), 1);
+    found.clear();
+    BitcoinLikeRawTransactionDatabaseHelper::getRawTransactions(sql, "bitcoin", hashes, 20, found);
+    EXPECT_EQ(found.size(), 2);
+    EXPECT_EQ(found.count("b2"), 0);
+    EXPECT_EQ(BitcoinLikeRawTransactionDatabaseHelper::evictRawTransactions(sql, "bitcoin", 250), 0);
+}
+
+TEST_F(BitcoinWalletDatabaseTests, RawTransactionsStoreServesStoredTransactions) {
+    auto explorer = std::make_shared<CountingRawTransactionExplorer>();
+    auto store = std::make_shared<BitcoinLikeRawTransactionStore>(
+            dispatcher->getSerialExecutionContext("raw_transactions"), pool->getDatabaseSessionPool(), explorer, "bitcoin", 1000000);
+
+    // First use goes to the explorer, the next ones are served by the store
+    EXPECT_EQ(uv::wait(store->getRawTransaction("a1")), CountingRawTransactionExplorer::rawTransaction("a1"));
+    EXPECT_EQ(explorer->rawTransactionCalls, 1);
+    EXPECT_EQ(uv::wait(store->getRawTransaction("a1")), CountingRawTransactionExplorer::rawTransaction("a1"));
+    EXPECT_EQ(explorer->rawTransactionCalls, 1);
+
+    {
+        soci::session sql(pool->getDatabaseSessionPool()->getPool());
+        BitcoinLikeRawTransactionDatabaseHelper::putRawTransaction(sql, "bitcoin", "b2", std::vector<uint8_t>(10, 2), 0);
+    }
+    // Only the transactions missing from the store are fetched, once each
+    uv::wait(store->prefetch({"a1", "b2", "c3", "c3"}));
+    EXPECT_EQ(explorer->rawTransactionCalls, 2);
+    EXPECT_EQ(uv::wait(store->getRawTransaction("b2")), std::vector<uint8_t>(10, 2));
+    EXPECT_EQ(uv::wait(store->getRawTransaction("c3")), CountingRawTransactionExplorer::rawTransaction("c3"));
+    EXPECT_EQ(explorer->rawTransactionCalls, 2);
 }
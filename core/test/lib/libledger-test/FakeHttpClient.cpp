@@ -7,14 +7,25 @@ namespace ledger {
     namespace core {
         namespace test {
             void FakeHttpClient::execute(const std::shared_ptr<api::HttpRequest>& request) {
+                {
+                    std::lock_guard<std::mutex> lock(_lock);
+                    _requestCounts[request->getUrl()] += 1;
+                }
                 auto it = _behavior.find(request->getUrl());
                 if (it != _behavior.end()) {
-                    request->complete(it->second, std::experimental::nullopt);
+                    // Each request reads its own copy of the body
+                    request->complete(std::make_shared<FakeUrlConnection>(*it->second), std::experimental::nullopt);
                     return;
                 }
                 request->complete(std::shared_ptr<api::HttpUrlConnection>(), api::Error(api::ErrorCode::BLOCK_NOT_FOUND, "Block not found"));
             }
 
+            size_t FakeHttpClient::getRequestCount(const std::string& url) const {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto it = _requestCounts.find(url);
+                return it == _requestCounts.end() ? 0 : it->second;
+            }
+
             void FakeHttpClient::setBehavior(const std::unordered_map<std::string, std::shared_ptr<FakeUrlConnection>>& behavior) {
                 _behavior = behavior;
             }
@@ -1,6 +1,7 @@
 #pragma once
 #include "api/HttpClient.hpp"
 #include <unordered_map>
+#include <mutex>
 #include "proxy-http-client/FakeUrlConnection.hpp"
 
 namespace ledger {
@@ -11,8 +12,12 @@ namespace ledger {
             public:
                 void execute(const std::shared_ptr<api::HttpRequest>& request) override;
                 void setBehavior(const std::unordered_map<std::string, std::shared_ptr<FakeUrlConnection>>& behavior);
+                // Number of requests executed for the given URL
+                size_t getRequestCount(const std::string& url) const;
             private:
                 std::unordered_map<std::string, std::shared_ptr<FakeUrlConnection>> _behavior;
+                mutable std::mutex _lock;
+                std::unordered_map<std::string, size_t> _requestCounts;
             };
 
         }
@@ -30,7 +30,9 @@ namespace ledger {
             };
 
             api::HttpReadBodyResult FakeUrlConnection::readBody() {
+                // The whole body is returned by the first call, the following ones return an empty chunk
                 std::vector<uint8_t> bindata((const uint8_t*)_data.body.data(), (const uint8_t*)_data.body.data() + _data.body.size());
+                _data.body.clear();
                 api::HttpReadBodyResult result(std::experimental::nullopt, bindata);
                 return result;
             };
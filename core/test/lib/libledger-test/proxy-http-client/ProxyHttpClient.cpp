@@ -179,7 +179,8 @@ namespace ledger {
                 auto it = _cache.find(request->getUrl() + vector_uint8_to_string(request->getBody()));
                 if (it != _cache.end() && !_logger) {
                     std::cout << "get response from cache : " << request->getUrl() << std::endl;
-                    request->complete(it->second, std::experimental::nullopt);
+                    // Each request reads its own copy of the body
+                    request->complete(std::make_shared<FakeUrlConnection>(*it->second), std::experimental::nullopt);
                     return;
                 }
 
@@ -191,4 +191,19 @@ TEST(BigInt, AssignFromSigned64bitScalar) {
     BigInt bigInt;
     bigInt.assignScalar(value);
     EXPECT_EQ(value, bigInt.toUint64());
-}
\ No newline at end of file
+}
+
+TEST(BigInt, CrossesSmallValueBoundary) {
+    auto max = BigInt::fromScalar<uint64_t>(std::numeric_limits<uint64_t>::max());
+    auto overflow = max + BigInt::ONE;
+    EXPECT_EQ(overflow.toString(), "18446744073709551616");
+    EXPECT_EQ(overflow.toHexString(), "010000000000000000");
+    EXPECT_EQ(overflow.toByteArray(), std::vector<uint8_t>({1, 0, 0, 0, 0, 0, 0, 0, 0}));
+    EXPECT_TRUE(overflow > max);
+    EXPECT_EQ(overflow - BigInt::ONE, max);
+    EXPECT_EQ((max * max) / max, max);
+    EXPECT_EQ(BigInt::fromDecimal("-18446744073709551616") + overflow, BigInt::ZERO);
+    EXPECT_EQ(BigInt::fromHex("ffffffffffffffff"), max);
+    EXPECT_EQ(BigInt::ZERO.toByteArray(), std::vector<uint8_t>({0}));
+    EXPECT_EQ(BigInt::ZERO.toHexString(), "00");
+}
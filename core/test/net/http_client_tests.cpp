@@ -34,11 +34,17 @@
 #include <NativeThreadDispatcher.hpp>
 #include <NativePathResolver.hpp>
 #include <fstream>
+#include <deque>
 #include <mongoose.h>
 #include <MongooseHttpClient.hpp>
 #include <MongooseSimpleRestServer.hpp>
 #include <ledger/core/net/HttpClient.hpp>
 #include <ledger/core/net/HttpJsonHandler.hpp>
+#include <ledger/core/net/HttpUrlConnectionInputStream.hpp>
+#include <ledger/core/net/HttpCache.hpp>
+#include <ledger/core/net/HttpRequestScheduler.hpp>
+#include <FakeHttpClient.hpp>
+#include <ledger/core/api/HttpReadBodyResult.hpp>
 #include <boost/lexical_cast.hpp>
 
 static std::string BIG_TEXT =
@@ -348,3 +354,245 @@ TEST(HttpClient, GETWithSaxError) {
         WAIT_AND_TIMEOUT(dispatcher, 10000);
     }
 }
+
+class ChunkedUrlConnection : public api::HttpUrlConnection {
+public:
+    ChunkedUrlConnection(const std::vector<std::string>& chunks) : _chunks(chunks.begin(), chunks.end()), reads(0) {}
+
+    int32_t getStatusCode() override { return 200; }
+    std::string getStatusText() override { return "OK"; }
+    std::unordered_map<std::string, std::string> getHeaders() override { return {}; }
+
+    api::HttpReadBodyResult readBody() override {
+        reads += 1;
+        std::vector<uint8_t> chunk;
+        if (!_chunks.empty()) {
+            chunk.assign(_chunks.front().begin(), _chunks.front().end());
+            _chunks.pop_front();
+        }
+        return api::HttpReadBodyResult(std::experimental::nullopt, chunk);
+    }
+
+private:
+    std::deque<std::string> _chunks;
+
+public:
+    int reads;
+};
+
+TEST(HttpUrlConnectionInputStream, ParseChunkedBody) {
+    auto connection = std::make_shared<ChunkedUrlConnection>(std::vector<std::string>{
+        "{\"hello\": \"wo", "rld\", \"n", "umbers\": [1, 2", "", "3]}"
+    });
+    HttpUrlConnectionInputStream is(connection);
+    rapidjson::Document doc;
+    doc.ParseStream(is);
+
+    // The empty chunk ends the body, the last one is never read
+    EXPECT_TRUE(doc.HasParseError());
+    EXPECT_EQ(connection->reads, 4);
+    EXPECT_EQ(is.Peek(), '\0');
+    EXPECT_EQ(connection->reads, 4);
+}
+
+TEST(HttpUrlConnectionInputStream, ParseBodyAcrossChunks) {
+    auto connection = std::make_shared<ChunkedUrlConnection>(std::vector<std::string>{
+        "{\"hello\": \"wo", "rld\", \"n", "umbers\": [1, 2", "3]}"
+    });
+    HttpUrlConnectionInputStream is(connection);
+    rapidjson::Document doc;
+    doc.ParseStream(is);
+
+    ASSERT_FALSE(doc.HasParseError());
+    EXPECT_EQ(std::string(doc["hello"].GetString()), "world");
+    EXPECT_EQ(doc["numbers"].Size(), 2);
+    EXPECT_EQ(doc["numbers"][1].GetInt(), 23);
+    EXPECT_EQ(is.Tell(), 38);
+    EXPECT_EQ(connection->reads, 5);
+}
+
+class StaticUrlConnection : public api::HttpUrlConnection {
+public:
+    StaticUrlConnection(int32_t statusCode, const std::string& body, const std::unordered_map<std::string, std::string>& headers)
+        : _statusCode(statusCode), _body(body), _headers(headers) {}
+
+    int32_t getStatusCode() override { return _statusCode; }
+    std::string getStatusText() override { return ""; }
+    std::unordered_map<std::string, std::string> getHeaders() override { return _headers; }
+
+    api::HttpReadBodyResult readBody() override {
+        std::vector<uint8_t> chunk(_body.begin(), _body.end());
+        _body.clear();
+        return api::HttpReadBodyResult(std::experimental::nullopt, chunk);
+    }
+
+private:
+    int32_t _statusCode;
+    std::string _body;
+    std::unordered_map<std::string, std::string> _headers;
+};
+
+static std::string readAll(const std::shared_ptr<api::HttpUrlConnection>& connection) {
+    auto chunk = connection->readBody();
+    return std::string(chunk.data->begin(), chunk.data->end());
+}
+
+TEST(HttpCache, CoalesceInFlightRequests) {
+    auto cache = std::make_shared<HttpCache>();
+    auto context = ImmediateExecutionContext::INSTANCE;
+    Promise<std::shared_ptr<api::HttpUrlConnection>> response;
+    int fetches = 0;
+    auto fetch = [&] (const std::unordered_map<std::string, std::string>&) {
+        fetches += 1;
+        return response.getFuture();
+    };
+
+    auto first = cache->get("/blocks/current", std::chrono::milliseconds(0), context, fetch);
+    auto second = cache->get("/blocks/current", std::chrono::milliseconds(0), context, fetch);
+    EXPECT_EQ(fetches, 1);
+    response.success(std::make_shared<StaticUrlConnection>(200, "{\"height\": 42}", std::unordered_map<std::string, std::string>()));
+
+    ASSERT_TRUE(first.isCompleted() && second.isCompleted());
+    EXPECT_EQ(readAll(first.getValue().getValue().getValue()), "{\"height\": 42}");
+    EXPECT_EQ(readAll(second.getValue().getValue().getValue()), "{\"height\": 42}");
+
+    // Not in flight anymore and expired right away
+    Promise<std::shared_ptr<api::HttpUrlConnection>> next;
+    auto third = cache->get("/blocks/current", std::chrono::milliseconds(0), context, [&] (const std::unordered_map<std::string, std::string>&) {
+        fetches += 1;
+        return next.getFuture();
+    });
+    EXPECT_EQ(fetches, 2);
+}
+
+TEST(HttpCache, ForgetRequestsFailingToStart) {
+    auto cache = std::make_shared<HttpCache>();
+    auto context = ImmediateExecutionContext::INSTANCE;
+    int fetches = 0;
+    auto failed = cache->get("/blocks/current", std::chrono::hours(1), context, [&] (const std::unordered_map<std::string, std::string>&) -> Future<std::shared_ptr<api::HttpUrlConnection>> {
+        fetches += 1;
+        throw make_exception(api::ErrorCode::UNABLE_TO_CONNECT_TO_HOST, "Cannot send the request");
+    });
+    ASSERT_TRUE(failed.isCompleted());
+    EXPECT_EQ(failed.getValue().getValue().getFailure().getErrorCode(), api::ErrorCode::UNABLE_TO_CONNECT_TO_HOST);
+
+    // The failed request is neither in flight nor cached anymore
+    auto retried = cache->get("/blocks/current", std::chrono::hours(1), context, [&] (const std::unordered_map<std::string, std::string>&) {
+        fetches += 1;
+        std::shared_ptr<api::HttpUrlConnection> connection = std::make_shared<StaticUrlConnection>(
+            200, "{\"height\": 42}", std::unordered_map<std::string, std::string>());
+        return Future<std::shared_ptr<api::HttpUrlConnection>>::successful(connection);
+    });
+    EXPECT_EQ(fetches, 2);
+    ASSERT_TRUE(retried.isCompleted());
+    EXPECT_EQ(readAll(retried.getValue().getValue().getValue()), "{\"height\": 42}");
+}
+
+TEST(HttpCache, ReuseFreshResponseAndRevalidateWithETag) {
+    auto cache = std::make_shared<HttpCache>();
+    auto context = ImmediateExecutionContext::INSTANCE;
+    std::vector<std::unordered_map<std::string, std::string>> requests;
+    int32_t status = 200;
+    auto fetch = [&] (const std::unordered_map<std::string, std::string>& headers) {
+        requests.push_back(headers);
+        std::shared_ptr<api::HttpUrlConnection> connection = std::make_shared<StaticUrlConnection>(
+            status, status == 200 ? "fees" : "", std::unordered_map<std::string, std::string>{{"etag", "\"v1\""}});
+        return Future<std::shared_ptr<api::HttpUrlConnection>>::successful(connection);
+    };
+
+    auto first = cache->get("/fees", std::chrono::hours(1), context, fetch);
+    auto second = cache->get("/fees", std::chrono::hours(1), context, fetch);
+    EXPECT_EQ(requests.size(), 1);
+    EXPECT_EQ(readAll(second.getValue().getValue().getValue()), "fees");
+
+    // A stale response is revalidated, the server answers that it did not change
+    cache->get("/other", std::chrono::milliseconds(0), context, fetch);
+    status = 304;
+    auto revalidated = cache->get("/other", std::chrono::milliseconds(0), context, fetch);
+    ASSERT_EQ(requests.size(), 3);
+    EXPECT_EQ(requests[2].at("If-None-Match"), "\"v1\"");
+    EXPECT_EQ(revalidated.getValue().getValue().getValue()->getStatusCode(), 200);
+    EXPECT_EQ(readAll(revalidated.getValue().getValue().getValue()), "fees");
+}
+
+static HttpRequestScheduler::Parameters immediateRetries(int32_t maxConcurrentRequestsPerHost, int32_t maxRetries) {
+    HttpRequestScheduler::Parameters parameters;
+    parameters.maxConcurrentRequestsPerHost = maxConcurrentRequestsPerHost;
+    parameters.maxRetries = maxRetries;
+    parameters.retryBaseDelay = std::chrono::milliseconds(0);
+    return parameters;
+}
+
+TEST(HttpRequestScheduler, RetryIdempotentRequestsAndBackOff) {
+    auto context = ImmediateExecutionContext::INSTANCE;
+    auto engine = std::make_shared<test::FakeHttpClient>();
+    test::UrlConnectionData unavailable{503, "Service Unavailable", {}, "{}"};
+    engine->setBehavior({
+        {"http://explorer/blocks/current", std::make_shared<test::FakeUrlConnection>(unavailable)},
+        {"http://explorer/transactions/send", std::make_shared<test::FakeUrlConnection>(unavailable)}
+    });
+    ledger::core::HttpClient http("http://explorer", engine, context, context);
+    auto scheduler = std::make_shared<HttpRequestScheduler>(context, immediateRetries(16, 2));
+    http.setRequestScheduler(scheduler);
+
+    auto get = http.GET("/blocks/current")();
+    ASSERT_TRUE(get.isCompleted());
+    EXPECT_TRUE(get.getValue().getValue().isFailure());
+    EXPECT_EQ(get.getValue().getValue().getFailure().getErrorCode(), api::ErrorCode::UNABLE_TO_CONNECT_TO_HOST);
+    EXPECT_EQ(engine->getRequestCount("http://explorer/blocks/current"), 3);
+    // Every 503 halved the concurrency of the host
+    EXPECT_EQ(scheduler->getConcurrencyLimit("explorer"), 2);
+
+    // POST is never sent twice
+    auto post = http.POST("/transactions/send", std::vector<uint8_t>())();
+    ASSERT_TRUE(post.isCompleted());
+    EXPECT_TRUE(post.getValue().getValue().isFailure());
+    EXPECT_EQ(engine->getRequestCount("http://explorer/transactions/send"), 1);
+
+    auto metrics = scheduler->getMetrics();
+    EXPECT_EQ(metrics.requests, 4);
+    EXPECT_EQ(metrics.retries, 2);
+}
+
+class PendingHttpClient : public api::HttpClient {
+public:
+    void execute(const std::shared_ptr<api::HttpRequest>& request) override {
+        requests.push_back(request);
+    }
+
+    void completeFirst() {
+        auto request = requests.front();
+        requests.pop_front();
+        request->complete(test::FakeUrlConnection::fromString("{}"), std::experimental::nullopt);
+    }
+
+    std::deque<std::shared_ptr<api::HttpRequest>> requests;
+};
+
+TEST(HttpRequestScheduler, LimitConcurrencyAndPrioritize) {
+    auto context = ImmediateExecutionContext::INSTANCE;
+    auto engine = std::make_shared<PendingHttpClient>();
+    ledger::core::HttpClient http("http://explorer", engine, context, context);
+    auto scheduler = std::make_shared<HttpRequestScheduler>(context, immediateRetries(1, 0));
+    http.setRequestScheduler(scheduler);
+
+    auto first = http.GET("/addresses/a/transactions")();
+    auto second = http.GET("/addresses/b/transactions")();
+    auto broadcast = http.POST("/transactions/send", std::vector<uint8_t>()).prioritized()();
+    ASSERT_EQ(engine->requests.size(), 1);
+    EXPECT_EQ(engine->requests.front()->getUrl(), "http://explorer/addresses/a/transactions");
+
+    engine->completeFirst();
+    EXPECT_TRUE(first.isCompleted());
+    ASSERT_EQ(engine->requests.size(), 1);
+    EXPECT_EQ(engine->requests.front()->getUrl(), "http://explorer/transactions/send");
+
+    engine->completeFirst();
+    EXPECT_TRUE(broadcast.isCompleted());
+    ASSERT_EQ(engine->requests.size(), 1);
+    EXPECT_EQ(engine->requests.front()->getUrl(), "http://explorer/addresses/b/transactions");
+
+    engine->completeFirst();
+    EXPECT_TRUE(second.isCompleted());
+    EXPECT_EQ(scheduler->getMetrics().requests, 3);
+}
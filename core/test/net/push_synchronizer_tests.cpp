@@ -0,0 +1,284 @@
+/*
+ *
+ * push_synchronizer_tests.cpp
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <net/WebSocketClient.h>
+#include <wallet/pool/PushSynchronizer.hpp>
+#include <async/Promise.hpp>
+#include <FakeWebSocketClient.h>
+#include <list>
+#include <map>
+
+using namespace ledger::core;
+
+// Runs the queued runnables when told to, so that delays can be tested without waiting
+class ManualExecutionContext : public api::ExecutionContext {
+public:
+    void execute(const std::shared_ptr<api::Runnable> &runnable) override {
+        delay(runnable, 0);
+    }
+
+    void delay(const std::shared_ptr<api::Runnable> &runnable, int64_t millis) override {
+        _queue.emplace(std::make_pair(_now + millis, _sequence++), runnable);
+    }
+
+    void advance(int64_t millis) {
+        auto target = _now + millis;
+        while (!_queue.empty() && _queue.begin()->first.first <= target) {
+            auto it = _queue.begin();
+            _now = std::max(_now, it->first.first);
+            auto runnable = it->second;
+            _queue.erase(it);
+            runnable->run();
+        }
+        _now = target;
+    }
+
+private:
+    int64_t _now = 0;
+    int64_t _sequence = 0;
+    std::map<std::pair<int64_t, int64_t>, std::shared_ptr<api::Runnable>> _queue;
+};
+
+class PushSynchronizerTest : public ::testing::Test {
+public:
+    void SetUp() override {
+        engine = std::make_shared<FakeWebSocketClient>();
+        context = std::make_shared<ManualExecutionContext>();
+        PushSynchronizer::Parameters parameters;
+        parameters.debounce = std::chrono::milliseconds(100);
+        parameters.pollingInterval = std::chrono::milliseconds(1000);
+        parameters.maxBatchSize = 2;
+        parameters.confirmationBlocks = 2;
+        synchronizer = std::make_shared<PushSynchronizer>(std::make_shared<WebSocketClient>(engine), context, parameters);
+    }
+
+    // Subscribes an account owning a single address, its synchronizations stay pending until
+    // completed by the test
+    void subscribe(const std::string& uid, const std::string& address) {
+        PushSynchronizer::Subscriber subscriber;
+        subscriber.uid = uid;
+        subscriber.ownsAddress = [this, uid, address] (const std::string& a) {
+            lookups[uid] += 1;
+            return a == address;
+        };
+        subscriber.synchronize = [this, uid] () {
+            syncs[uid] += 1;
+            pending.emplace_back();
+            return pending.back().getFuture();
+        };
+        synchronizer->subscribe(endpoint, subscriber);
+    }
+
+    void completeSyncs() {
+        auto promises = std::move(pending);
+        pending.clear();
+        for (auto& promise : promises) {
+            promise.success(unit);
+        }
+        context->advance(0);
+    }
+
+    static std::string transaction(const std::string& from, const std::string& to) {
+        return fmt::format(R"({{"payload": {{"type": "new-transaction", "transaction": {{)"
+                           R"("inputs": [{{"address": "{}"}}], "outputs": [{{"address": "{}"}}]}}}}}})", from, to);
+    }
+
+    const std::string endpoint = "wss://notifications.test/btc/ws";
+    const std::string block = R"({"payload": {"type": "new-block", "block": {"height": 42}}})";
+    std::shared_ptr<FakeWebSocketClient> engine;
+    std::shared_ptr<ManualExecutionContext> context;
+    std::shared_ptr<PushSynchronizer> synchronizer;
+    std::map<std::string, int> syncs;
+    std::map<std::string, int> lookups;
+    std::list<Promise<Unit>> pending;
+};
+
+TEST_F(PushSynchronizerTest, SynchronizesNotifiedAccountsOnly) {
+    subscribe("alice", "1Alice");
+    subscribe("bob", "1Bob");
+    subscribe("carol", "1Carol");
+    EXPECT_TRUE(synchronizer->isConnected(endpoint));
+
+    engine->push(transaction("1Alice", "1Someone"));
+    engine->push(transaction("1Someone", "1Bob"));
+    context->advance(99);
+    EXPECT_TRUE(syncs.empty());
+    context->advance(1);
+    EXPECT_EQ(syncs, (std::map<std::string, int>{{"alice", 1}, {"bob", 1}}));
+
+    // Unknown or malformed notifications are ignored
+    engine->push(R"({"payload": {"type": "new-transaction", "transaction": {"inputs": []}}})");
+    engine->push("not json");
+    completeSyncs();
+    context->advance(1000);
+    EXPECT_EQ(syncs, (std::map<std::string, int>{{"alice", 1}, {"bob", 1}}));
+}
+
+TEST_F(PushSynchronizerTest, DebouncesAndBatchesSynchronizations) {
+    subscribe("alice", "1Alice");
+    subscribe("bob", "1Bob");
+    subscribe("carol", "1Carol");
+
+    for (auto i = 0; i < 10; i++) {
+        engine->push(transaction("1Alice", "1Bob"));
+        engine->push(transaction("1Carol", "1Alice"));
+    }
+    context->advance(100);
+    EXPECT_EQ(pending.size(), 2);
+    auto firstBatch = syncs;
+
+    // Notified during the first batch, its accounts are synchronized again with the next ones while
+    // the account left out is synchronized once
+    engine->push(transaction("1Alice", "1Bob"));
+    engine->push(transaction("1Carol", "1Someone"));
+    completeSyncs();
+    EXPECT_EQ(pending.size(), 2);
+    completeSyncs();
+    EXPECT_EQ(pending.size(), 1);
+    completeSyncs();
+    context->advance(1000);
+    EXPECT_TRUE(pending.empty());
+    for (const auto& uid : {"alice", "bob", "carol"}) {
+        EXPECT_EQ(syncs[uid], static_cast<int>(firstBatch.count(uid)) + 1);
+    }
+}
+
+TEST_F(PushSynchronizerTest, ResynchronizesUnconfirmedAccountsOnNewBlocks) {
+    subscribe("alice", "1Alice");
+    subscribe("bob", "1Bob");
+
+    engine->push(transaction("1Alice", "1Someone"));
+    context->advance(100);
+    completeSyncs();
+
+    for (auto i = 0; i < 4; i++) {
+        engine->push(block);
+        context->advance(100);
+        completeSyncs();
+    }
+    // One synchronization for the transaction, then one per block until confirmationBlocks
+    EXPECT_EQ(syncs, (std::map<std::string, int>{{"alice", 3}}));
+}
+
+TEST_F(PushSynchronizerTest, PollsWhileDisconnected) {
+    subscribe("alice", "1Alice");
+    subscribe("bob", "1Bob");
+
+    std::string reason = "Connection lost";
+    engine->closeAll(api::ErrorCode::NO_INTERNET_CONNECTIVITY, reason);
+    EXPECT_FALSE(synchronizer->isConnected(endpoint));
+    context->advance(999);
+    EXPECT_TRUE(syncs.empty());
+
+    // The poll synchronizes everybody and reconnects
+    context->advance(1);
+    EXPECT_EQ(syncs, (std::map<std::string, int>{{"alice", 1}, {"bob", 1}}));
+    EXPECT_TRUE(synchronizer->isConnected(endpoint));
+    completeSyncs();
+
+    // Connected again, polling stopped
+    context->advance(5000);
+    EXPECT_EQ(syncs, (std::map<std::string, int>{{"alice", 1}, {"bob", 1}}));
+}
+
+TEST_F(PushSynchronizerTest, StopsSynchronizingUnsubscribedAccounts) {
+    subscribe("alice", "1Alice");
+    subscribe("bob", "1Bob");
+
+    engine->push(transaction("1Alice", "1Bob"));
+    synchronizer->unsubscribe("bob");
+    context->advance(100);
+    EXPECT_EQ(syncs, (std::map<std::string, int>{{"alice", 1}}));
+
+    // The connection is closed with the last subscriber
+    synchronizer->unsubscribe("alice");
+    EXPECT_FALSE(synchronizer->isConnected(endpoint));
+}
+
+TEST_F(PushSynchronizerTest, UnsubscribeAllClosesConnections) {
+    subscribe("alice", "1Alice");
+    synchronizer->unsubscribeAll();
+    EXPECT_FALSE(synchronizer->isConnected(endpoint));
+
+    engine->push(transaction("1Alice", "1Someone"));
+    context->advance(5000);
+    EXPECT_TRUE(syncs.empty());
+}
+
+TEST_F(PushSynchronizerTest, LooksUpEachAddressOnce) {
+    subscribe("alice", "1Alice");
+    subscribe("bob", "1Bob");
+
+    for (auto i = 0; i < 10; i++) {
+        engine->push(transaction("1Alice", "1Someone"));
+    }
+    EXPECT_EQ(lookups, (std::map<std::string, int>{{"alice", 2}, {"bob", 2}}));
+
+    // Addresses owned by nobody are looked up again after a synchronization, it may derive them
+    context->advance(100);
+    completeSyncs();
+    engine->push(transaction("1Alice", "1Someone"));
+    EXPECT_EQ(lookups, (std::map<std::string, int>{{"alice", 3}, {"bob", 3}}));
+    context->advance(100);
+    EXPECT_EQ(syncs, (std::map<std::string, int>{{"alice", 2}}));
+}
+
+TEST_F(PushSynchronizerTest, SynchronizesEveryOwnerOfAnAddress) {
+    // The same xpub in two wallets, the second one subscribing once the address is indexed
+    subscribe("first-wallet", "1Shared");
+    engine->push(transaction("1Shared", "1Someone"));
+    context->advance(100);
+    completeSyncs();
+    EXPECT_EQ(syncs, (std::map<std::string, int>{{"first-wallet", 1}}));
+
+    subscribe("second-wallet", "1Shared");
+    engine->push(transaction("1Shared", "1Someone"));
+    context->advance(100);
+    EXPECT_EQ(syncs, (std::map<std::string, int>{{"first-wallet", 2}, {"second-wallet", 1}}));
+}
+
+TEST_F(PushSynchronizerTest, LooksUpAddressesUnlocked) {
+    // A subscriber calling back the synchronizer while looking up an address must not deadlock
+    PushSynchronizer::Subscriber subscriber;
+    subscriber.uid = "alice";
+    subscriber.ownsAddress = [this] (const std::string& address) {
+        return synchronizer->isConnected(endpoint) && address == "1Alice";
+    };
+    subscriber.synchronize = [this] () {
+        syncs["alice"] += 1;
+        return Future<Unit>::successful(unit);
+    };
+    synchronizer->subscribe(endpoint, subscriber);
+
+    engine->push(transaction("1Alice", "1Someone"));
+    context->advance(100);
+    EXPECT_EQ(syncs, (std::map<std::string, int>{{"alice", 1}}));
+}
@@ -0,0 +1,238 @@
+/*
+ *
+ * file_preferences_backend_test
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+
+#include <gtest/gtest.h>
+#include <ledger/core/preferences/FilePreferencesBackend.hpp>
+#include <ledger/core/preferences/Preferences.hpp>
+#include <ledger/core/api/ExecutionContext.hpp>
+#include <ledger/core/api/Runnable.hpp>
+#include <OpenSSLRandomNumberGenerator.hpp>
+#include <TempDir.hpp>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/resource.h>
+#endif
+
+using namespace ledger::core;
+
+namespace {
+    // Keeps the delayed runnables until the test decides to run them
+    class ManualExecutionContext : public api::ExecutionContext {
+    public:
+        void execute(const std::shared_ptr<api::Runnable>& runnable) override {
+            runnables.push_back(runnable);
+        }
+
+        void delay(const std::shared_ptr<api::Runnable>& runnable, int64_t millis) override {
+            runnables.push_back(runnable);
+        }
+
+        void runAll() {
+            auto toRun = std::move(runnables);
+            runnables.clear();
+            for (auto& runnable : toRun) {
+                runnable->run();
+            }
+        }
+
+        std::vector<std::shared_ptr<api::Runnable>> runnables;
+    };
+}
+
+class FilePreferencesBackendTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = test::GetTempDirPath() + "_preferences";
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+        std::remove((path + ".tmp").c_str());
+    }
+
+    std::shared_ptr<FilePreferencesBackend> open(const std::shared_ptr<api::ExecutionContext>& context = nullptr) {
+        return FilePreferencesBackend::open(path, context, std::chrono::milliseconds(100));
+    }
+
+    size_t fileSize() {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        return static_cast<size_t>(file.tellg());
+    }
+
+    std::string path;
+};
+
+TEST_F(FilePreferencesBackendTest, PersistAndReload) {
+    {
+        auto backend = open();
+        Preferences preferences(*backend, "pool");
+        preferences.editor()
+            ->putString("string", "Hello World!")
+            ->putInt("int", 42)
+            ->putString("removed", "Remove me")
+            ->commit();
+        preferences.editor()->remove("removed")->commit();
+        EXPECT_EQ(backend->getPendingSize(), 0);
+    }
+    auto backend = open();
+    Preferences preferences(*backend, "pool");
+    EXPECT_EQ(preferences.getString("string", ""), "Hello World!");
+    EXPECT_EQ(preferences.getInt("int", 0), 42);
+    EXPECT_FALSE(preferences.contains("removed"));
+}
+
+TEST_F(FilePreferencesBackendTest, GroupCommitWithinWindow) {
+    auto context = std::make_shared<ManualExecutionContext>();
+    auto backend = open(context);
+    Preferences preferences(*backend, "pool");
+    const auto emptyLogSize = backend->getLogSize();
+
+    for (auto i = 0; i < 100; i++) {
+        preferences.editor()->putInt("int_" + std::to_string(i), i)->commit();
+    }
+    // Visible right away, but written by a single delayed flush
+    EXPECT_EQ(preferences.getInt("int_99", -1), 99);
+    EXPECT_EQ(context->runnables.size(), 1);
+    EXPECT_EQ(backend->getLogSize(), emptyLogSize);
+    EXPECT_GT(backend->getPendingSize(), 0);
+
+    context->runAll();
+    EXPECT_EQ(backend->getPendingSize(), 0);
+    EXPECT_EQ(fileSize(), backend->getLogSize());
+
+    backend.reset();
+    auto reloaded = open();
+    Preferences reloadedPreferences(*reloaded, "pool");
+    for (auto i = 0; i < 100; i++) {
+        EXPECT_EQ(reloadedPreferences.getInt("int_" + std::to_string(i), -1), i);
+    }
+}
+
+TEST_F(FilePreferencesBackendTest, DropTornTail) {
+    {
+        auto backend = open();
+        Preferences(*backend, "pool").editor()->putString("string", "kept")->commit();
+    }
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::app);
+        file.write("\x20\x00\x00\x00garbage", 11);
+    }
+    {
+        auto backend = open();
+        Preferences preferences(*backend, "pool");
+        EXPECT_EQ(preferences.getString("string", ""), "kept");
+        preferences.editor()->putString("other", "written after recovery")->commit();
+    }
+    auto backend = open();
+    Preferences preferences(*backend, "pool");
+    EXPECT_EQ(preferences.getString("string", ""), "kept");
+    EXPECT_EQ(preferences.getString("other", ""), "written after recovery");
+}
+
+#if !defined(_WIN32) && !defined(_WIN64)
+TEST_F(FilePreferencesBackendTest, RewriteAfterShortWrite) {
+    auto backend = open();
+    Preferences preferences(*backend, "pool");
+    preferences.editor()->putString("before", "written")->commit();
+    const auto logSize = backend->getLogSize();
+
+    // Limit the file size so that the next frame is only partly written
+    struct rlimit previousLimit;
+    ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &previousLimit), 0);
+    auto previousHandler = std::signal(SIGXFSZ, SIG_IGN);
+    auto limit = previousLimit;
+    limit.rlim_cur = logSize + 16;
+    ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+    preferences.editor()->putString("torn", std::string(256, 'x'))->commit();
+    setrlimit(RLIMIT_FSIZE, &previousLimit);
+    std::signal(SIGXFSZ, previousHandler);
+
+    EXPECT_GT(backend->getPendingSize(), 0);
+    EXPECT_EQ(fileSize(), logSize + 16);
+    preferences.editor()->putString("after", "written too")->commit();
+    EXPECT_EQ(backend->getPendingSize(), 0);
+    EXPECT_EQ(fileSize(), backend->getLogSize());
+
+    backend.reset();
+    auto reloaded = open();
+    Preferences reloadedPreferences(*reloaded, "pool");
+    EXPECT_EQ(reloadedPreferences.getString("before", ""), "written");
+    EXPECT_EQ(reloadedPreferences.getString("torn", ""), std::string(256, 'x'));
+    EXPECT_EQ(reloadedPreferences.getString("after", ""), "written too");
+}
+#endif
+
+TEST_F(FilePreferencesBackendTest, Compact) {
+    auto backend = open();
+    Preferences preferences(*backend, "pool");
+    for (auto i = 0; i < 1000; i++) {
+        preferences.editor()->putInt("int", i)->commit();
+    }
+    const auto logSize = backend->getLogSize();
+    backend->compact();
+    EXPECT_LT(backend->getLogSize(), logSize / 100);
+
+    backend.reset();
+    auto reloaded = open();
+    EXPECT_EQ(Preferences(*reloaded, "pool").getInt("int", -1), 999);
+}
+
+TEST_F(FilePreferencesBackendTest, EncryptDecrypt) {
+    auto rng = std::make_shared<OpenSSLRandomNumberGenerator>();
+    auto password = std::string("v3ry_secr3t_p4sSw0rD");
+    {
+        auto backend = open();
+        Preferences preferences(*backend, "pool");
+        preferences.editor()->putString("before", "plain")->commit();
+        backend->setEncryption(rng, password);
+        EXPECT_FALSE(backend->getEncryptionSalt().empty());
+        preferences.editor()->putString("after", "ciphered")->commit();
+        EXPECT_EQ(preferences.getString("before", ""), "plain");
+        EXPECT_EQ(preferences.getString("after", ""), "ciphered");
+
+        backend->unsetEncryption();
+        EXPECT_NE(preferences.getString("before", ""), "plain");
+        EXPECT_NE(preferences.getString("after", ""), "ciphered");
+    }
+
+    auto backend = open();
+    Preferences preferences(*backend, "pool");
+    backend->setEncryption(rng, password);
+    EXPECT_EQ(preferences.getString("before", ""), "plain");
+    EXPECT_EQ(preferences.getString("after", ""), "ciphered");
+
+    EXPECT_TRUE(backend->resetEncryption(rng, password, ""));
+    EXPECT_TRUE(backend->getEncryptionSalt().empty());
+    backend->unsetEncryption();
+    EXPECT_EQ(preferences.getString("before", ""), "plain");
+    EXPECT_EQ(preferences.getString("after", ""), "ciphered");
+}
@@ -0,0 +1,67 @@
+/*
+ *
+ * date_allocations_test
+ * ledger-core
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2026 Ledger
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <utils/DateUtils.hpp>
+#include <AllocationCounter.hpp>
+#include <chrono>
+#include <vector>
+
+using namespace ledger::core;
+
+namespace {
+    const int ROWS = 5000;
+
+    std::vector<std::string> makeDates() {
+        std::vector<std::string> dates;
+        dates.reserve(ROWS);
+        // One date every ~7 minutes from 2009-01-03
+        auto date = std::chrono::system_clock::time_point(std::chrono::seconds(1230940800));
+        for (auto i = 0; i < ROWS; i++) {
+            dates.push_back(DateUtils::toJSON(date));
+            date += std::chrono::seconds(421);
+        }
+        return dates;
+    }
+}
+
+TEST(DateAllocations, ParseWithoutAllocating) {
+    auto dates = makeDates();
+    std::vector<std::chrono::system_clock::time_point> parsed(ROWS);
+
+    AllocationCounter counter;
+    for (auto i = 0; i < ROWS; i++) {
+        parsed[i] = DateUtils::fromJSON(dates[i]);
+    }
+    EXPECT_EQ(counter.allocations(), 0);
+
+    for (auto i = 0; i < ROWS; i++) {
+        EXPECT_EQ(DateUtils::toJSON(parsed[i]), dates[i]);
+    }
+}
@@ -31,6 +31,7 @@
 
 #include "gtest/gtest.h"
 #include "utils/DateUtils.hpp"
+#include "utils/Exception.hpp"
 
 using namespace ledger::core;
 
@@ -54,4 +55,78 @@ TEST(DateParser, FormatDate) {
     auto date = "2019-Jan-07 22:41:40";
     auto tp = DateUtils::formatDateFromJSON(date);
     EXPECT_EQ(tp, "2019-01-7T22:41:40Z");
-}
\ No newline at end of file
+}
+
+namespace {
+    api::ErrorCode parseError(const std::string& date) {
+        try {
+            DateUtils::fromJSON(date);
+        } catch (const Exception& ex) {
+            return ex.getErrorCode();
+        }
+        return api::ErrorCode::UNKNOWN;
+    }
+}
+
+TEST(DateParser, RejectLocalDates) {
+    EXPECT_EQ(parseError("2017-03-27T09:10:22"), api::ErrorCode::INVALID_DATE_FORMAT);
+    EXPECT_EQ(parseError("2017-03-27T09:10:22.511"), api::ErrorCode::INVALID_DATE_FORMAT);
+    EXPECT_EQ(parseError("2017-03-27T09:10:22+02:00"), api::ErrorCode::INVALID_DATE_FORMAT);
+    EXPECT_EQ(parseError("2017-03-27T09:10:22-0500"), api::ErrorCode::INVALID_DATE_FORMAT);
+}
+
+TEST(DateParser, RejectMalformedDates) {
+    const std::string dates[] = {
+            "",
+            "Z",
+            "2017-03-27",
+            "2017-03-27T09:10Z",
+            "2017-03-27 09:10:22Z",
+            "2017/03/27T09:10:22Z",
+            "2017-03-27T09:10:22ZZ",
+            "2017-03-27T09:10:22Z ",
+            " 2017-03-27T09:10:22Z",
+            "abcd-03-27T09:10:22Z",
+            "2017-0x-27T09:10:22Z",
+            "-2017-03-27T09:10:22Z",
+            "1234567890-03-27T09:10:22Z",
+            "2019-Foo-07 22:41:40",
+            "2019-January-07 22:41:40",
+            "2019-Jan-07T22:41:40Z"
+    };
+    for (const auto& date : dates) {
+        EXPECT_EQ(parseError(date), api::ErrorCode::INVALID_DATE_FORMAT) << date;
+    }
+}
+
+TEST(DateParser, OverflowFieldsOnNextOnes) {
+    EXPECT_EQ(DateUtils::toJSON(DateUtils::fromJSON("2017-13-01T00:00:00Z")), "2018-01-01T00:00:00Z");
+    EXPECT_EQ(DateUtils::toJSON(DateUtils::fromJSON("2016-02-30T24:00:60Z")), "2016-03-02T00:01:00Z");
+}
+
+TEST(DateParser, YearsOutsideFourDigits) {
+    // Depending on its resolution the system clock may not reach these years, the parser must
+    // then reject them instead of wrapping around
+    using namespace std::chrono;
+    const auto maxSeconds = duration_cast<seconds>(system_clock::duration::max()).count();
+    const auto minSeconds = duration_cast<seconds>(system_clock::duration::min()).count();
+    const std::pair<std::string, int64_t> dates[] = {
+            {"10000-01-01T00:00:00Z", 253402300800},
+            {"99999-12-31T23:59:59Z", 3093527980799},
+            {"0000-01-01T00:00:00Z", -62167219200}
+    };
+    for (const auto& date : dates) {
+        if (date.second <= maxSeconds && date.second >= minSeconds) {
+            auto parsed = DateUtils::fromJSON(date.first);
+            EXPECT_EQ(duration_cast<seconds>(parsed.time_since_epoch()).count(), date.second) << date.first;
+            EXPECT_EQ(DateUtils::toJSON(parsed), date.first);
+        } else {
+            EXPECT_EQ(parseError(date.first), api::ErrorCode::INVALID_DATE_FORMAT) << date.first;
+        }
+    }
+}
+
+TEST(DateParser, YearsAroundTheClockLimits) {
+    EXPECT_EQ(DateUtils::toJSON(DateUtils::fromJSON("1900-01-01T00:00:00Z")), "1900-01-01T00:00:00Z");
+    EXPECT_EQ(DateUtils::toJSON(DateUtils::fromJSON("2200-12-31T23:59:59Z")), "2200-12-31T23:59:59Z");
+}